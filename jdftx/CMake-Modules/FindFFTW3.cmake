@@ -9,6 +9,17 @@ if(FFTW3_INCLUDE_DIR AND FFTW3_LIBRARY AND FFTW3_THREADS_LIBRARY)
 	set(FFTW3_FOUND TRUE)
 endif()
 
+if(FFTW3F_REQUIRED)
+	find_library(FFTW3F_LIBRARY NAMES fftw3f PATHS ${FFTW3_PATH} ${FFTW3_PATH}/lib ${FFTW3_PATH}/lib64 NO_DEFAULT_PATH)
+	find_library(FFTW3F_LIBRARY NAMES fftw3f)
+	find_library(FFTW3F_THREADS_LIBRARY NAMES fftw3f_threads PATHS ${FFTW3_PATH} ${FFTW3_PATH}/lib ${FFTW3_PATH}/lib64 NO_DEFAULT_PATH)
+	find_library(FFTW3F_THREADS_LIBRARY NAMES fftw3f_threads)
+	if(FFTW3_FIND_REQUIRED AND ((NOT FFTW3F_LIBRARY) OR (NOT FFTW3F_THREADS_LIBRARY)))
+		set(FFTW3_FOUND FALSE)
+		message(FATAL_ERROR "Could not find single-precision FFTW3 libraries needed by EnableSinglePrecisionFFT (Add -D FFTW3_PATH=<path> to the cmake commandline for a non-standard installation)")
+	endif()
+endif()
+
 if(FFTW3_MPI_REQUIRED)
 	find_path(FFTW3_MPI_INCLUDE_DIR fftw3-mpi.h ${FFTW3_PATH} ${FFTW3_PATH}/include NO_DEFAULT_PATH)
 	find_path(FFTW3_MPI_INCLUDE_DIR fftw3-mpi.h)
@@ -0,0 +1,292 @@
+/*-------------------------------------------------------------------
+Copyright 2026 Ravishankar Sundararaman
+
+This file is part of JDFTx.
+
+JDFTx is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+JDFTx is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------*/
+
+#include <electronic/Everything.h>
+#include <electronic/ColumnBundle.h>
+#include <core/Pulay.h>
+#include <core/Random.h>
+#include <commands/parser.h>
+#include <config.h>
+#include <unistd.h>
+#include <map>
+
+//Micro-benchmarks of the main computational kernels, with JSON output and comparison to a baseline
+
+inline void printUsageExit(const char* errP=0)
+{	if(errP) printf("\nError: invalid value for option -%s\n", errP);
+	printf("\nUsage: jdftx-bench [-i <input>] [-j <json>] [-b <baseline>] [-t <tol>] [-r <nRepeat>] [-c <nThreads>]\n\n");
+	printf("Time FFTs and the main electronic kernels (Idag_DiagV_I, diagouterI, operator^,\n");
+	printf("nonlocal projection, exchange-correlation, symmetrization and Pulay mixing)\n");
+	printf("for a range of thread counts, and optionally compare to a baseline.\n");
+	printf("  -i <input>:    jdftx input file for the electronic kernels (default: built-in 8-atom Si cell)\n");
+	printf("  -j <json>:     file to write timings to in JSON format (default: jdftx-bench.json)\n");
+	printf("  -b <baseline>: JSON output of a previous run to compare against\n");
+	printf("  -t <tol>:      relative slowdown reported as a regression (default: 0.1)\n");
+	printf("  -r <nRepeat>:  number of timed repetitions of each kernel (default: 5)\n");
+	printf("  -c <nThreads>: maximum number of threads (default: all available)\n\n");
+	exit(errP ? 1 : 0);
+}
+
+inline void sync()
+{
+	#ifdef GPU_ENABLED
+	cudaDeviceSynchronize();
+	#endif
+}
+
+//Timing statistics of one kernel at one thread count
+struct BenchResult
+{	string name;
+	int nThreads;
+	double tMin, tMean, tMax; //in seconds
+};
+
+class Benchmark
+{
+public:
+	Benchmark(int nRepeat) : nRepeat(nRepeat) {}
+
+	//! Time func() nRepeat times (after one untimed warm-up call) using nThreads
+	template<typename Func> void run(string name, int nThreads, const Func& func)
+	{	int nProcsOrig = nProcsAvailable;
+		nProcsAvailable = nThreads; //threadLaunch and the FFT plans pick up thread count from here
+		func(); sync(); //warm-up: plans, caches and first-touch allocations
+		BenchResult r; r.name = name; r.nThreads = nThreads;
+		r.tMin = DBL_MAX; r.tMean = 0.; r.tMax = 0.;
+		for(int iRepeat=0; iRepeat<nRepeat; iRepeat++)
+		{	double tStart = clock_us();
+			func(); sync();
+			double t = 1e-6*(clock_us() - tStart);
+			r.tMin = std::min(r.tMin, t);
+			r.tMax = std::max(r.tMax, t);
+			r.tMean += t/nRepeat;
+		}
+		nProcsAvailable = nProcsOrig;
+		logPrintf("\t%-32s %3d threads:  min %10.3le  mean %10.3le  max %10.3le s\n", name.c_str(), nThreads, r.tMin, r.tMean, r.tMax);
+		logFlush();
+		results.push_back(r);
+	}
+
+	//! Write results in JSON format (one result per line, which is also what compare() expects)
+	void writeJSON(const char* filename) const
+	{	if(!mpiWorld->isHead()) return;
+		FILE* fp = fopen(filename, "w");
+		if(!fp) die("Could not open '%s' for writing.\n", filename);
+		time_t now = time(0);
+		string date(ctime(&now)); date.erase(date.find_last_not_of("\n")+1);
+		fprintf(fp, "{\n");
+		fprintf(fp, "\t\"version\": \"%s\",\n", VERSION_MAJOR_MINOR_PATCH);
+		fprintf(fp, "\t\"hash\": \"%s\",\n", VERSION_HASH);
+		fprintf(fp, "\t\"date\": \"%s\",\n", date.c_str());
+		fprintf(fp, "\t\"nProcesses\": %d,\n", mpiWorld->nProcesses());
+		fprintf(fp, "\t\"gpu\": %s,\n", isGpuEnabled() ? "true" : "false");
+		fprintf(fp, "\t\"nRepeat\": %d,\n", nRepeat);
+		fprintf(fp, "\t\"results\": [\n");
+		for(size_t i=0; i<results.size(); i++)
+		{	const BenchResult& r = results[i];
+			fprintf(fp, "\t\t{\"name\": \"%s\", \"nThreads\": %d, \"tMin\": %.6le, \"tMean\": %.6le, \"tMax\": %.6le}%s\n",
+				r.name.c_str(), r.nThreads, r.tMin, r.tMean, r.tMax, (i+1<results.size() ? "," : ""));
+		}
+		fprintf(fp, "\t]\n}\n");
+		fclose(fp);
+		logPrintf("Wrote timings to '%s'.\n", filename);
+	}
+
+	//! Compare minimum times against a baseline written by writeJSON, and return number of regressions
+	int compare(const char* filename, double tol) const
+	{	//Read baseline:
+		std::map<std::pair<string,int>,double> tBaseline;
+		FILE* fp = fopen(filename, "r");
+		if(!fp) die("Could not open baseline '%s' for reading.\n", filename);
+		char buf[1024];
+		while(fgets(buf, sizeof(buf), fp))
+		{	char name[256]; int nThreads; double tMin;
+			if(sscanf(buf, " {\"name\": \"%255[^\"]\", \"nThreads\": %d, \"tMin\": %le", name, &nThreads, &tMin) == 3)
+				tBaseline[std::make_pair(string(name),nThreads)] = tMin;
+		}
+		fclose(fp);
+		if(!tBaseline.size()) die("No timings found in baseline '%s'.\n", filename);
+		//Compare:
+		logPrintf("\nComparison to baseline '%s' (minimum times, tolerance %.0lf%%):\n", filename, tol*100);
+		int nRegressions = 0, nCompared = 0;
+		for(const BenchResult& r: results)
+		{	auto iter = tBaseline.find(std::make_pair(r.name,r.nThreads));
+			if(iter == tBaseline.end()) continue;
+			double ratio = r.tMin / iter->second;
+			bool regressed = (ratio > 1.+tol);
+			logPrintf("\t%-32s %3d threads:  baseline %10.3le  current %10.3le  ratio %6.3lf%s\n",
+				r.name.c_str(), r.nThreads, iter->second, r.tMin, ratio, regressed ? "  REGRESSION" : "");
+			if(regressed) nRegressions++;
+			nCompared++;
+		}
+		logPrintf("%d of %d benchmarks regressed by more than %.0lf%%.\n", nRegressions, nCompared, tol*100);
+		return nRegressions;
+	}
+
+private:
+	int nRepeat;
+	std::vector<BenchResult> results;
+};
+
+//Model linear problem for timing Pulay mixing on grid-sized variables
+class BenchPulay : public Pulay<ScalarFieldTilde>
+{	ScalarFieldTilde x, b;
+	double mixFraction;
+public:
+	BenchPulay(const PulayParams& pp, const ScalarFieldTilde& b) : Pulay<ScalarFieldTilde>(pp), x(b*0.), b(b), mixFraction(pp.mixFraction) {}
+protected:
+	double cycle(double dEprev, std::vector<double>& extraValues)
+	{	ScalarFieldTilde Ax = x - 0.5*L(x); //A = 1 + G^2/2 is positive definite
+		double E = 0.5*dot(x,Ax) - dot(b,x);
+		x -= 0.1*(Ax - b); //steepest descent step, accelerated by the mixing
+		return E;
+	}
+	void axpy(double alpha, const ScalarFieldTilde& X, ScalarFieldTilde& Y) const { ::axpy(alpha, X, Y); }
+	double dot(const ScalarFieldTilde& X, const ScalarFieldTilde& Y) const { return ::dot(X, Y); }
+	size_t variableSize() const { return x->nElem * sizeof(complex); }
+	void readVariable(ScalarFieldTilde& X, FILE* fp) const { fread(X->data(), sizeof(complex), X->nElem, fp); }
+	void writeVariable(const ScalarFieldTilde& X, FILE* fp) const { fwrite(X->data(), sizeof(complex), X->nElem, fp); }
+	ScalarFieldTilde getVariable() const { return clone(x); }
+	void setVariable(const ScalarFieldTilde& X) { x = clone(X); }
+	ScalarFieldTilde precondition(const ScalarFieldTilde& X) const { return mixFraction * X; }
+	ScalarFieldTilde applyMetric(const ScalarFieldTilde& X) const { return clone(X); }
+};
+
+int main(int argc, char** argv)
+{	//Parse command line:
+	string inputFilename, jsonFilename("jdftx-bench.json"), baselineFilename;
+	double tol = 0.1; int nRepeat = 5, nThreadsMax = 0;
+	int c;
+	while((c = getopt(argc, argv, "hi:j:b:t:r:c:")) != -1)
+	{	switch(c)
+		{	case 'i': inputFilename.assign(optarg); break;
+			case 'j': jsonFilename.assign(optarg); break;
+			case 'b': baselineFilename.assign(optarg); break;
+			case 't': if(sscanf(optarg, "%lf", &tol)!=1 || tol<0.) printUsageExit("t"); break;
+			case 'r': if(sscanf(optarg, "%d", &nRepeat)!=1 || nRepeat<1) printUsageExit("r"); break;
+			case 'c': if(sscanf(optarg, "%d", &nThreadsMax)!=1 || nThreadsMax<1) printUsageExit("c"); break;
+			default: printUsageExit();
+		}
+	}
+
+	//Initialize system and electronic state:
+	Everything e;
+	initSystem(argc, argv);
+	if(nThreadsMax) nProcsAvailable = std::min(nProcsAvailable, nThreadsMax);
+	std::vector<int> nThreadsList;
+	for(int nThreads=1; nThreads<nProcsAvailable; nThreads*=2) nThreadsList.push_back(nThreads);
+	nThreadsList.push_back(nProcsAvailable);
+	if(inputFilename.length())
+		parse(readInputFile(inputFilename), e);
+	else
+	{	typedef std::pair<string,string> stringPair;
+		std::vector<stringPair> input;
+		input.push_back(stringPair("lattice", "Cubic 10.26"));
+		input.push_back(stringPair("ion-species", "GBRV/$ID_pbe.uspp"));
+		input.push_back(stringPair("elec-cutoff", "20 100"));
+		input.push_back(stringPair("kpoint-folding", "2 2 2"));
+		input.push_back(stringPair("coords-type", "Lattice"));
+		const char* ionPos[8] = { "0 0 0", "0 0.5 0.5", "0.5 0 0.5", "0.5 0.5 0",
+			"0.25 0.25 0.25", "0.25 0.75 0.75", "0.75 0.25 0.75", "0.75 0.75 0.25" };
+		for(const char* pos: ionPos)
+			input.push_back(stringPair("ion", string("Si ") + pos + " 0"));
+		input.push_back(stringPair("wavefunction", "random"));
+		input.push_back(stringPair("dump", "End None"));
+		parse(input, e);
+	}
+	e.setup();
+	ElecVars& eVars = e.eVars;
+	eVars.n = eVars.calcDensity();
+	eVars.EdensityAndVscloc(e.ener);
+	e.cntrl.cacheProjectors = false; //time projector construction every call
+	logPrintf("Initialization completed successfully at t[s]: %9.2lf\n\n", clock_sec());
+
+	Benchmark bench(nRepeat);
+
+	//FFTs for a range of grid sizes (and the grid of the electronic system):
+	logPrintf("---------- FFTs ----------\n");
+	std::vector<int> fftSizes = { 32, 48, 64, 96, 128 };
+	for(int s: fftSizes)
+	{	GridInfo gInfo;
+		gInfo.R = Diag(vector3<>(s*0.2, s*0.2, s*0.2));
+		gInfo.S = vector3<int>(s, s, s);
+		logSuspend(); gInfo.initialize(true); logResume();
+		ScalarField r(ScalarFieldData::alloc(gInfo, isGpuEnabled())); initRandom(r);
+		ScalarFieldTilde rTilde = J(r);
+		complexScalarFieldTilde cTilde = Complex(rTilde);
+		string sizeStr(std::to_string(s).c_str());
+		for(int nThreads: nThreadsList)
+		{	bench.run("fft-r2c-" + sizeStr, nThreads, [&]() { J(r, nThreads); });
+			bench.run("fft-c2r-" + sizeStr, nThreads, [&]() { I(rTilde, nThreads); });
+			bench.run("fft-c2c-" + sizeStr, nThreads, [&]() { I(cTilde, nThreads); });
+		}
+	}
+
+	//Electronic kernels on the first local state:
+	logPrintf("\n---------- Electronic kernels ----------\n");
+	if(e.eInfo.qStart < e.eInfo.qStop)
+	{	int q = e.eInfo.qStart;
+		const ColumnBundle& C = eVars.C[q];
+		const diagMatrix& F = eVars.F[q];
+		matrix U = C^C;
+		ScalarFieldArray Vxc(eVars.n.size()), tau, Vtau;
+		if(e.exCorr.needsKEdensity())
+		{	tau = eVars.KEdensity();
+			Vtau.resize(tau.size());
+		}
+		for(int nThreads: nThreadsList)
+		{	bench.run("Idag_DiagV_I", nThreads, [&]() { Idag_DiagV_I(C, eVars.Vscloc); });
+			#ifdef SINGLE_PRECISION_FFT
+			bench.run("Idag_DiagV_I-fp32", nThreads, [&]() { Idag_DiagV_I(C, eVars.Vscloc, 0, true); });
+			#endif
+			bench.run("diagouterI", nThreads, [&]() { diagouterI(F, C, eVars.n.size(), &e.gInfo); });
+			bench.run("operator^", nThreads, [&]() { matrix CC = C^C; });
+			bench.run("ColumnBundle*matrix", nThreads, [&]() { ColumnBundle CU = C * U; });
+			bench.run("getV+projection", nThreads, [&]()
+			{	for(const auto& sp: e.iInfo.species)
+				{	std::shared_ptr<ColumnBundle> V = sp->getV(C);
+					if(V) { matrix VdagC = (*V)^C; }
+				}
+			});
+			bench.run("ExCorr", nThreads, [&]()
+			{	e.exCorr(eVars.n, &Vxc, IncludeTXC(), tau.size() ? &tau : 0, Vtau.size() ? &Vtau : 0);
+			});
+			bench.run("symmetrize", nThreads, [&]() { ScalarFieldArray n = clone(eVars.n); e.symm.symmetrize(n); });
+		}
+	}
+
+	//Pulay mixing of a model problem on the electronic grid:
+	{	ScalarField r(ScalarFieldData::alloc(e.gInfo, isGpuEnabled())); initRandom(r);
+		ScalarFieldTilde b = J(r);
+		PulayParams pp;
+		pp.fpLog = nullLog;
+		pp.nIterations = 20;
+		pp.energyDiffThreshold = 0.;
+		pp.residualThreshold = 0.;
+		for(int nThreads: nThreadsList)
+			bench.run("Pulay", nThreads, [&]() { BenchPulay pulay(pp, b); pulay.minimize(); });
+	}
+
+	//Output and comparison:
+	logPrintf("\n");
+	bench.writeJSON(jsonFilename.c_str());
+	int nRegressions = baselineFilename.length() ? bench.compare(baselineFilename.c_str(), tol) : 0;
+	finalizeSystem(nRegressions==0);
+	return nRegressions ? 1 : 0;
+}
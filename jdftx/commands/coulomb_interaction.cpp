@@ -181,6 +181,32 @@ struct CommandCoulombTruncationIonMargin : public Command
 commandCoulombTruncationIonMargin;
 
 
+struct CommandEwaldSPME : public Command
+{
+	CommandEwaldSPME() : Command("ewald-spme", "jdftx/Coulomb interactions")
+	{
+		format = "<nAtomsMin>";
+		comments =
+			"Minimum number of atoms at which the ion-ion Ewald sum in fully periodic geometry\n"
+			"switches from direct summation to smooth particle-mesh Ewald (SPME) with cell lists.\n"
+			"SPME scales as O(N log N) instead of O(N^2), with relative errors ~1e-9 in the energy.\n"
+			"SPME is opt-in: it is disabled by default (nAtomsMin = 0), which always uses the direct sum.\n"
+			"A value around 1000 is suitable for large cells where the direct sum dominates.";
+		hasDefault = false;
+	}
+
+	void process(ParamList& pl, Everything& e)
+	{	pl.get(e.coulombParams.nAtomsSPME, 0, "nAtomsMin", true);
+		if(e.coulombParams.nAtomsSPME < 0) throw string("<nAtomsMin> must be non-negative.");
+	}
+
+	void printStatus(Everything& e, int iRep)
+	{	logPrintf("%d", e.coulombParams.nAtomsSPME);
+	}
+}
+commandEwaldSPME;
+
+
 struct CommandExchangeRegularization : public Command
 {
 	CommandExchangeRegularization() : Command("exchange-regularization", "jdftx/Coulomb interactions")
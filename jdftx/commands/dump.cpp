@@ -26,6 +26,7 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #include <electronic/Dump_internal.h>
 #include <electronic/DumpBGW_internal.h>
 #include <core/Units.h>
+#include <core/ScalarFieldIO.h>
 
 struct CommandDumpOnly : public Command
 {
@@ -127,6 +128,7 @@ EnumStringMap<DumpVariable> varMap
 	DumpMomenta, "Momenta",
 	DumpVelocities, "Velocities",
 	DumpFermiVelocity, "FermiVelocity",
+	DumpTransitionHistogram, "TransitionHistogram",
 	DumpR, "R",
 	DumpL, "L",
 	DumpQ, "Q",
@@ -190,6 +192,7 @@ EnumStringMap<DumpVariable> varDescMap
 	DumpMomenta,        "Momentum matrix elements in a binary file (indices outer to inner: state, cartesian direction, band1, band2)",
 	DumpVelocities,     "Diagonal momentum/velocity matrix elements in a binary file  (indices outer to inner: state, band, cartesian direction)",
 	DumpFermiVelocity,  "Fermi velocity, density of states at Fermi level and related quantities",
+	DumpTransitionHistogram, "Joint density of states and oscillator strengths of vertical transitions, binned by energy on the fly (see command transition-histogram-params)",
 	DumpR,              "Position operator matrix elements, only allowed at End (see command Cprime-params)",
 	DumpL,              "Angular momentum matrix elements, only allowed at End (see command Cprime-params)",
 	DumpQ,              "Quadrupole r*p matrix elements, only allowed at End (see command Cprime-params)",
@@ -341,6 +344,99 @@ struct CommandDumpName : public Command
 commandDumpName;
 
 
+EnumStringMap<FieldCodec> fieldCodecMap
+(	FieldCodecRaw, "Raw",
+	FieldCodecLossless, "Lossless",
+	FieldCodecLossy, "Lossy"
+);
+
+struct CommandDumpFieldFormat : public Command
+{
+	CommandDumpFieldFormat() : Command("dump-field-format", "jdftx/Output")
+	{
+		format = "<codec>=Legacy|" + fieldCodecMap.optionList() + " [<errorBound>=1e-6] [<chunkPlanes>=4]";
+		comments =
+			"Select the file format of scalar field outputs (densities, potentials, fluid densities etc.):\n"
+			"+ Legacy: raw binary with no header (default).\n"
+			"+ Raw: self-describing format with a text header (grid, lattice vectors, variable name,\n"
+			"   spin channel, units and encoding), followed by chunks of uncompressed data.\n"
+			"+ Lossless: self-describing format with byte-shuffled, deflate-compressed chunks (requires zlib).\n"
+			"+ Lossy: self-describing format with values quantized to within an absolute error <errorBound>\n"
+			"   (in the atomic units of the quantity), delta-coded and packed in variable-length integers.\n"
+			"\n"
+			"Each chunk contains <chunkPlanes> planes along the first lattice direction; chunks are\n"
+			"compressed and written in parallel over all processes. Everything that reads density\n"
+			"or potential files accepts both formats (detected automatically), and the fieldToBinary\n"
+			"script converts self-describing files to legacy raw binary.";
+		hasDefault = true;
+	}
+
+	void process(ParamList& pl, Everything& e)
+	{	string codecName; pl.get(codecName, string("Legacy"), "codec");
+		if(codecName == "Legacy")
+		{	e.dump.fieldFormat = 0;
+			return;
+		}
+		e.dump.fieldFormat = std::make_shared<FieldFormat>();
+		FieldFormat& ff = *e.dump.fieldFormat;
+		if(!fieldCodecMap.getEnum(codecName.c_str(), ff.codec))
+			throw "<codec> must be one of Legacy|" + fieldCodecMap.optionList();
+		#ifndef ZLIB_ENABLED
+		if(ff.codec == FieldCodecLossless)
+			throw string("<codec> = Lossless requires zlib (reconfigure with -D EnableZlib=yes)");
+		#endif
+		pl.get(ff.errorBound, 1e-6, "errorBound");
+		pl.get(ff.chunkPlanes, 4, "chunkPlanes");
+		if(ff.errorBound <= 0.) throw string("<errorBound> must be positive");
+		if(ff.chunkPlanes <= 0) throw string("<chunkPlanes> must be positive");
+	}
+
+	void printStatus(Everything& e, int iRep)
+	{	if(!e.dump.fieldFormat) logPrintf("Legacy");
+		else
+		{	const FieldFormat& ff = *e.dump.fieldFormat;
+			logPrintf("%s %lg %d", fieldCodecMap.getString(ff.codec), ff.errorBound, ff.chunkPlanes);
+		}
+	}
+}
+commandDumpFieldFormat;
+
+
+struct CommandTelemetry : public Command
+{
+	CommandTelemetry() : Command("telemetry", "jdftx/Output")
+	{
+		format = "<target>";
+		comments =
+			"Stream machine-readable progress and performance records to <target>, one JSON\n"
+			"object per line, for every iteration of the electronic (minimize or SCF), ionic\n"
+			"(minimize or dynamics), lattice and fluid loops. Each iteration record contains:\n"
+			"+ stage, iter, t (elapsed seconds), dt (seconds since previous record), energy, residual.\n"
+			"+ fft and mpi: number of FFTs and blocking MPI calls (summed over processes) and the\n"
+			"   time spent in them (maximum over processes, summed over threads).\n"
+			"+ busy: time outside MPI calls since the previous record (min, avg and max over processes),\n"
+			"   and their imbalance = max / avg, which exceeds 1 with uneven load between processes.\n"
+			"+ memoryMB: resident memory (max and total over processes) and peak resident memory.\n"
+			"\n"
+			"The stream starts with a record with event = start (input, host, processes and threads),\n"
+			"and ends with a record with event = end and status = done or failed.\n"
+			"If <target> is an existing named pipe (see mkfifo), readers may connect and reconnect at any\n"
+			"time, and records are dropped instead of stalling the calculation while no reader is connected.\n"
+			"Otherwise, <target> is overwritten as a regular file. Records are written by the head process;\n"
+			"for nudged elastic band calculations, only records of the first image group are written.";
+	}
+	
+	void process(ParamList& pl, Everything& e)
+	{	pl.get(e.dump.telemetryTarget, string(), "target", true);
+	}
+	
+	void printStatus(Everything& e, int iRep)
+	{	logPrintf("%s", e.dump.telemetryTarget.c_str());
+	}
+}
+commandTelemetry;
+
+
 EnumStringMap<Polarizability::EigenBasis> polarizabilityMap
 (	Polarizability::NonInteracting, "NonInteracting",
 	Polarizability::External, "External",
@@ -967,6 +1063,8 @@ enum BGWparamsMember
 	BGWpm_saveVxx,
 	BGWpm_rpaExx,
 	BGWpm_offDiagV,
+	BGWpm_chunkBands,
+	BGWpm_compressLevel,
 	BGWpm_EcutChiFluid,
 	BGWpm_elecOnly,
 	BGWpm_q0,
@@ -989,6 +1087,8 @@ EnumStringMap<BGWparamsMember> bgwpmMap
 	BGWpm_saveVxx, "saveVxx",
 	BGWpm_rpaExx, "rpaExx",
 	BGWpm_offDiagV, "offDiagV",
+	BGWpm_chunkBands, "chunkBands",
+	BGWpm_compressLevel, "compressLevel",
 	BGWpm_EcutChiFluid, "EcutChiFluid",
 	BGWpm_elecOnly, "elecOnly",
 	BGWpm_q0, "q0",
@@ -1010,6 +1110,8 @@ EnumStringMap<BGWparamsMember> bgwpmDescMap
 	BGWpm_saveVxx, "Whether to write exact-exchange matrix elements (default: no)",
 	BGWpm_rpaExx, "Whether to compute RPA-consistent exact-exchange energy (default: no)",
 	BGWpm_offDiagV, "Whether to write off-diagonal matrix elements of Vxc and/or Vxx (default: no)",
+	BGWpm_chunkBands, "Number of bands per HDF5 chunk of wavefunction coefficients (default: 32)",
+	BGWpm_compressLevel, "Deflate compression level 0-9 for wavefunction coefficients (default: 0 = uncompressed; requires parallel HDF5 >= 1.10.2 for non-zero)",
 	BGWpm_EcutChiFluid, "KE cutoff in hartrees for fluid polarizability output (default: 0; set non-zero to enable)",
 	BGWpm_elecOnly, "Whether fluid polarizability output should only include electronic response (default: true)",
 	BGWpm_q0, "Zero wavevector replacement to be used for polarizability output (default: (0,0,0))",
@@ -1057,6 +1159,11 @@ struct CommandBGWparams : public Command
 				READ_BOOL(saveVxx)
 				READ_BOOL(rpaExx)
 				READ_BOOL(offDiagV)
+				READ_AND_CHECK(chunkBands, >, 0)
+				case BGWpm_compressLevel:
+					pl.get(bgwp.compressLevel, 0, "compressLevel", true);
+					if(bgwp.compressLevel<0 or bgwp.compressLevel>9) throw string("compressLevel must be in [0,9]");
+					break;
 				READ_AND_CHECK(EcutChiFluid, >=, 0.)
 				READ_BOOL(elecOnly)
 				case BGWpm_q0:
@@ -1091,6 +1198,8 @@ struct CommandBGWparams : public Command
 		PRINT_BOOL(saveVxx)
 		PRINT_BOOL(rpaExx)
 		PRINT_BOOL(offDiagV)
+		PRINT(chunkBands, "%d")
+		PRINT(compressLevel, "%d")
 		PRINT(EcutChiFluid, "%lg")
 		PRINT_BOOL(elecOnly)
 		logPrintf(" \\\n\tq0 %lg %lg %lg", bgwp.q0[0], bgwp.q0[1], bgwp.q0[2]);
@@ -1133,6 +1242,29 @@ struct CommandBandProjectionParams : public Command
 commandBandProjectionParams;
 
 
+struct CommandTransitionHistogramParams : public Command
+{
+	CommandTransitionHistogramParams() : Command("transition-histogram-params", "jdftx/Output")
+	{	
+		format = "<dE>";
+		comments = "Energy bin width <dE> (in Eh, default 0.001) for the joint density of states and\n"
+			"oscillator strength histogram of vertical transitions (dump variable TransitionHistogram).\n"
+			"The histogram is accumulated one k-point at a time from the momentum matrix elements,\n"
+			"which therefore need not be stored or written out in full.";
+	}
+
+	void process(ParamList& pl, Everything& e)
+	{	pl.get(e.dump.transitionHistogramBin, 0.001, "dE");
+		if(e.dump.transitionHistogramBin <= 0.) throw string("<dE> must be positive");
+	}
+
+	void printStatus(Everything& e, int iRep)
+	{	logPrintf("%lg", e.dump.transitionHistogramBin);
+	}
+}
+commandTransitionHistogramParams;
+
+
 struct CommandCprimeParams : public Command
 {
 	CommandCprimeParams() : Command("Cprime-params", "jdftx/Output")
@@ -126,12 +126,15 @@ struct CommandLcaoParams : public Command
 {
 	CommandLcaoParams() : Command("lcao-params", "jdftx/Initialization")
 	{
-		format = "[<nIter>=-1] [<Ediff>=1e-6] [<smeaingWidth>=1e-3]";
+		format = "[<nIter>=-1] [<Ediff>=1e-6] [<smeaingWidth>=1e-3] [<eigDiff>=0]";
 		comments = "Control LCAO wavefunction initialization:\n"
 			"+ <nIter>: maximum subspace iterations in LCAO (negative => auto-select)\n"
 			"+ <Ediff>: energy-difference convergence threshold for subspace iteration\n"
 			"+ <smearingWidth>: smearing width for the subspace iteration for constant fillings calculations.\n"
-			"   If present, the smearing width from elec-smearing overrides this.\n";
+			"   If present, the smearing width from elec-smearing overrides this.\n"
+			"+ <eigDiff>: if positive, also stop the subspace iteration once the subspace eigenvalues\n"
+			"   (of the occupied and requested empty bands) change by less than this between iterations.\n"
+			"   This is useful for short high-throughput jobs where only an approximate starting point is needed.";
 		hasDefault = true;
 	}
 
@@ -140,16 +143,41 @@ struct CommandLcaoParams : public Command
 		pl.get(e.eVars.lcaoTol, 1e-6, "Ediff");
 		pl.get(e.eInfo.smearingWidth, 1e-3, "smearingWidth");
 		if(e.eInfo.smearingWidth<=0) throw string("<smearingWidth> must be positive.\n");
+		pl.get(e.eVars.lcaoEigTol, 0., "eigDiff");
+		if(e.eVars.lcaoEigTol<0) throw string("<eigDiff> must be non-negative.\n");
 	}
 
 	void printStatus(Everything& e, int iRep)
-	{	logPrintf("%d %lg %lg", e.eVars.lcaoIter, e.eVars.lcaoTol, e.eInfo.smearingWidth);
+	{	logPrintf("%d %lg %lg %lg", e.eVars.lcaoIter, e.eVars.lcaoTol, e.eInfo.smearingWidth, e.eVars.lcaoEigTol);
 	}
 }
 commandLcaoParams;
 
 //-------------------------------------------------------------------------------------------------
 
+struct CommandLcaoOrbitalCache : public Command
+{
+	CommandLcaoOrbitalCache() : Command("lcao-orbital-cache", "jdftx/Initialization")
+	{
+		format = "<directory>";
+		comments = "Cache the reciprocal-space atomic orbitals (used for LCAO and projections)\n"
+			"in <directory>, and reuse them in subsequent calculations with the same\n"
+			"pseudopotentials, lattice and grid parameters. The directory must exist,\n"
+			"and may be shared by concurrent calculations, such as in a job array.";
+	}
+
+	void process(ParamList& pl, Everything& e)
+	{	pl.get(e.iInfo.orbitalCacheDir, string(), "directory", true);
+	}
+
+	void printStatus(Everything& e, int iRep)
+	{	logPrintf("%s", e.iInfo.orbitalCacheDir.c_str());
+	}
+}
+commandLcaoOrbitalCache;
+
+//-------------------------------------------------------------------------------------------------
+
 EnumStringMap<SpinType> spinMap
 (	SpinNone,   "no-spin",
 	SpinZ,      "z-spin",
@@ -286,7 +314,9 @@ struct CommandCacheProjectors : public Command
 	{
 		format = "yes|no";
 		comments =
-			"Cache nonlocal-pseudopotential projectors (yes by default); turn off to save memory.";
+			"Cache nonlocal-pseudopotential projectors (yes by default); turn off to save memory.\n"
+			"Only the atom-independent radial and angular part is cached (per species and k-point),\n"
+			"and atomic structure factors are applied on the fly in blocks.";
 	}
 
 	void process(ParamList& pl, Everything& e)
@@ -301,6 +331,35 @@ commandCacheProjectors;
 
 //-------------------------------------------------------------------------------------------------
 
+struct CommandUnfoldCache : public Command
+{
+	CommandUnfoldCache() : Command("unfold-cache", "jdftx/Miscellaneous")
+	{
+		format = "<maxMB> [<spillPrefix>]";
+		comments =
+			"Cache wavefunctions unfolded from the reduced to the full k-point mesh under symmetries,\n"
+			"which are reused repeatedly in exact exchange and Wannier calculations.\n"
+			"At most <maxMB> megabytes per process are held in memory (512 by default);\n"
+			"least recently used entries beyond that are discarded and recomputed when needed.\n"
+			"If <spillPrefix> is specified, evicted entries are instead written to a private\n"
+			"temporary file with that path prefix (eg. on fast local disk) and memory-mapped back\n"
+			"on reuse. Hit and miss statistics of the cache are reported in the output.";
+	}
+
+	void process(ParamList& pl, Everything& e)
+	{	pl.get(e.cntrl.unfoldCacheMB, 512., "maxMB");
+		if(e.cntrl.unfoldCacheMB < 0.) throw string("<maxMB> must be >= 0");
+		pl.get(e.cntrl.unfoldCacheSpill, string(), "spillPrefix");
+	}
+
+	void printStatus(Everything& e, int iRep)
+	{	logPrintf("%lg %s", e.cntrl.unfoldCacheMB, e.cntrl.unfoldCacheSpill.c_str());
+	}
+}
+commandUnfoldCache;
+
+//-------------------------------------------------------------------------------------------------
+
 struct CommandBasis : public Command
 {
 	CommandBasis() : Command("basis", "jdftx/Electronic/Parameters")
@@ -143,6 +143,42 @@ struct CommandFluidSolveFrequency : public Command
 commandFluidSolveFrequency;
 
 
+struct CommandFluidExtrapolation : public Command
+{
+	CommandFluidExtrapolation() : Command("fluid-extrapolation", "jdftx/Fluid/Optimization")
+	{
+		format = "<nHistory>=3 [<baseline>=no]";
+		comments =
+			"Extrapolate the fluid state between ionic steps (geometry optimization, dynamics etc.)\n"
+			"using the converged fluid states of up to <nHistory> previous ionic steps,\n"
+			"combined with coefficients that best reproduce the current change in cavity.\n"
+			"The number of fluid iterations in each extrapolated ionic step is reported.\n"
+			"Set <nHistory> = 1 to use a plain warm start. Extrapolation is off unless this\n"
+			"command is specified (equivalent to <nHistory> = 0).\n"
+			"\n"
+			"If <baseline> = yes, the first fluid solve of each extrapolated ionic step is also\n"
+			"performed from the previous converged state (what a plain warm start would use),\n"
+			"and the fluid iterations saved by extrapolation are reported. This diagnostic\n"
+			"costs one additional fluid solve per ionic step.";
+		hasDefault = false;
+		require("fluid");
+	}
+
+	void process(ParamList& pl, Everything& e)
+	{	FluidSolverParams& fsp = e.eVars.fluidParams;
+		pl.get(fsp.nExtrapolationHistory, 3, "nHistory");
+		if(fsp.nExtrapolationHistory < 0) throw string("<nHistory> must be non-negative");
+		pl.get(fsp.extrapolationBaseline, false, boolMap, "baseline");
+	}
+
+	void printStatus(Everything& e, int iRep)
+	{	const FluidSolverParams& fsp = e.eVars.fluidParams;
+		logPrintf("%d %s", fsp.nExtrapolationHistory, boolMap.getString(fsp.extrapolationBaseline));
+	}
+}
+commandFluidExtrapolation;
+
+
 struct CommandFluidInitialState : public Command
 {
 	CommandFluidInitialState() : Command("fluid-initial-state", "jdftx/Initialization")
@@ -425,3 +425,29 @@ struct CommandAddU : public Command
 	}
 }
 commandAddU;
+
+
+struct CommandPseudopotentialCache : public Command
+{
+	CommandPseudopotentialCache() : Command("pseudopotential-cache", "jdftx/Ionic/Species")
+	{
+		format = "<directory>";
+		comments = "Cache the reciprocal-space radial functions of all pseudopotentials (local and nonlocal\n"
+			"potentials, augmentation functions, core densities and atomic orbitals) in <directory>,\n"
+			"and reuse them in subsequent calculations with the same pseudopotentials and grid parameters.\n"
+			"Cache files are keyed by a hash of the radial samples read from the pseudopotential file\n"
+			"together with the transform resolution and cutoff, so entries for different pseudopotentials\n"
+			"or Ecut / lattice parameters can coexist. The directory must exist, and may be shared\n"
+			"by concurrent calculations, such as in a high-throughput job array.\n"
+			"(lcao-orbital-cache, if specified, overrides this directory for the atomic orbitals.)";
+	}
+
+	void process(ParamList& pl, Everything& e)
+	{	pl.get(e.iInfo.pspCacheDir, string(), "directory", true);
+	}
+
+	void printStatus(Everything& e, int iRep)
+	{	logPrintf("%s", e.iInfo.pspCacheDir.c_str());
+	}
+}
+commandPseudopotentialCache;
@@ -22,6 +22,8 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #include <electronic/Everything.h>
 #include <electronic/IonicDynamicsParams.h>
 #include <electronic/IonicGaussianPotential.h>
+#include <electronic/CalculatorServer.h>
+#include <electronic/NEB.h>
 #include <core/Units.h>
 
 
@@ -266,3 +268,133 @@ struct CommandIonicGaussianPotential : public Command
 	}
 }
 commandIonicGaussianPotential;
+
+
+struct CommandCalculatorServer : public Command
+{
+	CommandCalculatorServer() : Command("calculator-server", "jdftx/Ionic/Optimization")
+	{
+		format = "<socketPath> [<stress>=yes]";
+		comments =
+			"Run as a persistent calculator for an external driver such as ASE, instead of\n"
+			"performing ionic / lattice minimization or dynamics. The server listens on the\n"
+			"UNIX-domain socket <socketPath> for lattice vectors and ionic positions, updates\n"
+			"the system in place (reusing wavefunctions, pseudopotentials etc. between requests)\n"
+			"and replies with the energy, Cartesian forces and optionally the stress tensor\n"
+			"(computed unless <stress>=no). Requires symmetries none. The line-based protocol\n"
+			"is documented in CalculatorServer.h, and is used by scripts/ase/JDFTx.py.";
+		
+		forbid("vibrations");
+		forbid("ionic-dynamics");
+	}
+	
+	void process(ParamList& pl, Everything& e)
+	{	e.server = std::make_shared<CalculatorServer>();
+		pl.get(e.server->socketPath, string(), "socketPath", true);
+		bool stress; pl.get(stress, true, boolMap, "stress");
+		if(stress) e.iInfo.computeStress = true;
+	}
+	
+	void printStatus(Everything& e, int iRep)
+	{	logPrintf("%s %s", e.server->socketPath.c_str(), boolMap.getString(e.iInfo.computeStress));
+	}
+}
+commandCalculatorServer;
+
+
+enum NebMember
+{	NM_nImages,
+	NM_final,
+	NM_spring,
+	NM_climb,
+	NM_nIterations,
+	NM_fMax,
+	NM_dt,
+	NM_maxStep,
+	NM_Delim
+};
+
+EnumStringMap<NebMember> nebMap
+(	NM_nImages, "nImages",
+	NM_final, "final",
+	NM_spring, "spring",
+	NM_climb, "climb",
+	NM_nIterations, "nIterations",
+	NM_fMax, "fMax",
+	NM_dt, "dt",
+	NM_maxStep, "maxStep"
+);
+
+struct CommandNeb : public Command
+{
+	CommandNeb() : Command("neb", "jdftx/Ionic/Optimization")
+	{
+		format = "<key1> <args1> ...";
+		comments =
+			"Find the minimum energy path between the initial state, specified by the ion\n"
+			"commands in the input file, and a final state using the nudged elastic band method,\n"
+			"instead of performing ionic / lattice minimization or dynamics. Intermediate images\n"
+			"are initialized by linear interpolation (using minimum-image displacements), and are\n"
+			"calculated concurrently by dividing the processes into min(nImages, nProcesses) groups.\n"
+			"Output files of each image <i> are prefixed by image<i>. in the dump-name $VAR, and\n"
+			"the final path energies are written to the file named by $VAR = nebPath.\n"
+			"\n"
+			"Any number of the following subcommands and their arguments may follow:\n"
+			"+ final <filename>: file containing ion commands for the final state (required),\n"
+			"   with the same species and atom order as the input file.\n"
+			"+ nImages <n>: number of intermediate images (default: 5)\n"
+			"+ spring <k>: spring constant between images in Eh/bohr^2 (default: 0.1)\n"
+			"+ climb yes|no: climbing image for the highest-energy image, switched on once the\n"
+			"   maximum force is within a factor of 5 of fMax (default: yes)\n"
+			"+ nIterations <n>: maximum number of band iterations (default: 100)\n"
+			"+ fMax <fMax>: convergence threshold on the maximum atomic force perpendicular\n"
+			"   to the path (including springs) in Eh/bohr (default: 1e-3)\n"
+			"+ dt <dt>: time step of the quick-min optimizer in atomic units, with unit mass (default: 1)\n"
+			"+ maxStep <dr>: maximum atom displacement per iteration in bohrs (default: 0.2)\n"
+			"\n"
+			"Move scales and constraints of the ion commands in the input file are applied to all images.";
+		
+		forbid("vibrations");
+		forbid("ionic-dynamics");
+		forbid("calculator-server");
+		forbid("lattice-minimize");
+	}
+	
+	void process(ParamList& pl, Everything& e)
+	{	e.neb = std::make_shared<NEB>();
+		NEB& neb = *e.neb;
+		while(true)
+		{	NebMember key;
+			pl.get(key, NM_Delim, nebMap, "key");
+			switch(key)
+			{	case NM_nImages:
+					pl.get(neb.nImages, 5, "nImages", true);
+					if(neb.nImages < 1) throw string("nImages must be at least 1");
+					break;
+				case NM_final: pl.get(neb.finalFilename, string(), "final", true); break;
+				case NM_spring: pl.get(neb.kSpring, 0.1, "spring", true); break;
+				case NM_climb: pl.get(neb.climb, true, boolMap, "climb", true); break;
+				case NM_nIterations: pl.get(neb.nIterations, 100, "nIterations", true); break;
+				case NM_fMax: pl.get(neb.fMax, 1e-3, "fMax", true); break;
+				case NM_dt: pl.get(neb.dt, 1., "dt", true); break;
+				case NM_maxStep: pl.get(neb.maxStep, 0.2, "maxStep", true); break;
+				case NM_Delim:
+					if(!neb.finalFilename.length()) throw string("final state must be specified using key final");
+					return; //end of input
+			}
+		}
+	}
+	
+	void printStatus(Everything& e, int iRep)
+	{	const NEB& neb = *e.neb;
+		logPrintf(" \\\n\tfinal %s", neb.finalFilename.c_str());
+		logPrintf(" \\\n\tnImages %d", neb.nImages);
+		logPrintf(" \\\n\tspring %lg", neb.kSpring);
+		logPrintf(" \\\n\tclimb %s", boolMap.getString(neb.climb));
+		logPrintf(" \\\n\tnIterations %d", neb.nIterations);
+		logPrintf(" \\\n\tfMax %lg", neb.fMax);
+		logPrintf(" \\\n\tdt %lg", neb.dt);
+		logPrintf(" \\\n\tmaxStep %lg", neb.maxStep);
+	}
+}
+commandNeb;
@@ -24,7 +24,8 @@ EnumStringMap<MinimizeParams::DirectionUpdateScheme> dirUpdateMap
 	MinimizeParams::FletcherReeves, "FletcherReeves",
 	MinimizeParams::HestenesStiefel, "HestenesStiefel",
 	MinimizeParams::LBFGS, "L-BFGS",
-	MinimizeParams::SteepestDescent, "SteepestDescent"
+	MinimizeParams::SteepestDescent, "SteepestDescent",
+	MinimizeParams::FIRE, "FIRE"
 );
 
 EnumStringMap<MinimizeParams::LinminMethod> linminMap
@@ -237,3 +238,45 @@ struct CommandLatticeMinimize : public CommandMinimize
 	}
 }
 commandLatticeMinimize;
+
+EnumStringMap<IonicPreconditioner::Type> ionicPrecondTypeMap
+(	IonicPreconditioner::None, "None",
+	IonicPreconditioner::Exp, "Exp"
+);
+
+struct CommandIonicPreconditioner : public Command
+{
+	CommandIonicPreconditioner() : Command("ionic-preconditioner", "jdftx/Ionic/Optimization")
+	{
+		format = "<type>=" + ionicPrecondTypeMap.optionList() + " [<A>=3] [<mu>=0.01] [<cStab>=0.1]";
+		comments =
+			"Preconditioner for ionic minimization and the ionic part of lattice minimization:\n"
+			"+ None: scale gradients by the move scale factors of the ion commands alone (default).\n"
+			"+ Exp: invert a model Hessian built from atomic connectivity, with bond stiffness\n"
+			"   <mu> exp(-<A> (r/rNN - 1)) for pairs closer than twice the nearest-neighbour\n"
+			"   distance rNN, and <cStab> <mu> on the diagonal for stability. <mu> is in Eh/bohr^2.\n"
+			"   This makes soft collective motions of large systems converge in far fewer steps.\n"
+			"\n"
+			"Combine with ionic-minimize dirUpdateScheme FIRE, or with dirUpdateScheme L-BFGS\n"
+			"and linminMethod Relax, for optimization using one force evaluation per step\n"
+			"without energy line searches (steps remain limited to 0.1 bohr per atom).";
+		hasDefault = true;
+	}
+	
+	void process(ParamList& pl, Everything& e)
+	{	IonicPreconditioner& precond = e.iInfo.ionicPrecond;
+		pl.get(precond.type, IonicPreconditioner::None, ionicPrecondTypeMap, "type");
+		pl.get(precond.A, 3., "A");
+		pl.get(precond.mu, 0.01, "mu");
+		pl.get(precond.cStab, 0.1, "cStab");
+		if(precond.A < 0.) throw string("<A> must be non-negative");
+		if(precond.mu <= 0.) throw string("<mu> must be positive");
+		if(precond.cStab <= 0.) throw string("<cStab> must be positive");
+	}
+	
+	void printStatus(Everything& e, int iRep)
+	{	const IonicPreconditioner& precond = e.iInfo.ionicPrecond;
+		logPrintf("%s %lg %lg %lg", ionicPrecondTypeMap.getString(precond.type), precond.A, precond.mu, precond.cStab);
+	}
+}
+commandIonicPreconditioner;
@@ -106,7 +106,10 @@ enum SCFparamsMember
 	SCFpm_qKerker,
 	SCFpm_qKappa,
 	SCFpm_verbose,
-	SCFpm_mixFractionMag
+	SCFpm_mixFractionMag,
+	SCFpm_mixedPrecisionThreshold,
+	SCFpm_eigenSolver,
+	SCFpm_chfsiDegree
 };
 
 EnumStringMap<SCFparamsMember> scfParamsMap
@@ -116,7 +119,10 @@ EnumStringMap<SCFparamsMember> scfParamsMap
 	SCFpm_qKerker, "qKerker",
 	SCFpm_qKappa, "qKappa",
 	SCFpm_verbose, "verbose",
-	SCFpm_mixFractionMag, "mixFractionMag"
+	SCFpm_mixFractionMag, "mixFractionMag",
+	SCFpm_mixedPrecisionThreshold, "mixedPrecisionThreshold",
+	SCFpm_eigenSolver, "eigenSolver",
+	SCFpm_chfsiDegree, "chfsiDegree"
 );
 EnumStringMap<SCFparamsMember> scfParamsDescMap
 (	SCFpm_nEigSteps, "number of eigenvalue steps per iteration (if 0, limited by electronic-minimize nIterations)",
@@ -125,7 +131,12 @@ EnumStringMap<SCFparamsMember> scfParamsDescMap
 	SCFpm_qKerker, "wavevector controlling Kerker preconditioning (default: 0.8 bohr^-1)",
 	SCFpm_qKappa, "wavevector for long-range damping. If negative (default), set to zero or fluid Debye wavevector as appropriate",
 	SCFpm_verbose, "whether the inner eigenvalue solver will print or not",
-	SCFpm_mixFractionMag, "mix fraction for magnetization density / potential (default 1.5)"
+	SCFpm_mixFractionMag, "mix fraction for magnetization density / potential (default 1.5)",
+	SCFpm_mixedPrecisionThreshold, "use single-precision FFTs for the local potential until |Residual| drops below this (default 0: disabled; "
+		"requires a build with EnableSinglePrecisionFFT, and applies only to CPU calculations with collinear spin)",
+	SCFpm_eigenSolver, "inner eigensolver: Default (as selected by elec-eigen-algo) or ChFSI (Chebyshev-filtered subspace iteration "
+		"after the first cycle, with nEigSteps filter passes per cycle; 1 pass by default or if nEigSteps is 0, norm-conserving pseudopotentials only)",
+	SCFpm_chfsiDegree, "degree of the Chebyshev filter polynomial for eigenSolver ChFSI (default: 8)"
 );
 
 EnumStringMap<SCFparams::MixedVariable> scfMixing
@@ -133,6 +144,11 @@ EnumStringMap<SCFparams::MixedVariable> scfMixing
 	SCFparams::MV_Potential, "Potential"
 );
 
+EnumStringMap<SCFparams::EigenSolver> scfEigenSolverMap
+(	SCFparams::ES_Default, "Default",
+	SCFparams::ES_ChFSI, "ChFSI"
+);
+
 struct CommandElectronicScf: public CommandPulay
 {
 	CommandElectronicScf() : CommandPulay("electronic-scf", "jdftx/Electronic/Optimization")
@@ -152,8 +168,12 @@ struct CommandElectronicScf: public CommandPulay
 	void process(ParamList& pl, Everything& e)
 	{	e.cntrl.scf = true;
 		SCFparams& sp = e.scfParams;
-		sp.nEigSteps = (e.cntrl.elecEigenAlgo==ElecEigenCG) ? 40 : 2; //default eigenvalue steps based on algo
+		sp.nEigSteps = -1; //unset: default depends on eigensolver, determined below
 		processCommon(pl, e, sp);
+		if(sp.nEigSteps < 0)
+			sp.nEigSteps = (sp.eigenSolver==SCFparams::ES_ChFSI)
+				? 1 //one filter pass per cycle
+				: ((e.cntrl.elecEigenAlgo==ElecEigenCG) ? 40 : 2); //default eigenvalue steps based on algo
 	}
 	
 	void process_sub(string keyStr, ParamList& pl, Everything& e)
@@ -161,13 +181,31 @@ struct CommandElectronicScf: public CommandPulay
 		SCFparamsMember key;
 		if(scfParamsMap.getEnum(keyStr.c_str(), key))
 		{	switch(key)
-			{	case SCFpm_nEigSteps: pl.get(sp.nEigSteps, 0, "nEigSteps", true); break;
+			{	case SCFpm_nEigSteps:
+				{	pl.get(sp.nEigSteps, 0, "nEigSteps", true);
+					if(sp.nEigSteps < 0) throw string("<nEigSteps> must be non-negative");
+					break;
+				}
 				case SCFpm_eigDiffThreshold: pl.get(sp.eigDiffThreshold, 1e-8, "eigDiffThreshold", true); break;
 				case SCFpm_mixedVariable: pl.get(sp.mixedVariable, SCFparams::MV_Density, scfMixing, "mixedVariable", true); break;
 				case SCFpm_qKerker: pl.get(sp.qKerker, 0.8, "qKerker", true); break;
 				case SCFpm_qKappa: pl.get(sp.qKappa, -1., "qKappa", true); break;
 				case SCFpm_verbose: pl.get(sp.verbose, false, boolMap, "verbose", true); break;
 				case SCFpm_mixFractionMag: pl.get(sp.mixFractionMag, 1.5, "mixFractionMag", true); break;
+				case SCFpm_mixedPrecisionThreshold:
+				{	pl.get(sp.mixedPrecisionThreshold, 0., "mixedPrecisionThreshold", true);
+					#ifndef SINGLE_PRECISION_FFT
+					if(sp.mixedPrecisionThreshold > 0.)
+						throw string("mixedPrecisionThreshold requires JDFTx to be compiled with EnableSinglePrecisionFFT");
+					#endif
+					break;
+				}
+				case SCFpm_eigenSolver: pl.get(sp.eigenSolver, SCFparams::ES_Default, scfEigenSolverMap, "eigenSolver", true); break;
+				case SCFpm_chfsiDegree:
+				{	pl.get(sp.chfsiDegree, 8, "chfsiDegree", true);
+					if(sp.chfsiDegree < 1) throw string("<chfsiDegree> must be >= 1");
+					break;
+				}
 			}
 		}
 		else throw string("Parameter <key> must be one of " + pulayParamsMap.optionList() + "|" + scfParamsMap.optionList());
@@ -184,6 +222,9 @@ struct CommandElectronicScf: public CommandPulay
 		PRINT(qKappa, %lg)
 		logPrintf(" \\\n\tverbose\t%s", boolMap.getString(sp.verbose));
 		PRINT(mixFractionMag, %lg)
+		PRINT(mixedPrecisionThreshold, %lg)
+		logPrintf(" \\\n\teigenSolver\t%s", scfEigenSolverMap.getString(sp.eigenSolver));
+		PRINT(chfsiDegree, %i)
 		#undef PRINT
 	}
 }
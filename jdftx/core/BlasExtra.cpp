@@ -147,13 +147,14 @@ void eblas_symmetrize(int N, int n, const int* symmIndex, double* x) { eblas_sym
 void eblas_symmetrize(int N, int n, const int* symmIndex, complex* x) { eblas_symmetrize<complex>(N, n, symmIndex, x); }
 
 
-void eblas_symmetrize_phase_sub(size_t iStart, size_t iStop, int n, const int* symmIndex, const int* symmMult, const complex* phase, complex* x)
+void eblas_symmetrize_orbit_sub(size_t iStart, size_t iStop, const int* orbitStart, const int* orbitIndex, const complex* orbitWeight, const std::vector<complex*>* x)
 {	for(size_t i=iStart; i<iStop; i++)
-		eblas_symmetrize_phase_calc(i, n, symmIndex, symmMult, phase, x);
+		for(complex* xk: *x) //process all arrays while this orbit's indices and weights are in cache
+			eblas_symmetrize_orbit_calc(i, orbitStart, orbitIndex, orbitWeight, xk);
 }
-void eblas_symmetrize(int N, int n, const int* symmIndex, const int* symmMult, const complex* phase, complex* x)
-{	threadLaunch((N*n<10000) ? 1 : 0, //force single threaded for small problem sizes
-		eblas_symmetrize_phase_sub, N, n, symmIndex, symmMult, phase, x);
+void eblas_symmetrize(int N, const int* orbitStart, const int* orbitIndex, const complex* orbitWeight, const std::vector<complex*>& x)
+{	threadLaunch((orbitStart[N]*x.size()<10000) ? 1 : 0, //force single threaded for small problem sizes
+		eblas_symmetrize_orbit_sub, N, orbitStart, orbitIndex, orbitWeight, &x);
 }
 
 void eblas_symmetrize_phase_rot_sub(size_t iStart, size_t iStop, int n, const int* symmIndex, const int* symmMult, const complex* phase, const matrix3<>* rotSpin, complexPtr4 x)
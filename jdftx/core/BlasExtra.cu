@@ -155,13 +155,14 @@ void eblas_symmetrize_gpu(int N, int n, const int* symmIndex, double* x) { eblas
 void eblas_symmetrize_gpu(int N, int n, const int* symmIndex, complex* x) { eblas_symmetrize_gpu<complex>(N, n, symmIndex, x); }
 
 __global__
-void eblas_symmetrize_phase_kernel(int N, int n, const int* symmIndex, const int* symmMult, const complex* phase, complex* x)
+void eblas_symmetrize_orbit_kernel(int N, const int* orbitStart, const int* orbitIndex, const complex* orbitWeight, complex* x)
 {	int i=kernelIndex1D();
-	if(i<N) eblas_symmetrize_phase_calc(i, n, symmIndex, symmMult, phase, x);
+	if(i<N) eblas_symmetrize_orbit_calc(i, orbitStart, orbitIndex, orbitWeight, x);
 }
-void eblas_symmetrize_gpu(int N, int n, const int* symmIndex, const int* symmMult, const complex* phase, complex* x)
-{	GpuLaunchConfig1D glc(eblas_symmetrize_phase_kernel, N);
-	eblas_symmetrize_phase_kernel<<<glc.nBlocks,glc.nPerBlock>>>(N, n, symmIndex, symmMult, phase, x);
+void eblas_symmetrize_gpu(int N, const int* orbitStart, const int* orbitIndex, const complex* orbitWeight, const std::vector<complex*>& x)
+{	GpuLaunchConfig1D glc(eblas_symmetrize_orbit_kernel, N);
+	for(complex* xk: x)
+		eblas_symmetrize_orbit_kernel<<<glc.nBlocks,glc.nPerBlock>>>(N, orbitStart, orbitIndex, orbitWeight, xk);
 	gpuErrorCheck();
 }
 
@@ -234,18 +234,17 @@ void eblas_symmetrize_gpu(int N, int n, const int* symmIndex, double* x);
 void eblas_symmetrize_gpu(int N, int n, const int* symmIndex, complex* x);
 #endif
 
-//! @brief Symmetrize a complex array x with phase factors, using N n-fold equivalence classes in symmIndex
-//! (useful for space group symmetrization in reciprocal space)
-//! @param N Length of array x
-//! @param n Length of symmetry equivalence classes
-//! @param symmIndex Every consecutive set of n indices in this array forms an equivalence class
-//! @param symmMult Multiplicity per equivalence class (number of repetitions of each element in orbit)
-//! @param phase Phase factors corresponding to each entry in symmIndex
-//! @param x Data array to be symmetrized in place
-void eblas_symmetrize(int N, int n, const int* symmIndex, const int* symmMult, const complex* phase, complex* x);
+//! @brief Symmetrize several complex arrays with phase factors using compact orbit tables
+//! (useful for space group symmetrization of multiple fields in reciprocal space in a single pass)
+//! @param N Number of orbits (equivalence classes)
+//! @param orbitStart Offsets of each orbit's entries in orbitIndex and orbitWeight (length N+1)
+//! @param orbitIndex Distinct array indices in each orbit, stored consecutively
+//! @param orbitWeight Weight of each entry, combining phase factors, multiplicity and normalization
+//! @param x Data arrays to be symmetrized in place (all with the same layout)
+void eblas_symmetrize(int N, const int* orbitStart, const int* orbitIndex, const complex* orbitWeight, const std::vector<complex*>& x);
 #ifdef GPU_ENABLED
 //! @brief Equivalent of eblas_symmetrize() for complex GPU data pointers
-void eblas_symmetrize_gpu(int N, int n, const int* symmIndex, const int* symmMult, const complex* phase, complex* x);
+void eblas_symmetrize_gpu(int N, const int* orbitStart, const int* orbitIndex, const complex* orbitWeight, const std::vector<complex*>& x);
 #endif
 
 //! @brief Symmetrize a quadruplet of complex arrays with phase factors, using N n-fold equivalence classes in symmIndex
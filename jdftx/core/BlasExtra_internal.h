@@ -73,15 +73,13 @@ template<typename scalar> __hostanddev__ void eblas_symmetrize_calc(size_t i, in
 	for(int j=0; j<n; j++) x[symmIndex[n*i+j]] = xSum;
 }
 
-__hostanddev__ void eblas_symmetrize_phase_calc(size_t i, int n, const int* symmIndex, const int* symmMult, const complex* phase, complex* x)
-{	complex xSum = 0.;
-	for(int j=0; j<n; j++)
-		xSum += x[symmIndex[n*i+j]] * phase[n*i+j];
-	xSum *= 1./(n*symmMult[i]); //average n in the equivalence class, with weight for accumulation below accounted)
-	for(int j=0; j<n; j++)
-		x[symmIndex[n*i+j]] = 0.;
-	for(int j=0; j<n; j++)
-		x[symmIndex[n*i+j]] += xSum * phase[n*i+j].conj();
+__hostanddev__ void eblas_symmetrize_orbit_calc(size_t i, const int* orbitStart, const int* orbitIndex, const complex* orbitWeight, complex* x)
+{	int jStart = orbitStart[i], jStop = orbitStart[i+1];
+	complex xSum = 0.;
+	for(int j=jStart; j<jStop; j++)
+		xSum += x[orbitIndex[j]] * orbitWeight[j]; //weights include phases, multiplicity and normalization
+	for(int j=jStart; j<jStop; j++)
+		x[orbitIndex[j]] = xSum * orbitWeight[j].conj();
 }
 
 //! Quadruplet of complex arrays corresponding to spin density matrix channels
@@ -46,6 +46,7 @@ struct CoulombParams
 	double Rc; //!< Truncation radius for cylindrical / spherical modes (0 => in-radius of Wigner-Seitz cell)
 	
 	double ionMargin; //!< margin around ions when checking localization constraints
+	int nAtomsSPME; //!< minimum number of atoms for which periodic Ewald sums switch to smooth particle-mesh Ewald (disabled if 0, the default)
 	
 	bool embed; //!< whether to embed in double-sized box (along truncated directions) to compute Coulomb interactions
 	vector3<> embedCenter; //!< 'center' of the system, when it is embedded into the larger box (in lattice coordinates)
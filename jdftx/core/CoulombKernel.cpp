@@ -24,6 +24,7 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #include <core/ManagedMemory.h>
 #include <core/Thread.h>
 #include <cfloat>
+#include <list>
 
 const double CoulombKernel::nSigmasPerWidth = 1.+sqrt(-2.*log(DBL_EPSILON)); //gaussian negligible at double precision (+1 sigma for safety)
 
@@ -33,8 +34,30 @@ CoulombKernel::CoulombKernel(const matrix3<> R, const vector3<int> S, const vect
 }
 
 
+//Previously computed kernels (reused between calculations in batch mode):
+struct CoulombKernelMemo
+{	matrix3<> R; vector3<int> S; vector3<bool> isTruncated; double omega; bool withStress;
+	std::vector<double> data;
+	std::vector< symmetricMatrix3<> > data_RRT;
+	
+	bool matches(const CoulombKernel& kernel, bool withStress) const
+	{	return R==kernel.R && S==kernel.S && isTruncated==kernel.isTruncated
+			&& omega==kernel.omega && this->withStress==withStress;
+	}
+};
+
 void CoulombKernel::compute(double* data, const WignerSeitz& ws, symmetricMatrix3<>* data_RRT) const
-{	//Count number of truncated directions:
+{	size_t nData = S[0]*S[1]*(1+S[2]/2);
+	//Check for identical kernel from previous calculations in batch mode:
+	static std::list<CoulombKernelMemo> memo;
+	if(batchMode)
+		for(const CoulombKernelMemo& m: memo)
+			if(m.matches(*this, data_RRT))
+			{	std::copy(m.data.begin(), m.data.end(), data);
+				if(data_RRT) std::copy(m.data_RRT.begin(), m.data_RRT.end(), data_RRT);
+				return;
+			}
+	//Count number of truncated directions:
 	int nTruncated = 0;
 	for(int k=0; k<3; k++) if(isTruncated[k]) nTruncated++;
 	//Call appropriate routine:
@@ -43,6 +66,16 @@ void CoulombKernel::compute(double* data, const WignerSeitz& ws, symmetricMatrix
 		case 3: computeIsolated(data, ws, data_RRT); break;
 		default: assert(!"Invalid truncated direction count");
 	}
+	//Save for subsequent calculations in batch mode:
+	if(batchMode)
+	{	const int nMemoMax = 4; //limit memory usage: only most recent kernels retained
+		CoulombKernelMemo m;
+		m.R = R; m.S = S; m.isTruncated = isTruncated; m.omega = omega; m.withStress = data_RRT;
+		m.data.assign(data, data+nData);
+		if(data_RRT) m.data_RRT.assign(data_RRT, data_RRT+nData);
+		memo.push_front(m);
+		if(memo.size() > nMemoMax) memo.pop_back();
+	}
 }
 
 //! Compute erfc(omega r)/r - erfc(a r)/r
@@ -21,6 +21,7 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #include <core/Coulomb_internal.h>
 #include <core/CoulombKernel.h>
 #include <core/BlasExtra.h>
+#include <core/EwaldSPME.h>
 
 //! Standard 3D Ewald sum
 class EwaldPeriodic : public Ewald
@@ -147,7 +148,9 @@ ScalarFieldTilde CoulombPeriodic::apply(ScalarFieldTilde&& in) const
 }
 
 std::shared_ptr<Ewald> CoulombPeriodic::createEwald(matrix3<> R, size_t nAtoms) const
-{	return std::make_shared<EwaldPeriodic>(R, nAtoms);
+{	if(params.nAtomsSPME && int(nAtoms) >= params.nAtomsSPME)
+		return std::make_shared<EwaldSPME>(R, nAtoms);
+	return std::make_shared<EwaldPeriodic>(R, nAtoms);
 }
 
 matrix3<> CoulombPeriodic::getLatticeGradient(const ScalarFieldTilde& X, const ScalarFieldTilde& Y) const
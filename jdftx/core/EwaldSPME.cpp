@@ -0,0 +1,285 @@
+/*-------------------------------------------------------------------
+Copyright 2026 Ravishankar Sundararaman
+
+This file is part of JDFTx.
+
+JDFTx is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+JDFTx is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------*/
+
+#include <core/EwaldSPME.h>
+#include <core/CoulombKernel.h>
+#include <core/Operators.h>
+#include <core/Thread.h>
+
+const int EwaldSPME::order = 8;
+
+EwaldSPME::EwaldSPME(const matrix3<>& R, int nAtoms)
+: R(R), G((2*M_PI)*inv(R)), RTR((~R)*R), GGT(G*(~G)), detR(fabs(det(R)))
+{	logPrintf("\n---------- Setting up smooth particle-mesh ewald sum ----------\n");
+	//Choose the real-space cutoff to include a fixed number of neighbours on average,
+	//which balances the O(N) real-space sum against the O(N log N) mesh part:
+	const double nNeighbors = 200.;
+	rCut = cbrt(nNeighbors * detR / ((4*M_PI/3) * std::max(1,nAtoms)));
+	sigma = rCut / CoulombKernel::nSigmasPerWidth;
+	logPrintf("Gaussian width for ewald sums = %lf bohr (real-space cutoff %lf bohr).\n", sigma, rCut);
+
+	//Coarse grid resolving the gaussian (oversampled to bring B-spline interpolation errors to ~1e-9 relative):
+	const double oversample = 1.25;
+	double Gnyq = oversample * CoulombKernel::nSigmasPerWidth / sigma;
+	gInfo.R = R;
+	for(int k=0; k<3; k++)
+	{	gInfo.S[k] = std::max(2*order, 2*int(ceil(Gnyq * R.column(k).length() / (2*M_PI))));
+		while(!fftSuitable(gInfo.S[k])) gInfo.S[k] += 2;
+	}
+	logSuspend();
+	gInfo.initialize(true);
+	logResume();
+	logPrintf("Particle-mesh grid with B-spline order %d: ", order); gInfo.S.print(globalLog, " %d ");
+
+	//B-spline structure factor correction |b(m)|^2 along each direction:
+	std::vector<double> bSq[3];
+	{	std::vector<double> M(order), Mprime(order);
+		bSpline(0., M.data(), Mprime.data()); //M[j] = M_order(j)
+		for(int k=0; k<3; k++)
+		{	bSq[k].resize(gInfo.S[k]);
+			for(int m=0; m<gInfo.S[k]; m++)
+			{	complex den = 0.;
+				for(int j=0; j<=order-2; j++)
+					den += M[j+1] * cis((2*M_PI*m*j)/gInfo.S[k]);
+				bSq[k][m] = 1./den.norm();
+			}
+		}
+	}
+	//Initialize kernel:
+	kernel = std::make_shared<RealKernel>(gInfo);
+	double* kernelData = kernel->data();
+	size_t iHalf = 0;
+	for(int i0=0; i0<gInfo.S[0]; i0++)
+		for(int i1=0; i1<gInfo.S[1]; i1++)
+			for(int i2=0; i2<=gInfo.S[2]/2; i2++)
+			{	vector3<int> iG(i0, i1, i2);
+				for(int k=0; k<3; k++) if(2*iG[k]>gInfo.S[k]) iG[k] -= gInfo.S[k];
+				double Gsq = GGT.metric_length_squared(iG);
+				kernelData[iHalf++] = Gsq
+					? (4*M_PI * exp(-0.5*sigma*sigma*Gsq)/(Gsq * detR)) * bSq[0][i0] * bSq[1][i1] * bSq[2][i2]
+					: 0.;
+			}
+
+	//Cell-list bins of width at least rCut/2:
+	for(int k=0; k<3; k++)
+	{	double h = 2*M_PI / G.row(k).length(); //spacing between lattice planes
+		nBins[k] = std::max(1, int(floor(2*h/rCut)));
+		nBinNeighbors[k] = int(ceil(rCut * nBins[k] / h));
+	}
+	logPrintf("Real-space sum using cell lists with %d bins ", nBins[0]*nBins[1]*nBins[2]);
+	nBins.print(globalLog, " %d ");
+}
+
+void EwaldSPME::bSpline(double frac, double* w, double* wPrime)
+{	//Recursion for M_n(frac+j), starting at n=2:
+	std::vector<double> M(order+1, 0.), Mnext(order+1);
+	M[0] = frac;
+	M[1] = 1.-frac;
+	for(int n=2; n<order; n++)
+	{	if(n == order-1) //derivative of M_order from M_(order-1)
+			for(int j=0; j<order; j++)
+				wPrime[j] = M[j] - (j ? M[j-1] : 0.);
+		for(int j=0; j<=n; j++)
+		{	double t = frac + j;
+			Mnext[j] = (t*M[j] + (n+1-t)*(j ? M[j-1] : 0.)) / n;
+		}
+		std::swap(M, Mnext);
+	}
+	for(int j=0; j<order; j++) w[j] = M[j];
+}
+
+double EwaldSPME::energyAndGrad(std::vector<Atom>& atoms, matrix3<>* E_RRTptr) const
+{	static StopWatch watch("EwaldSPME"); watch.start();
+	double eta = sqrt(0.5)/sigma;
+	double sigmaSq = sigma * sigma;
+	matrix3<> E_RRT; //stress * volume (computed if E_RRTptr non-null)
+
+	//Position independent terms:
+	double Ztot = 0., ZsqTot = 0.;
+	for(const Atom& a: atoms)
+	{	Ztot += a.Z;
+		ZsqTot += a.Z * a.Z;
+	}
+	double E
+		= 0.5 * 4*M_PI * Ztot*Ztot * (-0.5*sigmaSq) / detR //G=0 correction
+		- 0.5 * ZsqTot * eta * (2./sqrt(M_PI)); //Self-energy correction
+	if(E_RRTptr)
+		E_RRT = (-0.5 * 4*M_PI * Ztot*Ztot * (-0.5*sigmaSq) / detR) * matrix3<>(1,1,1);
+
+	//Reduce positions to first centered unit cell:
+	for(Atom& a: atoms)
+		for(int k=0; k<3; k++)
+			a.pos[k] -= floor(0.5 + a.pos[k]);
+	if(not ZsqTot) { watch.stop(); return 0.; }
+
+	//Real space sum using cell lists:
+	{	int nBinsTot = nBins[0]*nBins[1]*nBins[2];
+		std::vector<vector3<int>> atomBin(atoms.size());
+		std::vector<int> binStart(nBinsTot+1, 0), binAtoms(atoms.size());
+		for(size_t iAtom=0; iAtom<atoms.size(); iAtom++)
+		{	vector3<int>& b = atomBin[iAtom];
+			for(int k=0; k<3; k++)
+				b[k] = std::min(nBins[k]-1, int(floor((atoms[iAtom].pos[k] + 0.5) * nBins[k])));
+			binStart[b[2] + nBins[2]*(b[1] + nBins[1]*b[0]) + 1]++;
+		}
+		for(int iBin=0; iBin<nBinsTot; iBin++) binStart[iBin+1] += binStart[iBin]; //cumulative counts
+		std::vector<int> binFill(binStart.begin(), binStart.end()-1);
+		for(size_t iAtom=0; iAtom<atoms.size(); iAtom++)
+		{	const vector3<int>& b = atomBin[iAtom];
+			binAtoms[binFill[b[2] + nBins[2]*(b[1] + nBins[1]*b[0])]++] = iAtom;
+		}
+		std::mutex lock;
+		threadLaunch(realSpace_sub, atoms.size(), this, &atoms, &binStart, &binAtoms, &atomBin,
+			&E, E_RRTptr ? &E_RRT : (matrix3<>*)0, &lock);
+	}
+
+	//Reciprocal space sum on the particle mesh:
+	//--- spread charges:
+	ScalarField Q; nullToZero(Q, gInfo);
+	double* Qdata = Q->data();
+	const vector3<int>& S = gInfo.S;
+	std::vector<double> w(3*order), wPrime(3*order);
+	for(const Atom& a: atoms)
+	{	vector3<int> n0;
+		for(int k=0; k<3; k++)
+		{	double u = S[k] * a.pos[k];
+			n0[k] = int(floor(u));
+			bSpline(u-n0[k], &w[k*order], &wPrime[k*order]);
+		}
+		vector3<int> n;
+		for(int j0=0; j0<order; j0++)
+		{	n[0] = (n0[0]-j0+S[0]) % S[0];
+			for(int j1=0; j1<order; j1++)
+			{	n[1] = (n0[1]-j1+S[1]) % S[1];
+				double Zw01 = a.Z * w[j0] * w[order+j1];
+				for(int j2=0; j2<order; j2++)
+				{	n[2] = (n0[2]-j2+S[2]) % S[2];
+					Qdata[gInfo.fullRindex(n)] += Zw01 * w[2*order+j2];
+				}
+			}
+		}
+	}
+	//--- energy and stress from structure factor:
+	ScalarFieldTilde Qtilde = Idag(Q);
+	const complex* QtildeData = Qtilde->data();
+	const double* kernelData = kernel->data();
+	double Erecip = 0.;
+	matrix3<> E_RRTrecip;
+	size_t iHalf = 0;
+	for(int i0=0; i0<S[0]; i0++)
+		for(int i1=0; i1<S[1]; i1++)
+			for(int i2=0; i2<=S[2]/2; i2++)
+			{	double weight = (i2==0 || 2*i2==S[2]) ? 0.5 : 1.; //account for the missing half of G-space
+				double eQsq = weight * kernelData[iHalf] * QtildeData[iHalf].norm();
+				Erecip += eQsq;
+				if(E_RRTptr && eQsq)
+				{	vector3<int> iG(i0, i1, i2);
+					for(int k=0; k<3; k++) if(2*iG[k]>S[k]) iG[k] -= S[k];
+					vector3<> Gcart = iG * G;
+					double Gsq = Gcart.length_squared();
+					E_RRTrecip += eQsq * ((sigmaSq + 2./Gsq) * outer(Gcart,Gcart) - matrix3<>(1,1,1));
+				}
+				iHalf++;
+			}
+	E += Erecip;
+	if(E_RRTptr) E_RRT += E_RRTrecip;
+	//--- forces by interpolating the mesh potential:
+	ScalarField phi = I((*kernel) * Qtilde);
+	threadLaunch(interpolateForces_sub, atoms.size(), this, &atoms, (const double*)phi->data());
+
+	if(E_RRTptr) *E_RRTptr += E_RRT;
+	watch.stop();
+	return E;
+}
+
+void EwaldSPME::realSpace_sub(size_t iStart, size_t iStop, const EwaldSPME* ewald, std::vector<Atom>* atoms,
+	const std::vector<int>* binStart, const std::vector<int>* binAtoms, const std::vector<vector3<int>>* atomBin,
+	double* E, matrix3<>* E_RRT, std::mutex* lock)
+{	const vector3<int>& nBins = ewald->nBins;
+	const vector3<int>& nbr = ewald->nBinNeighbors;
+	double eta = sqrt(0.5)/ewald->sigma, etaSq = eta*eta;
+	double rCutSq = ewald->rCut * ewald->rCut;
+	double Emine = 0.;
+	matrix3<> E_RRTmine;
+	for(size_t i1=iStart; i1<iStop; i1++)
+	{	Atom& a1 = atoms->at(i1);
+		const vector3<int>& b1 = atomBin->at(i1);
+		vector3<int> db, b2, cell;
+		for(db[0]=-nbr[0]; db[0]<=nbr[0]; db[0]++)
+		for(db[1]=-nbr[1]; db[1]<=nbr[1]; db[1]++)
+		for(db[2]=-nbr[2]; db[2]<=nbr[2]; db[2]++)
+		{	//Wrap neighbouring bin into the unit cell, keeping track of the lattice image:
+			for(int k=0; k<3; k++)
+			{	b2[k] = b1[k] + db[k];
+				cell[k] = int(floor(double(b2[k]) / nBins[k]));
+				b2[k] -= cell[k] * nBins[k];
+			}
+			int iBin = b2[2] + nBins[2]*(b2[1] + nBins[1]*b2[0]);
+			for(int j=binStart->at(iBin); j<binStart->at(iBin+1); j++)
+			{	const Atom& a2 = atoms->at(binAtoms->at(j));
+				vector3<> x = a1.pos - (a2.pos + cell);
+				double rSq = ewald->RTR.metric_length_squared(x);
+				if(!rSq || rSq > rCutSq) continue; //exclude self-interaction and pairs beyond cutoff
+				double r = sqrt(rSq);
+				Emine += 0.5 * a1.Z * a2.Z * erfc(eta*r)/r;
+				double minus_E_r_by_r = a1.Z * a2.Z * (erfc(eta*r)/r + (2./sqrt(M_PI))*eta*exp(-etaSq*rSq))/rSq;
+				a1.force += (ewald->RTR * x) * minus_E_r_by_r;
+				if(E_RRT)
+				{	vector3<> rVec = ewald->R * x;
+					E_RRTmine -= (0.5*minus_E_r_by_r) * outer(rVec,rVec);
+				}
+			}
+		}
+	}
+	std::lock_guard<std::mutex> guard(*lock);
+	*E += Emine;
+	if(E_RRT) *E_RRT += E_RRTmine;
+}
+
+void EwaldSPME::interpolateForces_sub(size_t iStart, size_t iStop, const EwaldSPME* ewald, std::vector<Atom>* atoms, const double* phi)
+{	const GridInfo& gInfo = ewald->gInfo;
+	const vector3<int>& S = gInfo.S;
+	std::vector<double> w(3*order), wPrime(3*order);
+	for(size_t iAtom=iStart; iAtom<iStop; iAtom++)
+	{	Atom& a = atoms->at(iAtom);
+		vector3<int> n0;
+		for(int k=0; k<3; k++)
+		{	double u = S[k] * a.pos[k];
+			n0[k] = int(floor(u));
+			bSpline(u-n0[k], &w[k*order], &wPrime[k*order]);
+		}
+		vector3<> E_x; //derivative of energy w.r.t lattice coordinates
+		vector3<int> n;
+		for(int j0=0; j0<order; j0++)
+		{	n[0] = (n0[0]-j0+S[0]) % S[0];
+			for(int j1=0; j1<order; j1++)
+			{	n[1] = (n0[1]-j1+S[1]) % S[1];
+				for(int j2=0; j2<order; j2++)
+				{	n[2] = (n0[2]-j2+S[2]) % S[2];
+					double phi_n = phi[gInfo.fullRindex(n)];
+					E_x[0] += phi_n * wPrime[j0] * w[order+j1] * w[2*order+j2];
+					E_x[1] += phi_n * w[j0] * wPrime[order+j1] * w[2*order+j2];
+					E_x[2] += phi_n * w[j0] * w[order+j1] * wPrime[2*order+j2];
+				}
+			}
+		}
+		for(int k=0; k<3; k++)
+			a.force[k] -= a.Z * S[k] * E_x[k];
+	}
+}
@@ -0,0 +1,63 @@
+/*-------------------------------------------------------------------
+Copyright 2026 Ravishankar Sundararaman
+
+This file is part of JDFTx.
+
+JDFTx is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+JDFTx is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------*/
+
+#ifndef JDFTX_CORE_EWALDSPME_H
+#define JDFTX_CORE_EWALDSPME_H
+
+#include <core/Coulomb.h>
+#include <core/GridInfo.h>
+#include <core/ScalarField.h>
+
+//! @addtogroup LongRange
+//! @{
+//! @file EwaldSPME.h Smooth particle-mesh Ewald sum for large periodic systems
+
+//! 3D Ewald sum with the reciprocal-space part evaluated by smooth particle-mesh
+//! interpolation (B-splines on a coarse FFT grid) and the real-space part using cell lists,
+//! so that the cost scales as O(N log N) rather than O(N^2) in the number of atoms
+class EwaldSPME : public Ewald
+{
+public:
+	EwaldSPME(const matrix3<>& R, int nAtoms);
+	double energyAndGrad(std::vector<Atom>& atoms, matrix3<>* E_RRTptr) const;
+
+	static const int order; //!< order of the cardinal B-splines used for charge assignment (even)
+
+private:
+	matrix3<> R, G, RTR, GGT; //!< Lattice vectors, reciprocal lattice vectors and corresponding metrics
+	double detR; //!< unit cell volume
+	double sigma; //!< gaussian width for Ewald sums
+	double rCut; //!< real-space cutoff
+	GridInfo gInfo; //!< coarse grid for the reciprocal-space sum
+	std::shared_ptr<RealKernel> kernel; //!< Ewald kernel including B-spline structure factor corrections
+	vector3<int> nBins; //!< number of cell-list bins along each lattice direction
+	vector3<int> nBinNeighbors; //!< range of neighbouring bins within rCut along each direction
+
+	//! Compute B-spline weights M(frac+j) and derivatives for j = 0 to order-1
+	static void bSpline(double frac, double* w, double* wPrime);
+
+	//Thread functions:
+	static void realSpace_sub(size_t iStart, size_t iStop, const EwaldSPME* ewald, std::vector<Atom>* atoms,
+		const std::vector<int>* binStart, const std::vector<int>* binAtoms, const std::vector<vector3<int>>* atomBin,
+		double* E, matrix3<>* E_RRT, std::mutex* lock);
+	static void interpolateForces_sub(size_t iStart, size_t iStop, const EwaldSPME* ewald, std::vector<Atom>* atoms, const double* phi);
+};
+
+//! @}
+#endif // JDFTX_CORE_EWALDSPME_H
@@ -119,6 +119,9 @@ public:
 		PlanCtoR, //!< Complex to real transform
 	};
 	fftw_plan getPlan(PlanType planType, int nThreads) const; //get an FFTW plan of specified type with specified thread count
+	#ifdef SINGLE_PRECISION_FFT
+	fftwf_plan getPlanSingle(PlanType planType, int nThreads) const; //single-precision version of getPlan (complex transforms only)
+	#endif
 	#ifdef GPU_ENABLED
 	cufftHandle planZ2Z; //!< CUFFT plan for all the complex transforms
 	cufftHandle planD2Z; //!< CUFFT plan for R -> G
@@ -150,6 +153,9 @@ private:
 	
 	//FFTW plans by thread count and type:
 	std::map<std::pair<PlanType,int>,fftw_plan> planCache;
+	#ifdef SINGLE_PRECISION_FFT
+	std::map<std::pair<PlanType,int>,fftwf_plan> planCacheSingle;
+	#endif
 	static std::mutex planLock; //Global lock since planner routines are not thread safe
 };
 
@@ -148,6 +148,7 @@ void MPIUtil::checkErrors(const ostringstream& oss) const
 void MPIUtil::wait(MPIUtil::Request request)
 {
 #ifdef MPI_ENABLED
+	Telemetry::Timer timer(TelemetryMPI);
 	MPI_Wait(&request, MPI_STATUS_IGNORE);
 #endif
 }
@@ -155,6 +156,7 @@ void MPIUtil::wait(MPIUtil::Request request)
 void MPIUtil::waitAll(const std::vector<Request>& requests)
 {
 #ifdef MPI_ENABLED
+	Telemetry::Timer timer(TelemetryMPI);
 	MPI_Waitall(requests.size(), (Request*)requests.data(), MPI_STATUS_IGNORE);
 #endif
 }
@@ -369,6 +371,36 @@ void TaskDivision::init(size_t nTasks, const MPIUtil* mpiUtil)
 	stopMine = stop(mpiUtil->iProcess());
 }
 
+void TaskDivision::init(const std::vector<double>& taskCost, const MPIUtil* mpiUtil)
+{	size_t nTasks = taskCost.size();
+	//Use the equal division if all costs are the same:
+	bool uniform = true;
+	for(double cost: taskCost)
+		if(cost != taskCost[0])
+		{	uniform = false;
+			break;
+		}
+	if(uniform)
+	{	init(nTasks, mpiUtil);
+		return;
+	}
+	//Cumulative cost:
+	std::vector<double> costCum(nTasks+1, 0.);
+	for(size_t j=0; j<nTasks; j++)
+		costCum[j+1] = costCum[j] + taskCost[j];
+	//Place each boundary at the task whose midpoint is closest to the ideal cumulative cost:
+	stopArr.resize(mpiUtil->nProcesses());
+	size_t j = 0;
+	for(int iProc=0; iProc<mpiUtil->nProcesses(); iProc++)
+	{	double costTarget = (costCum[nTasks] * (iProc+1)) / mpiUtil->nProcesses();
+		while(j<nTasks && costCum[j]+0.5*taskCost[j] <= costTarget) j++;
+		stopArr[iProc] = j;
+	}
+	stopArr.back() = nTasks;
+	startMine = start(mpiUtil->iProcess());
+	stopMine = stop(mpiUtil->iProcess());
+}
+
 int TaskDivision::whose(size_t q) const
 {	if(stopArr.size()>1)
 		return std::upper_bound(stopArr.begin(),stopArr.end(), q) - stopArr.begin();
@@ -22,6 +22,7 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <core/string.h>
 #include <core/matrix3.h>
+#include <core/TelemetryTimer.h>
 #include <cstdlib>
 #include <cstdio>
 #include <vector>
@@ -136,12 +137,13 @@ public:
 };
 
 
-//! Helper for optimally dividing a specified number of (equal) tasks over MPI
+//! Helper for optimally dividing a specified number of (equal or weighted) tasks over MPI
 class TaskDivision
 {
 public:
 	TaskDivision(size_t nTasks=0, const MPIUtil* mpiUtil=0);
 	void init(size_t nTasks, const MPIUtil* mpiUtil);
+	void init(const std::vector<double>& taskCost, const MPIUtil* mpiUtil); //!< divide contiguous ranges of tasks with unequal costs, balancing the total cost per process
 	inline size_t start() const { return startMine; } //!< Task number that current process should start on
 	inline size_t stop() const  { return stopMine; } //!< Task number that current process should stop before (non-inclusive)
 	inline size_t start(int iProc) const { return iProc ? stopArr[iProc-1] : 0; } //!< Task number that the specified process should start on
@@ -244,7 +246,8 @@ template<typename T> void MPIUtil::send(const T* data, size_t nData, int dest, i
 {	using namespace MPIUtilPrivate;
 	#ifdef MPI_ENABLED
 	if(nProcs>1)
-	{	if(request)
+	{	Telemetry::Timer timer(TelemetryMPI, !request); //blocking calls only
+		if(request)
 			MPI_Isend((void*)data, DataType<T>::nElem*nData, DataType<T>::get(), dest, tag, comm, request);
 		else
 			MPI_Send((void*)data, DataType<T>::nElem*nData, DataType<T>::get(), dest, tag, comm);
@@ -262,7 +265,8 @@ template<typename T> void MPIUtil::recv(T* data, size_t nData, int src, int tag,
 {	using namespace MPIUtilPrivate;
 	#ifdef MPI_ENABLED
 	if(nProcs>1)
-	{	if(request)
+	{	Telemetry::Timer timer(TelemetryMPI, !request); //blocking calls only
+		if(request)
 			MPI_Irecv(data, DataType<T>::nElem*nData, DataType<T>::get(), src, tag, comm, request);
 		else
 			MPI_Recv(data, DataType<T>::nElem*nData, DataType<T>::get(), src, tag, comm, MPI_STATUS_IGNORE);
@@ -280,7 +284,7 @@ template<typename T> void MPIUtil::bcast(T* data, size_t nData, int root, Reques
 {	using namespace MPIUtilPrivate;
 	#ifdef MPI_ENABLED
 	if(nProcs>1)
-	{		
+	{	Telemetry::Timer timer(TelemetryMPI, !request); //blocking calls only
 		#if MPI_VERSION < 3
 		if(request) *request = MPI_REQUEST_NULL; //Non-blocking collective not supported (fall back to blocking version below)
 		#else
@@ -304,12 +308,14 @@ template<typename T> void MPIUtil::allReduce(T* data, size_t nData, MPIUtil::Red
 	#ifdef MPI_ENABLED
 	if(nProcs>1)
 	{	if(safeMode) //Reduce to root node and then broadcast result (to ensure identical values)
-		{	MPI_Reduce(isHead()?MPI_IN_PLACE:data, data, DataType<T>::nElem*nData, DataType<T>::get(), mpiOp(op), 0, comm);
+		{	{	Telemetry::Timer timer(TelemetryMPI); //bcast below is timed separately
+				MPI_Reduce(isHead()?MPI_IN_PLACE:data, data, DataType<T>::nElem*nData, DataType<T>::get(), mpiOp(op), 0, comm);
+			}
 			bcast(data, nData, 0);
 			if(request) throw string("Asynchronous allReduce not supported in safeMode");
 		}
 		else //standard Allreduce
-		{		
+		{	Telemetry::Timer timer(TelemetryMPI, !request); //blocking calls only
 			#if MPI_VERSION < 3
 			if(request) *request = MPI_REQUEST_NULL; //Non-blocking collective not supported (fall back to blocking version below)
 			#else
@@ -329,7 +335,8 @@ template<typename T> void MPIUtil::allReduce(T& data, int& index, MPIUtil::Reduc
 {	using namespace MPIUtilPrivate;
 	#ifdef MPI_ENABLED
 	if(nProcs>1)
-	{	typename DataTypeIntPair<T>::Elem pair;
+	{	Telemetry::Timer timer(TelemetryMPI);
+		typename DataTypeIntPair<T>::Elem pair;
 		pair.data = data; pair.index = index;
 		MPI_Allreduce(MPI_IN_PLACE, &pair, 1, DataTypeIntPair<T>::get(), mpiLocOp(op), comm);
 		data = pair.data; index = pair.index;
@@ -344,7 +351,7 @@ template<typename T> void MPIUtil::reduce(T* data, size_t nData, MPIUtil::Reduce
 {	using namespace MPIUtilPrivate;
 	#ifdef MPI_ENABLED
 	if(nProcs>1)
-	{	
+	{	Telemetry::Timer timer(TelemetryMPI, !request); //blocking calls only
 		#if MPI_VERSION < 3
 		if(request) *request = MPI_REQUEST_NULL; //Non-blocking collective not supported (fall back to blocking version below)
 		#else
@@ -363,7 +370,8 @@ template<typename T> void MPIUtil::reduce(T& data, int& index, MPIUtil::ReduceOp
 {	using namespace MPIUtilPrivate;
 	#ifdef MPI_ENABLED
 	if(nProcs>1)
-	{	typename DataTypeIntPair<T>::Elem pair;
+	{	Telemetry::Timer timer(TelemetryMPI);
+		typename DataTypeIntPair<T>::Elem pair;
 		pair.data = data; pair.index = index;
 		MPI_Reduce((iProc==root)?MPI_IN_PLACE:&pair, &pair, 1, DataTypeIntPair<T>::get(), mpiLocOp(op), root, comm);
 		data = pair.data; index = pair.index;
@@ -22,6 +22,7 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <core/MinimizeParams.h>
 #include <core/Util.h>
+#include <core/Telemetry.h>
 #include <deque>
 #include <cmath>
 #include <cfloat>
@@ -65,6 +66,14 @@ template<typename Vector> struct Minimizable
 	//! Override to return maximum safe step size along a given direction. Steps can be arbitrarily large by default.
 	virtual double safeStepSize(const Vector& dir) const { return DBL_MAX; }
 	
+	//! Override to provide an additional convergence criterion, checked once per iteration after the energy and gradient tests.
+	//! It should return whether converged, and if so, set reason to a short description for the log
+	virtual bool checkConvergence(string& reason) { return false; }
+	
+	//! Override to name the stage (eg. "electronic") for telemetry records of each iteration.
+	//! Only do so for minimizations that run in sync over all processes of mpiWorld, since records are collective.
+	virtual const char* telemetryStage() const { return 0; }
+	
 	//! Minimize this objective function with algorithm controlled by params and return the minimized value
 	double minimize(const MinimizeParams& params);
 	
@@ -76,6 +85,7 @@ private:
 	typedef bool (*Linmin)(Minimizable<Vector>&, const MinimizeParams&, const Vector&, double, double&, double&, Vector&, Vector&);
 	Linmin getLinmin(const MinimizeParams& params) const; //!< Return function pointer to appropriate linmin method based on MinimizeParams
 	double lBFGS(const MinimizeParams& params); //!< limited memory BFGS implementation (differs sufficiently from CG to be justify a separate implementation)
+	double fire(const MinimizeParams& params); //!< FIRE damped-dynamics minimizer (gradient only, no line minimization)
 };
 
 /** Interface (abstract base class) for linear conjugate gradients template which
@@ -96,6 +106,9 @@ template<typename Vector> struct LinearSolvable
 	//! Override to synchronize scalars over MPI processes (if the same minimization is happening in sync over many processes)
 	virtual double sync(double x) const { return x; }
 	
+	//! Override to name the stage for telemetry records of each iteration (see Minimizable::telemetryStage)
+	virtual const char* telemetryStage() const { return 0; }
+	
 	//! Solve the linear system hessian * state == rhs using conjugate gradients:
 	//! @return the number of iterations taken to achieve target tolerance
 	int solve(const Vector& rhs, const MinimizeParams& params);
@@ -117,11 +130,13 @@ public:
 
 #include <core/Minimize_linmin.h>
 #include <core/Minimize_lBFGS.h>
+#include <core/Minimize_FIRE.h>
 
 template<typename Vector> double Minimizable<Vector>::minimize(const MinimizeParams& p)
 {	if(p.fdTest) fdTest(p); // finite difference test
 	if(p.maxThreshold) assert(p.maxCalculator != NULL);
 	if(p.dirUpdateScheme == MinimizeParams::LBFGS) return lBFGS(p);
+	if(p.dirUpdateScheme == MinimizeParams::FIRE) return fire(p);
 	
 	Vector g, gPrev, Kg; //current, previous and preconditioned gradients
 	double E = sync(compute(&g, &Kg)); //get initial energy and gradient
@@ -185,6 +200,7 @@ template<typename Vector> double Minimizable<Vector>::minimize(const MinimizePar
 				case MinimizeParams::HestenesStiefel: beta = (gKNorm-dotgPrevKg)/(dotgd-sync(dot(d,gPrev))); break;
 				case MinimizeParams::SteepestDescent: beta = 0.0; break;
 				case MinimizeParams::LBFGS: break; //Should never encounter since LBFGS handled separately; just to eliminate compiler warnings
+				case MinimizeParams::FIRE: break; //Similarly handled separately
 			}
 			if(beta<0.0)
 			{	fprintf(p.fpLog, "\n%sEncountered beta<0, resetting CG.", p.linePrefix);
@@ -193,6 +209,7 @@ template<typename Vector> double Minimizable<Vector>::minimize(const MinimizePar
 		}
 		forceGradDirection = false;
 		fprintf(p.fpLog, "\n"); fflush(p.fpLog);
+		Telemetry::record(telemetryStage(), iter, E, knormValue);
 		int nConverged = 0;
 		ostringstream ossConverged;
 		if(fabs(knormValue) < p.knormThreshold)
@@ -206,6 +223,12 @@ template<typename Vector> double Minimizable<Vector>::minimize(const MinimizePar
 				<< " for " << p.nEnergyDiff << " iters";
 			nConverged++;
 		}
+		string customReason;
+		if(checkConvergence(customReason)) //additional criterion from derived class (sufficient by itself)
+		{	if(nConverged) ossConverged << ", ";
+			ossConverged << customReason;
+			nConverged = 2;
+		}
 		if(nConverged >= (p.convergeAll ? 2 : 1))
 		{	fprintf(p.fpLog, "%sConverged (%s).\n", p.linePrefix, ossConverged.str().c_str());
 			fflush(p.fpLog); return E;
@@ -349,6 +372,7 @@ template<typename Vector> int LinearSolvable<Vector>::solve(const Vector& rhs, c
 		double rzNorm = sqrt(fabs(rdotz)/p.nDim);
 		fprintf(p.fpLog, "%sIter: %3d  sqrt(|r.z|): %12.6le  alpha: %12.6le  beta: %13.6le  t[s]: %9.2lf\n",
 			p.linePrefix, iter, rzNorm, alpha, beta, clock_sec()); fflush(p.fpLog);
+		Telemetry::recordLocal(telemetryStage(), iter, NAN, rzNorm); //not collective: cheap iterations need not run in lock step
 		//Check convergence:
 		if(rzNorm<p.knormThreshold) { fprintf(p.fpLog, "%sConverged sqrt(r.z)<%le\n", p.linePrefix, p.knormThreshold); fflush(p.fpLog); return iter; }
 	}
@@ -34,7 +34,8 @@ struct MinimizeParams
 		FletcherReeves, //!< Fletcher-Reeves (preconditioned) conjugate gradients
 		HestenesStiefel, //!< Hestenes-Stiefel (preconditioned) conjugate gradients
 		LBFGS, //!< Limited memory version of the BFGS algorithm
-		SteepestDescent //!< Steepest Descent (always along negative (preconditioned) gradient)
+		SteepestDescent, //!< Steepest Descent (always along negative (preconditioned) gradient)
+		FIRE //!< Fast inertial relaxation engine: damped dynamics using gradients alone (linminMethod ignored)
 	} dirUpdateScheme;
 
 	//! Line minimization method
@@ -0,0 +1,150 @@
+/*-------------------------------------------------------------------
+Copyright 2026 Ravishankar Sundararaman
+
+This file is part of JDFTx.
+
+JDFTx is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+JDFTx is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------*/
+
+#ifndef JDFTX_CORE_MINIMIZE_FIRE_H
+#define JDFTX_CORE_MINIMIZE_FIRE_H
+
+//! @addtogroup Algorithms
+//! @{
+
+/** Fast inertial relaxation engine (E. Bitzek et al, Phys. Rev. Lett. 97, 170201 (2006)).
+Damped dynamics along the negative preconditioned gradient, using only gradients:
+each iteration costs exactly one compute() and there is no line search.
+The time step starts at alphaTstart and is capped at 10 alphaTstart and by safeStepSize(). */
+template<typename Vector> double Minimizable<Vector>::fire(const MinimizeParams& p)
+{	//Standard FIRE parameters:
+	const int nMin = 5; //minimum number of downhill steps before increasing time step
+	const double fInc = 1.1, fDec = 0.5; //time step increase / decrease factors
+	const double aStart = 0.1, fa = 0.99; //initial mixing factor and its decay factor
+	const double dtMax = 10. * p.alphaTstart;
+
+	Vector g, Kg; //gradient and preconditioned gradient
+	double E = sync(compute(&g, &Kg)); //get initial energy and gradient
+	Vector v = clone(Kg); v *= 0.; //velocity (in units of the preconditioned gradient)
+
+	EdiffCheck ediffCheck(p.nEnergyDiff, p.energyDiffThreshold); //list of past energies
+
+	double dt = p.alphaTstart; //time step
+	double a = aStart; //velocity mixing factor
+	int nDownhill = 0; //number of successive steps with positive power
+	double alpha = 0.; //actual step size of previous iteration
+	const char* knormName = p.maxThreshold ? "grad_max" : "|grad|_K";
+
+	//Iterate until convergence, max iteration count or kill signal
+	int iter=0;
+	for(iter=0; !killFlag; iter++)
+	{
+		if(report(iter)) //optional reporting/processing
+		{	E = sync(compute(&g, &Kg)); //update energy and gradient if state was modified
+			fprintf(p.fpLog, "%s\tState modified externally: resetting velocity.\n", p.linePrefix);
+			fflush(p.fpLog);
+			v *= 0.;
+		}
+
+		double gKnorm = sync(dot(g,Kg));
+		double knormValue = p.maxThreshold ? p.maxCalculator(&Kg) : sqrt(gKnorm/p.nDim);
+		fprintf(p.fpLog, "%sIter: %3d  %s: ", p.linePrefix, iter, p.energyLabel);
+		fprintf(p.fpLog, p.energyFormat, E);
+		fprintf(p.fpLog, "  %s: %10.3le", knormName, knormValue);
+		if(alpha) fprintf(p.fpLog, "  alpha: %10.3le", alpha);
+		fprintf(p.fpLog, "  t[s]: %9.2lf", clock_sec());
+
+		//Check stopping conditions:
+		fprintf(p.fpLog, "\n"); fflush(p.fpLog);
+		Telemetry::record(telemetryStage(), iter, E, knormValue);
+		int nConverged = 0;
+		ostringstream ossConverged;
+		if(fabs(knormValue) < p.knormThreshold)
+		{	ossConverged << knormName << "<" << std::scientific << p.knormThreshold;
+			nConverged++;
+		}
+		if(ediffCheck.checkConvergence(E))
+		{	if(nConverged) ossConverged << ", ";
+			ossConverged << "|Delta " << p.energyLabel << "|<"
+				<< std::scientific << p.energyDiffThreshold
+				<< " for " << p.nEnergyDiff << " iters";
+			nConverged++;
+		}
+		string customReason;
+		if(checkConvergence(customReason)) //additional criterion from derived class (sufficient by itself)
+		{	if(nConverged) ossConverged << ", ";
+			ossConverged << customReason;
+			nConverged = 2;
+		}
+		if(nConverged >= (p.convergeAll ? 2 : 1))
+		{	fprintf(p.fpLog, "%sConverged (%s).\n", p.linePrefix, ossConverged.str().c_str());
+			fflush(p.fpLog); return E;
+		}
+		if(!std::isfinite(gKnorm))
+		{	fprintf(p.fpLog, "%s|grad|_K=%le. Stopping ...\n", p.linePrefix, gKnorm);
+			fflush(p.fpLog); return E;
+		}
+		if(!std::isfinite(E))
+		{	fprintf(p.fpLog, "%sE=%le. Stopping ...\n", p.linePrefix, E);
+			fflush(p.fpLog); return E;
+		}
+		if(iter>=p.nIterations) break;
+
+		//Velocity update: mix towards force direction when going downhill, else stop:
+		double power = -sync(dot(g, v)); //rate of decrease of energy along velocity
+		if(power > 0.)
+		{	double vNorm = sqrt(sync(dot(v,v)));
+			double KgNorm = sqrt(sync(dot(Kg,Kg)));
+			v *= (1.-a);
+			axpy(-a*vNorm/KgNorm, Kg, v);
+			if(++nDownhill > nMin)
+			{	dt = std::min(dt*fInc, dtMax);
+				a *= fa;
+			}
+		}
+		else
+		{	v *= 0.;
+			dt *= fDec;
+			a = aStart;
+			nDownhill = 0;
+		}
+		axpy(-dt, Kg, v); //Euler step of velocity
+		constrain(v);
+
+		//Position update:
+		alpha = std::min(dt, safeStepSize(v));
+		step(v, alpha);
+		E = sync(compute(&g, &Kg));
+		if(!std::isfinite(E))
+		{	//Back off (eg. due to core overlaps) with a reduced time step:
+			fprintf(p.fpLog, "%s\tStep failed with %s = %le: undoing step and reducing time step.\n", p.linePrefix, p.energyLabel, E);
+			fflush(p.fpLog);
+			step(v, -alpha);
+			E = sync(compute(&g, &Kg));
+			v *= 0.;
+			dt *= fDec;
+			a = aStart;
+			nDownhill = 0;
+			if(dt < p.alphaTmin)
+			{	fprintf(p.fpLog, "%s\tTime step below alphaTmin: aborting.\n", p.linePrefix);
+				fflush(p.fpLog); return E;
+			}
+		}
+	}
+	fprintf(p.fpLog, "%sNone of the convergence criteria satisfied after %d iterations.\n", p.linePrefix, iter);
+	return E;
+}
+
+//! @}
+#endif //JDFTX_CORE_MINIMIZE_FIRE_H
@@ -73,6 +73,7 @@ template<typename Vector> double Minimizable<Vector>::lBFGS(const MinimizeParams
 		
 		//Check stopping conditions:
 		fprintf(p.fpLog, "\n"); fflush(p.fpLog);
+		Telemetry::record(telemetryStage(), iter, E, knormValue);
 		int nConverged = 0;
 		ostringstream ossConverged;
 		if(fabs(knormValue) < p.knormThreshold)
@@ -86,6 +87,12 @@ template<typename Vector> double Minimizable<Vector>::lBFGS(const MinimizeParams
 				<< " for " << p.nEnergyDiff << " iters";
 			nConverged++;
 		}
+		string customReason;
+		if(checkConvergence(customReason)) //additional criterion from derived class (sufficient by itself)
+		{	if(nConverged) ossConverged << ", ";
+			ossConverged << customReason;
+			nConverged = 2;
+		}
 		if(nConverged >= (p.convergeAll ? 2 : 1))
 		{	fprintf(p.fpLog, "%sConverged (%s).\n", p.linePrefix, ossConverged.str().c_str());
 			fflush(p.fpLog); return E;
@@ -23,6 +23,7 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #include <core/VectorField.h>
 #include <core/ScalarFieldArray.h>
 #include <core/Random.h>
+#include <core/TelemetryTimer.h>
 #include <string.h>
 
 //------------------------------ Conversion operators ------------------------------
@@ -128,6 +129,7 @@ complexScalarFieldTilde O(complexScalarFieldTilde&& in) { return in *= in->gInfo
 ScalarField I(ScalarFieldTilde&& in, int nThreads)
 {	//c2r transforms may destroy input, but this input can be destroyed
 	ScalarField out(ScalarFieldData::alloc(in->gInfo, isGpuEnabled()));
+	Telemetry::Timer timer(TelemetryFFT);
 	#ifdef GPU_ENABLED
 	cufftExecZ2D(in->gInfo.planZ2D, (double2*)in->dataGpu(false), out->dataGpu(false));
 	#else
@@ -144,6 +146,7 @@ ScalarField I(const ScalarFieldTilde& in, int nThreads)
 }
 complexScalarField I(const complexScalarFieldTilde& in, int nThreads)
 {	complexScalarField out(complexScalarFieldData::alloc(in->gInfo, isGpuEnabled()));
+	Telemetry::Timer timer(TelemetryFFT);
 	#ifdef GPU_ENABLED
 	cufftExecZ2Z(in->gInfo.planZ2Z, (double2*)in->dataGpu(false), (double2*)out->dataGpu(false), CUFFT_INVERSE);
 	#else
@@ -156,6 +159,7 @@ complexScalarField I(const complexScalarFieldTilde& in, int nThreads)
 }
 complexScalarField I(complexScalarFieldTilde&& in, int nThreads)
 {	//Destructible input (transform in place):
+	Telemetry::Timer timer(TelemetryFFT);
 	#ifdef GPU_ENABLED
 	cufftExecZ2Z(in->gInfo.planZ2Z, (double2*)in->dataGpu(false), (double2*)in->dataGpu(false), CUFFT_INVERSE);
 	#else
@@ -170,6 +174,7 @@ complexScalarField I(complexScalarFieldTilde&& in, int nThreads)
 ScalarFieldTilde Idag(const ScalarField& in, int nThreads)
 {	//r2c transform does not destroy input (no backing up needed)
 	ScalarFieldTilde out(ScalarFieldTildeData::alloc(in->gInfo, isGpuEnabled()));
+	Telemetry::Timer timer(TelemetryFFT);
 	#ifdef GPU_ENABLED
 	cufftExecD2Z(in->gInfo.planD2Z, in->dataGpu(false), (double2*)out->dataGpu(false));
 	#else
@@ -182,6 +187,7 @@ ScalarFieldTilde Idag(const ScalarField& in, int nThreads)
 }
 complexScalarFieldTilde Idag(const complexScalarField& in, int nThreads)
 {	complexScalarFieldTilde out(complexScalarFieldTildeData::alloc(in->gInfo, isGpuEnabled()));
+	Telemetry::Timer timer(TelemetryFFT);
 	#ifdef GPU_ENABLED
 	cufftExecZ2Z(in->gInfo.planZ2Z, (double2*)in->dataGpu(false), (double2*)out->dataGpu(false), CUFFT_FORWARD);
 	#else
@@ -194,6 +200,7 @@ complexScalarFieldTilde Idag(const complexScalarField& in, int nThreads)
 }
 complexScalarFieldTilde Idag(complexScalarField&& in, int nThreads)
 {	//Destructible input (transform in place):
+	Telemetry::Timer timer(TelemetryFFT);
 	#ifdef GPU_ENABLED
 	cufftExecZ2Z(in->gInfo.planZ2Z, (double2*)in->dataGpu(false), (double2*)in->dataGpu(false), CUFFT_FORWARD);
 	#else
@@ -534,9 +541,22 @@ void multiplyBlochPhase(complexScalarField& v, const vector3<>& k)
 
 //------ RadialFunction related operators ------
 
+//Number of G-vectors per batch of radial function evaluations in the loops below
+const size_t radialFunctionBatch = 256;
+
 void radialFunction_sub(size_t iStart, size_t iStop, const vector3<int> S, const matrix3<>& GGT,
 	complex* F, const RadialFunctionG& f, vector3<> r0 )
-{	THREAD_halfGspaceLoop( F[i] = radialFunction_calc(iG, GGT, f, r0); )
+{	double Glength[radialFunctionBatch], fG[radialFunctionBatch];
+	size_t iBatchStart = iStart, nBatch = 0;
+	THREAD_halfGspaceLoop(
+		F[i] = cis(-2*M_PI*dot(iG,r0)); //structure factor (radial part multiplied in batches below)
+		Glength[nBatch++] = sqrt(GGT.metric_length_squared(iG));
+		if(nBatch==radialFunctionBatch || i+1==iStop)
+		{	f.evaluate(nBatch, Glength, fG);
+			for(size_t j=0; j<nBatch; j++) F[iBatchStart+j] *= fG[j];
+			iBatchStart += nBatch; nBatch = 0;
+		}
+	)
 }
 #ifdef GPU_ENABLED
 void radialFunction_gpu(const vector3<int> S, const matrix3<>& GGT,
@@ -571,7 +591,16 @@ void radialFunctionG(const RadialFunctionG& f, RealKernel& Kernel)
 
 void radialFunctionMultiply_sub(size_t iStart, size_t iStop, const vector3<int> S, const matrix3<>& GGT,
 	complex* in, const RadialFunctionG& f)
-{	THREAD_halfGspaceLoop( in[i] *= f(sqrt(GGT.metric_length_squared(iG))); )
+{	double Glength[radialFunctionBatch], fG[radialFunctionBatch];
+	size_t iBatchStart = iStart, nBatch = 0;
+	THREAD_halfGspaceLoop(
+		Glength[nBatch++] = sqrt(GGT.metric_length_squared(iG));
+		if(nBatch==radialFunctionBatch || i+1==iStop)
+		{	f.evaluate(nBatch, Glength, fG);
+			for(size_t j=0; j<nBatch; j++) in[iBatchStart+j] *= fG[j];
+			iBatchStart += nBatch; nBatch = 0;
+		}
+	)
 }
 #ifdef GPU_ENABLED
 void radialFunctionMultiply_gpu(const vector3<int> S, const matrix3<>& GGT, complex* in, const RadialFunctionG& f);
@@ -49,6 +49,9 @@ public:
 	//! Override to synchronize scalars over MPI processes (if the same minimization is happening in sync over many processes)
 	virtual double sync(double x) const { return x; }
 	
+	//! Override to name the stage for telemetry records of each cycle (see Minimizable::telemetryStage)
+	virtual const char* telemetryStage() const { return 0; }
+	
 protected:
 	//----- Interface specification -----
 
@@ -63,6 +66,7 @@ protected:
 	virtual double cycle(double dEprev, std::vector<double>& extraValues)=0;
 	
 	virtual void report(int iter) {} //!< Override to perform optional reporting
+	virtual bool acceptConvergence() { return true; } //!< Override to defer convergence (eg. until an approximation is refined); called once a criterion is met
 	virtual void axpy(double alpha, const Variable& X, Variable& Y) const=0; //!< Scaled accumulate on variable
 	virtual double dot(const Variable& X, const Variable& Y) const=0; //!< Euclidean dot product. Metric applied separately for efficiency.
 	virtual size_t variableSize() const=0; //!< Number of bytes per variable
@@ -73,9 +77,16 @@ protected:
 	virtual void setVariable(const Variable&)=0; //!< Set the state of system to specified variable
 	virtual Variable precondition(const Variable&) const=0; //!< Apply preconditioner to variable/residual
 	virtual Variable applyMetric(const Variable&) const=0; //!< Apply metric to variable/residual
+	
+	double residualNorm; //!< norm of the residual in the most recent cycle (available to report)
+	
+	//! Call from report() or acceptConvergence() when the approximations in cycle() change: the mixing history
+	//! (except the most recent cycle) and the convergence checks are then discarded before the next cycle
+	void restartHistory() { restartPending = true; }
 
 private:
 	const PulayParams& pp; //!< Pulay parameters
+	bool restartPending; //!< whether restartHistory() was called in the current cycle
 	std::vector<Variable> pastVariables; //!< Previous variables
 	std::vector<Variable> pastResiduals; //!< Previous residuals
 	matrix overlap; //!< Overlap matrix of residuals
@@ -110,7 +121,7 @@ public:
 };
 
 template<typename Variable> Pulay<Variable>::Pulay(const PulayParams& pp)
-: pp(pp), overlap(pp.history, pp.history)
+: residualNorm(DBL_MAX), pp(pp), restartPending(false), overlap(pp.history, pp.history)
 {
 }
 
@@ -149,7 +160,6 @@ template<typename Variable> double Pulay<Variable>::minimize(double Eprev, std::
 		for(auto& v: extraValues) v = sync(v);
 			
 		//Calculate and cache residual:
-		double residualNorm = 0.;
 		{	Variable residual = getResidual();
 			pastResiduals.push_back(residual);
 			residualNorm = sync(sqrt(dot(residual,residual)));
@@ -164,6 +174,7 @@ template<typename Variable> double Pulay<Variable>::minimize(double Eprev, std::
 			fprintf(pp.fpLog, "   |%s|: %.3e", extraNames[iExtra].c_str(), extraValues[iExtra]);
 		fprintf(pp.fpLog, "  t[s]: %9.2lf", clock_sec());
 		fprintf(pp.fpLog, "\n"); fflush(pp.fpLog);
+		Telemetry::record(telemetryStage(), iter, E, residualNorm);
 		
 		//Optional reporting:
 		report(iter);
@@ -173,25 +184,33 @@ template<typename Variable> double Pulay<Variable>::minimize(double Eprev, std::
 		{	fprintf(pp.fpLog, "%sE=%le. Stopping ...\n\n", pp.linePrefix, E);
 			return E;
 		}
-		bool converged = false;
-		if(!converged && ediffCheck.checkConvergence(E))
-		{	fprintf(pp.fpLog, "%sConverged (|Delta E|<%le for 2 iters).\n\n", pp.linePrefix, pp.energyDiffThreshold);
-			converged = true;
-		}
-		if(!converged && resCheck.checkConvergence(residualNorm))
-		{	fprintf(pp.fpLog, "%sConverged (|Residual|<%le for 2 iters).\n\n", pp.linePrefix, pp.residualThreshold);
-			converged = true;
-		}
-		if(!converged && extraNames.size())
+		char convergedMsg[256]; convergedMsg[0] = 0; //reason for convergence, if any
+		if(ediffCheck.checkConvergence(E))
+			snprintf(convergedMsg, sizeof(convergedMsg), "|Delta E|<%le for 2 iters", pp.energyDiffThreshold);
+		else if(resCheck.checkConvergence(residualNorm))
+			snprintf(convergedMsg, sizeof(convergedMsg), "|Residual|<%le for 2 iters", pp.residualThreshold);
+		else
 			for(size_t iExtra=0; iExtra<extraNames.size(); iExtra++)
 				if(extraCheck[iExtra]->checkConvergence(extraValues[iExtra]))
-				{	fprintf(pp.fpLog, "%sConverged (|%s|<%le for 2 iters).\n\n", pp.linePrefix, extraNames[iExtra].c_str(), extraThresh[iExtra]);
-					converged = true;
+				{	snprintf(convergedMsg, sizeof(convergedMsg), "|%s|<%le for 2 iters", extraNames[iExtra].c_str(), extraThresh[iExtra]);
 					break;
 				}
+		bool converged = convergedMsg[0] && (not restartPending) && acceptConvergence(); //no convergence in a cycle that restarts history
+		if(converged) fprintf(pp.fpLog, "%sConverged (%s).\n\n", pp.linePrefix, convergedMsg);
 		fflush(pp.fpLog);
 		if(converged || killFlag) break; //converged or manually interrupted
 		
+		//Restart history if requested (energies and residuals of previous cycles are no longer comparable):
+		if(restartPending)
+		{	restartPending = false;
+			pastVariables.erase(pastVariables.begin(), pastVariables.end()-1);
+			pastResiduals.erase(pastResiduals.begin(), pastResiduals.end()-1);
+			ediffCheck = EdiffCheck(2, pp.energyDiffThreshold);
+			resCheck = NormCheck(2, pp.residualThreshold);
+			for(size_t iExtra=0; iExtra<extraNames.size(); iExtra++)
+				extraCheck[iExtra] = std::make_shared<NormCheck>(2, extraThresh[iExtra]);
+		}
+		
 		//---- DIIS/Pulay mixing -----
 			
 		//Update the overlap matrix
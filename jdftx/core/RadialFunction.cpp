@@ -21,6 +21,12 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #include <core/SphericalHarmonics.h>
 #include <core/GpuUtil.h>
 #include <core/Thread.h>
+#include <iomanip>
+#include <deque>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 RadialFunctionG::RadialFunctionG() : dGinv(0), nCoeff(0),
 #ifdef GPU_ENABLED
@@ -51,6 +57,7 @@ void RadialFunctionG::set(const std::vector<double>& coeff, double dGinv)
 {	this->coeff = coeff;
 	this->dGinv = dGinv;
 	nCoeff = coeff.size();
+	coeffInterval = QuinticSpline::getIntervalCoeff(coeff);
 	#ifdef GPU_ENABLED
 	cudaMalloc(&coeffGpu, sizeof(double)*nCoeff);
 	cudaMemcpy(coeffGpu, coeff.data(), sizeof(double)*nCoeff, cudaMemcpyHostToDevice);
@@ -58,6 +65,18 @@ void RadialFunctionG::set(const std::vector<double>& coeff, double dGinv)
 	#endif
 }
 
+void RadialFunctionG::evaluate(size_t n, const double* G, double* result) const
+{	const double xMax = std::max(0, nCoeff-5); //start of zero interval at the end of coeffInterval
+	const double* a = coeffInterval.data();
+	for(size_t i=0; i<n; i++)
+	{	double x = std::min(G[i] * dGinv, xMax);
+		int j = int(x);
+		double t = x - j;
+		const double* aj = a + 6*j;
+		result[i] = aj[0] + t*(aj[1] + t*(aj[2] + t*(aj[3] + t*(aj[4] + t*aj[5]))));
+	}
+}
+
 void RadialFunctionG::updateGmax(int l, int nSamples)
 {	if(!rFunc) return; //don't have the information necessary to update
 	if(nSamples+4 <= nCoeff) return; //already have enough samples
@@ -163,15 +182,128 @@ static void RadialFunction_transform_sub(int iMineStart, int iMineStop, int iGst
 		fTilde[iG] = rFunc->transform(l, iG*dG);
 }
 
+//Hash (64-bit FNV-1a) of the samples and transform parameters, used to key cached transforms:
+static uint64_t transformHash(const RadialFunctionR& rFunc, int l, double dG, int nGrid)
+{	uint64_t hash = 14695981039346656037ULL;
+	auto accumHash = [&hash](const void* data, size_t nBytes)
+	{	const unsigned char* bytes = (const unsigned char*)data;
+		for(size_t i=0; i<nBytes; i++) { hash ^= bytes[i]; hash *= 1099511628211ULL; }
+	};
+	accumHash(&l, sizeof(int));
+	accumHash(&dG, sizeof(double));
+	accumHash(&nGrid, sizeof(int));
+	accumHash(rFunc.r.data(), rFunc.r.size()*sizeof(double));
+	accumHash(rFunc.dr.data(), rFunc.dr.size()*sizeof(double));
+	accumHash(rFunc.f.data(), rFunc.f.size()*sizeof(double));
+	return hash;
+}
+
+//Header of cached transform files, followed by nGrid doubles.
+//Increment version whenever the layout or the transform itself changes, so that stale caches are ignored.
+struct RadialTransformCacheHeader
+{	char magic[8]; //!< JDFTxRFG
+	int32_t version, l, nGrid, reserved;
+	double dG;
+	uint64_t hash; //!< transformHash of samples and parameters (also in filename)
+	
+	static const int32_t currentVersion = 2;
+	
+	RadialTransformCacheHeader(int l, double dG, int nGrid, uint64_t hash)
+	{	memset(this, 0, sizeof(RadialTransformCacheHeader)); //so that headers can be compared bytewise
+		memcpy(magic, "JDFTxRFG", 8);
+		version = currentVersion;
+		this->l = l;
+		this->nGrid = nGrid;
+		this->dG = dG;
+		this->hash = hash;
+	}
+};
+
+//Read a cached transform by memory-mapping the file (shares the page cache between jobs on a node)
+static bool readTransformCache(const char* filename, const RadialTransformCacheHeader& header, std::vector<double>& fTilde)
+{	int fd = open(filename, O_RDONLY);
+	if(fd < 0) return false;
+	size_t nBytes = sizeof(RadialTransformCacheHeader) + sizeof(double)*fTilde.size();
+	struct stat st;
+	bool ok = (fstat(fd, &st)==0) && (size_t(st.st_size)==nBytes);
+	if(ok)
+	{	void* data = mmap(0, nBytes, PROT_READ, MAP_SHARED, fd, 0);
+		ok = (data != MAP_FAILED);
+		if(ok)
+		{	ok = !memcmp(data, &header, sizeof(RadialTransformCacheHeader));
+			if(ok) memcpy(fTilde.data(), (const char*)data + sizeof(RadialTransformCacheHeader), sizeof(double)*fTilde.size());
+			munmap(data, nBytes);
+		}
+	}
+	close(fd);
+	return ok;
+}
+
+//Write a transform to cache (via a process-specific temporary file, renamed atomically for concurrent jobs)
+static void writeTransformCache(const string& filename, const RadialTransformCacheHeader& header, const std::vector<double>& fTilde)
+{	string tmpFilename = filename + ".tmp" + std::to_string(getpid()).c_str();
+	FILE* fp = fopen(tmpFilename.c_str(), "wb");
+	if(!fp) return; //cache is optional: silently skip if directory is not writable
+	bool ok = fwrite(&header, sizeof(RadialTransformCacheHeader), 1, fp)==1
+		&& fwrite(fTilde.data(), sizeof(double), fTilde.size(), fp)==fTilde.size();
+	ok &= (fclose(fp)==0);
+	if(!(ok && rename(tmpFilename.c_str(), filename.c_str())==0))
+		unlink(tmpFilename.c_str());
+}
+
 // Initialize a uniform G radial function from the log-grid function
-void RadialFunctionR::transform(int l, double dG, int nGrid, RadialFunctionG& func) const
+void RadialFunctionR::transform(int l, double dG, int nGrid, RadialFunctionG& func, const char* cacheDir) const
 {	static StopWatch watch("RadialFunctionR::transform"); watch.start();
+	//In batch mode, reuse transforms from previous calculations in this process:
+	static std::map<uint64_t, std::vector<double> > memo;
+	static std::deque<uint64_t> memoOrder; //hashes in memo, most recent first
+	static std::mutex memoLock;
+	uint64_t hash = (batchMode || (cacheDir && *cacheDir)) ? transformHash(*this, l, dG, nGrid) : 0;
+	if(batchMode)
+	{	std::lock_guard<std::mutex> lock(memoLock);
+		auto iter = memo.find(hash);
+		if(iter != memo.end() && iter->second.size()==size_t(nGrid))
+		{	func.free(this!=func.rFunc);
+			func.init(l, iter->second, dG);
+			if(this!=func.rFunc) func.rFunc = new RadialFunctionR(*this);
+			watch.stop();
+			return;
+		}
+	}
+	//Check cache (if any):
 	std::vector<double> fTilde(nGrid, 0.);
-	int iGstart, iGstop; TaskDivision(nGrid, mpiWorld).myRange(iGstart, iGstop);
-	int nGridMine = iGstop-iGstart;
-	if(nGridMine)
-		threadLaunch(RadialFunction_transform_sub, nGridMine, iGstart, l, dG, this, fTilde.data());
-	mpiWorld->allReduceData(fTilde, MPIUtil::ReduceSum);
+	bool useCache = (cacheDir && *cacheDir);
+	bool cached = false;
+	string cacheFilename;
+	if(useCache)
+	{	ostringstream oss;
+		oss << cacheDir << "/radial-" << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+		cacheFilename = oss.str().c_str();
+		if(mpiWorld->isHead())
+			cached = readTransformCache(cacheFilename.c_str(), RadialTransformCacheHeader(l, dG, nGrid, hash), fTilde);
+		mpiWorld->bcast(&cached, 1);
+		if(cached) mpiWorld->bcastData(fTilde);
+	}
+	//Compute transform if not cached:
+	if(!cached)
+	{	int iGstart, iGstop; TaskDivision(nGrid, mpiWorld).myRange(iGstart, iGstop);
+		int nGridMine = iGstop-iGstart;
+		if(nGridMine)
+			threadLaunch(RadialFunction_transform_sub, nGridMine, iGstart, l, dG, this, fTilde.data());
+		mpiWorld->allReduceData(fTilde, MPIUtil::ReduceSum);
+		if(useCache && mpiWorld->isHead())
+			writeTransformCache(cacheFilename, RadialTransformCacheHeader(l, dG, nGrid, hash), fTilde);
+	}
+	if(batchMode)
+	{	const size_t nMemoMax = 256; //limit memory usage: only most recent transforms retained (enough for several species)
+		std::lock_guard<std::mutex> lock(memoLock);
+		if(!memo.count(hash)) memoOrder.push_front(hash);
+		memo[hash] = fTilde;
+		if(memoOrder.size() > nMemoMax)
+		{	memo.erase(memoOrder.back());
+			memoOrder.pop_back();
+		}
+	}
 	func.free(this!=func.rFunc);
 	func.init(l, fTilde, dG);
 	if(this!=func.rFunc) func.rFunc = new RadialFunctionR(*this);
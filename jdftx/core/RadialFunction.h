@@ -34,6 +34,7 @@ struct RadialFunctionG
 	double dGinv; //!< inverse sample spacing
 	int nCoeff; //!< number of coefficients
 	std::vector<double> coeff; //!< coefficients on cpu
+	std::vector<double> coeffInterval; //!< compact per-interval power-series table (see QuinticSpline::getIntervalCoeff) for batched evaluation on cpu
 	#ifdef GPU_ENABLED
 	double* coeffGpu; //!< coefficients on gpu
 	const double* coeffPref() const { return coeffGpu; }
@@ -70,6 +71,10 @@ struct RadialFunctionG
 		else return QuinticSpline::deriv(getCoeff(), Gindex) * dGinv;
 	}
 	
+	//! Batched evaluation (on cpu) of operator() at n values of G, using the compact per-interval table.
+	//! The loop is branch-free so that it vectorizes (with gathers from the table on AVX2 / AVX-512 targets).
+	void evaluate(size_t n, const double* G, double* result) const;
+	
 	RadialFunctionR* rFunc; //!< copy of the real-space radial version (if created from one)
 	
 	#ifndef __in_a_cu_file__
@@ -127,7 +132,10 @@ struct RadialFunctionR
 	
 	//! Initialize a uniform G radial function from the logPrintf grid function according to
 	//! @$ func(G) = \int dr 4\pi r^2 j_l(G r) f(r) @$
-	void transform(int l, double dG, int nGrid, RadialFunctionG& func) const;
+	//! If cacheDir is non-null, reuse transforms saved there by previous runs (keyed by a hash of the samples and grid parameters).
+	//! Cache files carry a versioned header, are memory-mapped on load and are renamed into place atomically,
+	//! so that the directory can be shared by concurrent jobs.
+	void transform(int l, double dG, int nGrid, RadialFunctionG& func, const char* cacheDir=0) const;
 };
 
 //! @}
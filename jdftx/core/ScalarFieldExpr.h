@@ -0,0 +1,190 @@
+/*-------------------------------------------------------------------
+Copyright 2026 Ravishankar Sundararaman
+
+This file is part of JDFTx.
+
+JDFTx is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+JDFTx is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------*/
+
+#ifndef JDFTX_CORE_SCALARFIELDEXPR_H
+#define JDFTX_CORE_SCALARFIELDEXPR_H
+
+//! @addtogroup Operators
+//! @{
+
+/** @file ScalarFieldExpr.h
+@brief Lazily-evaluated elementwise expressions of real-space scalar fields
+
+The ScalarField operators in Operators.h each allocate and stream a full grid.
+Wrapping one or more operands with lazy() instead builds an expression object,
+using the same operator syntax, that is evaluated in a single threaded pass
+without intermediates when it is converted to a ScalarField. For example:
+@code
+ScalarField out = a * exp(lazy(b)) * c + d;  //one pass over the grid, one allocation
+@endcode
+Binary operators involving at least one expression (and ScalarField's or doubles)
+produce expressions, so only one operand in each chain needs to be wrapped.
+In GPU builds, expressions are evaluated using the regular (unfused) operators.
+*/
+
+#include <core/Operators.h>
+#include <core/Thread.h>
+
+//! Base class of all elementwise scalar field expressions (CRTP)
+template<typename E> struct ScalarFieldExpr
+{	const E& self() const { return static_cast<const E&>(*this); }
+	operator ScalarField() const; //!< evaluate expression into a new ScalarField
+};
+
+//! Leaf of an expression: a scalar field with its pending scale factor
+struct ScalarFieldExprLeaf : public ScalarFieldExpr<ScalarFieldExprLeaf>
+{	ScalarField X;
+	#ifndef GPU_ENABLED
+	const double* Xdata; double Xscale;
+	#endif
+	ScalarFieldExprLeaf(const ScalarField& X) : X(X)
+	{	assert(X);
+		#ifndef GPU_ENABLED
+		Xdata = X->data(false);
+		Xscale = X->scale;
+		#endif
+	}
+	const GridInfo* gInfo() const { return &X->gInfo; }
+	#ifndef GPU_ENABLED
+	double operator[](size_t i) const { return Xscale * Xdata[i]; }
+	#endif
+	const ScalarField& unfused() const { return X; }
+};
+
+//! Scalar constant within an expression
+struct ScalarFieldExprConst : public ScalarFieldExpr<ScalarFieldExprConst>
+{	double c;
+	ScalarFieldExprConst(double c) : c(c) {}
+	const GridInfo* gInfo() const { return 0; }
+	double operator[](size_t i) const { return c; }
+	double unfused() const { return c; }
+};
+
+//! Elementwise unary operation on an expression
+template<typename Op, typename A> struct ScalarFieldExprUnary : public ScalarFieldExpr<ScalarFieldExprUnary<Op,A>>
+{	Op op; A a;
+	ScalarFieldExprUnary(const Op& op, const A& a) : op(op), a(a) {}
+	const GridInfo* gInfo() const { return a.gInfo(); }
+	double operator[](size_t i) const { return op(a[i]); }
+	ScalarField unfused() const { return op.apply(a.unfused()); }
+};
+
+//! Elementwise binary operation on expressions
+template<typename Op, typename A, typename B> struct ScalarFieldExprBinary : public ScalarFieldExpr<ScalarFieldExprBinary<Op,A,B>>
+{	A a; B b;
+	ScalarFieldExprBinary(const A& a, const B& b) : a(a), b(b) {}
+	const GridInfo* gInfo() const { const GridInfo* g = a.gInfo(); return g ? g : b.gInfo(); }
+	double operator[](size_t i) const { return Op()(a[i], b[i]); }
+	ScalarField unfused() const { return Op::apply(a.unfused(), b.unfused()); }
+};
+
+//! Start a lazily-evaluated expression from a scalar field
+inline ScalarFieldExprLeaf lazy(const ScalarField& X) { return ScalarFieldExprLeaf(X); }
+
+//! Evaluate an expression into a new ScalarField in a single threaded pass
+template<typename E> ScalarField evaluate(const ScalarFieldExpr<E>& expr);
+
+//! @cond
+namespace ScalarFieldExprOps
+{
+	//Elementwise operations: operator() for the fused CPU pass and apply() via the regular operators for GPU
+	struct Add
+	{	double operator()(double a, double b) const { return a + b; }
+		template<typename A, typename B> static ScalarField apply(const A& a, const B& b) { return a + b; }
+	};
+	struct Sub
+	{	double operator()(double a, double b) const { return a - b; }
+		template<typename A, typename B> static ScalarField apply(const A& a, const B& b) { return a - b; }
+	};
+	struct Mul
+	{	double operator()(double a, double b) const { return a * b; }
+		template<typename A, typename B> static ScalarField apply(const A& a, const B& b) { return a * b; }
+	};
+	struct Div
+	{	double operator()(double a, double b) const { return a / b; }
+		template<typename A> static ScalarField apply(const A& a, const ScalarField& b) { return a * inv(b); }
+		static ScalarField apply(const ScalarField& a, double b) { return (1./b) * a; }
+	};
+	struct Neg { double operator()(double a) const { return -a; } ScalarField apply(const ScalarField& a) const { return -1. * a; } };
+	struct Exp { double operator()(double a) const { return ::exp(a); } ScalarField apply(const ScalarField& a) const { return ::exp(a); } };
+	struct Log { double operator()(double a) const { return ::log(a); } ScalarField apply(const ScalarField& a) const { return ::log(a); } };
+	struct Sqrt { double operator()(double a) const { return ::sqrt(a); } ScalarField apply(const ScalarField& a) const { return ::sqrt(a); } };
+	struct Inv { double operator()(double a) const { return 1./a; } ScalarField apply(const ScalarField& a) const { return ::inv(a); } };
+	struct Pow
+	{	double alpha;
+		double operator()(double a) const { return ::pow(a, alpha); }
+		ScalarField apply(const ScalarField& a) const { return ::pow(a, alpha); }
+	};
+
+	template<typename E> void evaluate_sub(size_t iStart, size_t iStop, const E* expr, double* out)
+	{	for(size_t i=iStart; i<iStop; i++) out[i] = (*expr)[i];
+	}
+}
+
+//Binary operators with at least one expression operand:
+#define SCALARFIELDEXPR_BINARY(op, Op) \
+	template<typename A, typename B> ScalarFieldExprBinary<ScalarFieldExprOps::Op,A,B> \
+		operator op(const ScalarFieldExpr<A>& a, const ScalarFieldExpr<B>& b) { return ScalarFieldExprBinary<ScalarFieldExprOps::Op,A,B>(a.self(), b.self()); } \
+	template<typename A> ScalarFieldExprBinary<ScalarFieldExprOps::Op,A,ScalarFieldExprLeaf> \
+		operator op(const ScalarFieldExpr<A>& a, const ScalarField& b) { return ScalarFieldExprBinary<ScalarFieldExprOps::Op,A,ScalarFieldExprLeaf>(a.self(), b); } \
+	template<typename B> ScalarFieldExprBinary<ScalarFieldExprOps::Op,ScalarFieldExprLeaf,B> \
+		operator op(const ScalarField& a, const ScalarFieldExpr<B>& b) { return ScalarFieldExprBinary<ScalarFieldExprOps::Op,ScalarFieldExprLeaf,B>(a, b.self()); } \
+	template<typename A> ScalarFieldExprBinary<ScalarFieldExprOps::Op,A,ScalarFieldExprConst> \
+		operator op(const ScalarFieldExpr<A>& a, double b) { return ScalarFieldExprBinary<ScalarFieldExprOps::Op,A,ScalarFieldExprConst>(a.self(), b); } \
+	template<typename B> ScalarFieldExprBinary<ScalarFieldExprOps::Op,ScalarFieldExprConst,B> \
+		operator op(double a, const ScalarFieldExpr<B>& b) { return ScalarFieldExprBinary<ScalarFieldExprOps::Op,ScalarFieldExprConst,B>(a, b.self()); }
+SCALARFIELDEXPR_BINARY(+, Add)
+SCALARFIELDEXPR_BINARY(-, Sub)
+SCALARFIELDEXPR_BINARY(*, Mul)
+SCALARFIELDEXPR_BINARY(/, Div)
+#undef SCALARFIELDEXPR_BINARY
+
+//Unary functions of expressions:
+#define SCALARFIELDEXPR_UNARY(func, Op) \
+	template<typename A> ScalarFieldExprUnary<ScalarFieldExprOps::Op,A> func(const ScalarFieldExpr<A>& a) \
+	{	return ScalarFieldExprUnary<ScalarFieldExprOps::Op,A>(ScalarFieldExprOps::Op(), a.self()); \
+	}
+SCALARFIELDEXPR_UNARY(operator-, Neg)
+SCALARFIELDEXPR_UNARY(exp, Exp)
+SCALARFIELDEXPR_UNARY(log, Log)
+SCALARFIELDEXPR_UNARY(sqrt, Sqrt)
+SCALARFIELDEXPR_UNARY(inv, Inv)
+#undef SCALARFIELDEXPR_UNARY
+template<typename A> ScalarFieldExprUnary<ScalarFieldExprOps::Pow,A> pow(const ScalarFieldExpr<A>& a, double alpha)
+{	ScalarFieldExprOps::Pow op; op.alpha = alpha;
+	return ScalarFieldExprUnary<ScalarFieldExprOps::Pow,A>(op, a.self());
+}
+
+template<typename E> ScalarField evaluate(const ScalarFieldExpr<E>& expr)
+{	const GridInfo* gInfo = expr.self().gInfo();
+	assert(gInfo);
+	#ifdef GPU_ENABLED
+	return expr.self().unfused();
+	#else
+	ScalarField out(ScalarFieldData::alloc(*gInfo));
+	threadLaunch(ScalarFieldExprOps::evaluate_sub<E>, gInfo->nr, &expr.self(), out->data(false));
+	return out;
+	#endif
+}
+
+template<typename E> ScalarFieldExpr<E>::operator ScalarField() const { return evaluate(*this); }
+//! @endcond
+
+//! @}
+#endif // JDFTX_CORE_SCALARFIELDEXPR_H
@@ -21,8 +21,14 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #include <core/GridInfo.h>
 #include <core/Operators.h>
 #include <core/WignerSeitz.h>
+#include <core/Thread.h>
 #include <string.h>
 #include <algorithm>
+#include <iomanip>
+#include <cstdint>
+#ifdef ZLIB_ENABLED
+#include <zlib.h>
+#endif
 
 
 void saveDX(const ScalarField& X, const char* filenamePrefix)
@@ -227,3 +233,258 @@ void saveSphericalized(const ScalarFieldTilde* dataG, int nColumns, const char*
 	delete[] mean;
 	delete[] weight;
 }
+
+
+//------------ Self-describing scalar field format ------------
+
+static const char* fieldMagic = "JDFTx-field 1";
+static EnumStringMap<FieldCodec> fieldCodecNames
+(	FieldCodecRaw, "raw",
+	FieldCodecLossless, "lossless",
+	FieldCodecLossy, "lossy"
+);
+
+//Encode n values starting at x into out:
+void encodeFieldChunk(const double* x, size_t n, const FieldFormat& format, string& out)
+{	std::vector<double> xLE(x, x+n);
+	convertToLE(xLE.data(), sizeof(double), n); //all encodings operate on little-endian bytes
+	const unsigned char* bytes = (const unsigned char*)xLE.data();
+	switch(format.codec)
+	{	case FieldCodecRaw:
+		{	out.assign((const char*)bytes, n*sizeof(double));
+			break;
+		}
+		case FieldCodecLossless:
+		{
+			#ifdef ZLIB_ENABLED
+			//Shuffle bytes, so that sign/exponent and leading mantissa bytes are contiguous:
+			std::vector<unsigned char> shuffled(n*sizeof(double));
+			for(size_t i=0; i<n; i++)
+				for(size_t b=0; b<sizeof(double); b++)
+					shuffled[b*n+i] = bytes[i*sizeof(double)+b];
+			uLongf outLen = compressBound(shuffled.size());
+			out.resize(outLen);
+			if(compress2((Bytef*)&out[0], &outLen, shuffled.data(), shuffled.size(), Z_DEFAULT_COMPRESSION) != Z_OK)
+				die_alone("Error compressing scalar field chunk.\n");
+			out.resize(outLen);
+			#endif
+			break;
+		}
+		case FieldCodecLossy:
+		{	//Quantize to multiples of 2*errorBound, and varint-encode zigzag differences between successive values:
+			const double invStep = 0.5/format.errorBound;
+			out.clear(); out.reserve(2*n);
+			int64_t qPrev = 0;
+			for(size_t i=0; i<n; i++)
+			{	double qReal = x[i] * invStep;
+				if(!(fabs(qReal) < 4e18)) die_alone("Value %lg cannot be quantized with error bound %lg.\n", x[i], format.errorBound);
+				int64_t q = llround(qReal);
+				int64_t d = q - qPrev; qPrev = q;
+				uint64_t z = (uint64_t(d) << 1) ^ uint64_t(d >> 63); //zigzag: small magnitudes of either sign -> small unsigned
+				while(z >= 0x80) { out.push_back(char((z & 0x7F) | 0x80)); z >>= 7; }
+				out.push_back(char(z));
+			}
+			break;
+		}
+	}
+}
+
+//Decode n values from in (of length inLen) to x:
+void decodeFieldChunk(const char* in, size_t inLen, const FieldHeader& header, double* x, size_t n)
+{	switch(header.codec)
+	{	case FieldCodecRaw:
+		{	if(inLen != n*sizeof(double)) die_alone("Scalar field chunk has %lu bytes instead of %lu.\n", inLen, n*sizeof(double));
+			memcpy(x, in, inLen);
+			convertFromLE(x, sizeof(double), n);
+			break;
+		}
+		case FieldCodecLossless:
+		{
+			#ifdef ZLIB_ENABLED
+			std::vector<unsigned char> shuffled(n*sizeof(double));
+			uLongf outLen = shuffled.size();
+			if(uncompress(shuffled.data(), &outLen, (const Bytef*)in, inLen) != Z_OK or outLen != shuffled.size())
+				die_alone("Error decompressing scalar field chunk.\n");
+			unsigned char* bytes = (unsigned char*)x;
+			for(size_t i=0; i<n; i++)
+				for(size_t b=0; b<sizeof(double); b++)
+					bytes[i*sizeof(double)+b] = shuffled[b*n+i];
+			convertFromLE(x, sizeof(double), n);
+			#endif
+			break;
+		}
+		case FieldCodecLossy:
+		{	const double step = 2.*header.errorBound;
+			const unsigned char* ptr = (const unsigned char*)in;
+			const unsigned char* ptrEnd = ptr + inLen;
+			int64_t q = 0;
+			for(size_t i=0; i<n; i++)
+			{	uint64_t z = 0; int shift = 0;
+				while(true)
+				{	if(ptr == ptrEnd or shift > 63) die_alone("Corrupt lossy scalar field chunk.\n");
+					unsigned char c = *(ptr++);
+					z |= uint64_t(c & 0x7F) << shift;
+					if(!(c & 0x80)) break;
+					shift += 7;
+				}
+				q += int64_t(z >> 1) ^ -int64_t(z & 1);
+				x[i] = q * step;
+			}
+			break;
+		}
+	}
+}
+
+void encodeFieldChunks_sub(size_t iStart, size_t iStop, size_t chunkStart, const double* data, size_t chunkLen, size_t nTot,
+	const FieldFormat* format, std::vector<string>* encoded)
+{	for(size_t i=iStart; i<iStop; i++)
+	{	size_t offset = (chunkStart+i) * chunkLen;
+		encodeFieldChunk(data+offset, std::min(chunkLen, nTot-offset), *format, encoded->at(i));
+	}
+}
+
+void decodeFieldChunks_sub(size_t iStart, size_t iStop, const char* in, const std::vector<size_t>* inOffsets,
+	const FieldHeader* header, double* data, size_t chunkLen, size_t nTot)
+{	for(size_t i=iStart; i<iStop; i++)
+	{	size_t offset = i * chunkLen;
+		decodeFieldChunk(in + inOffsets->at(i), header->chunkBytes[i], *header, data+offset, std::min(chunkLen, nTot-offset));
+	}
+}
+
+void saveField(const ScalarField& X, const char* filename, const FieldFormat& format, string name, string spin, string units)
+{	static StopWatch watch("saveField"); watch.start();
+	#ifndef ZLIB_ENABLED
+	if(format.codec == FieldCodecLossless)
+		die("Lossless scalar field compression requires zlib (reconfigure with -D EnableZlib=yes).\n");
+	#endif
+	if(format.codec == FieldCodecLossy and !(format.errorBound > 0.))
+		die("Lossy scalar field compression requires a positive error bound.\n");
+	const GridInfo& g = X->gInfo;
+	int chunkPlanes = std::max(1, std::min(format.chunkPlanes, g.S[0]));
+	size_t chunkLen = size_t(chunkPlanes) * g.S[1] * g.S[2];
+	size_t nChunks = (g.S[0] + chunkPlanes - 1) / chunkPlanes;
+	
+	//Encode chunks of this process:
+	TaskDivision chunkDiv(nChunks, mpiWorld);
+	size_t chunkStart, chunkStop; chunkDiv.myRange(chunkStart, chunkStop);
+	std::vector<string> encoded(chunkStop-chunkStart);
+	threadLaunch(encodeFieldChunks_sub, encoded.size(), chunkStart, X->data(), chunkLen, size_t(g.nr), &format, &encoded);
+	
+	//Collect sizes and determine offsets:
+	std::vector<size_t> chunkBytes(nChunks, 0);
+	for(size_t i=chunkStart; i<chunkStop; i++) chunkBytes[i] = encoded[i-chunkStart].size();
+	mpiWorld->allReduceData(chunkBytes, MPIUtil::ReduceSum);
+	ostringstream oss;
+	oss << fieldMagic << '\n'
+		<< "S " << g.S[0] << ' ' << g.S[1] << ' ' << g.S[2] << '\n'
+		<< "R" << std::scientific << std::setprecision(15);
+	for(int i=0; i<3; i++)
+		for(int j=0; j<3; j++)
+			oss << ' ' << g.R(i,j);
+	oss << "\nname " << name << "\nspin " << spin << "\nunits " << (units.length() ? units : "none")
+		<< "\ncodec " << fieldCodecNames.getString(format.codec)
+		<< "\nerrorBound " << (format.codec==FieldCodecLossy ? format.errorBound : 0.)
+		<< "\nchunks " << nChunks << ' ' << chunkPlanes << "\nend\n";
+	string headerStr = oss.str();
+	std::vector<size_t> chunkOffsets(nChunks);
+	size_t offset = headerStr.length() + nChunks*sizeof(uint64_t);
+	for(size_t i=0; i<nChunks; i++)
+	{	chunkOffsets[i] = offset;
+		offset += chunkBytes[i];
+	}
+	
+	//Write header from head, and chunks from their owners:
+	MPIUtil::File fp; mpiWorld->fopenWrite(fp, filename);
+	if(mpiWorld->isHead())
+	{	mpiWorld->fwrite(headerStr.data(), 1, headerStr.length(), fp);
+		std::vector<uint64_t> chunkBytes64(chunkBytes.begin(), chunkBytes.end());
+		mpiWorld->fwriteData(chunkBytes64, fp);
+	}
+	for(size_t i=chunkStart; i<chunkStop; i++)
+	{	const string& chunk = encoded[i-chunkStart];
+		mpiWorld->fseek(fp, chunkOffsets[i], SEEK_SET);
+		mpiWorld->fwrite(chunk.data(), 1, chunk.length(), fp);
+	}
+	mpiWorld->fclose(fp);
+	watch.stop();
+}
+
+bool readFieldHeader(const char* filename, FieldHeader* header)
+{	FILE* fp = fopen(filename, "rb");
+	if(!fp) die_alone("Could not open '%s' for reading.\n", filename);
+	//Check magic line:
+	const size_t magicLen = strlen(fieldMagic);
+	string magic(magicLen+1, 0);
+	bool isField = (fread(&magic[0], 1, magicLen+1, fp) == magicLen+1)
+		and (magic == string(fieldMagic)+'\n');
+	if(!(isField and header)) { fclose(fp); return isField; }
+	//Parse header lines:
+	FieldHeader& h = *header;
+	h.codec = FieldCodecRaw; h.errorBound = 0.; h.chunkPlanes = 0;
+	size_t nChunks = 0;
+	char buf[1024];
+	while(fgets(buf, sizeof(buf), fp))
+	{	istringstream iss(buf);
+		string key; iss >> key;
+		if(key == "end") break;
+		else if(key == "S") iss >> h.S[0] >> h.S[1] >> h.S[2];
+		else if(key == "R") { for(int i=0; i<3; i++) for(int j=0; j<3; j++) iss >> h.R(i,j); }
+		else if(key == "name") iss >> h.name;
+		else if(key == "spin") iss >> h.spin;
+		else if(key == "units") { iss >> h.units; if(h.units == "none") h.units.clear(); }
+		else if(key == "codec")
+		{	string codecName; iss >> codecName;
+			if(!fieldCodecNames.getEnum(codecName.c_str(), h.codec))
+				die_alone("Unknown codec '%s' in scalar field file '%s'.\n", codecName.c_str(), filename);
+		}
+		else if(key == "errorBound") iss >> h.errorBound;
+		else if(key == "chunks") iss >> nChunks >> h.chunkPlanes;
+		//ignore unknown keys (for forward compatibility)
+	}
+	if(!nChunks or h.chunkPlanes<=0) die_alone("Invalid header in scalar field file '%s'.\n", filename);
+	std::vector<uint64_t> chunkBytes64(nChunks);
+	if(freadLE(chunkBytes64.data(), sizeof(uint64_t), nChunks, fp) != nChunks)
+		die_alone("Failed to read chunk table of scalar field file '%s'.\n", filename);
+	h.chunkBytes.assign(chunkBytes64.begin(), chunkBytes64.end());
+	h.dataOffset = ftell(fp);
+	fclose(fp);
+	#ifndef ZLIB_ENABLED
+	if(h.codec == FieldCodecLossless)
+		die_alone("Reading losslessly compressed scalar field '%s' requires zlib (reconfigure with -D EnableZlib=yes).\n", filename);
+	#endif
+	return true;
+}
+
+void loadField(ScalarField& X, const char* filename)
+{	FieldHeader header;
+	if(!readFieldHeader(filename, &header))
+	{	loadRawBinary(X, filename); //legacy format
+		return;
+	}
+	static StopWatch watch("loadField"); watch.start();
+	const GridInfo& g = X->gInfo;
+	if(!(header.S == g.S))
+		die_alone("\nGrid dimensions %d x %d x %d in '%s' do not match expected %d x %d x %d.\n"
+			"Hint: Are you really reading the correct file?\n\n",
+			header.S[0], header.S[1], header.S[2], filename, g.S[0], g.S[1], g.S[2]);
+	size_t chunkLen = size_t(header.chunkPlanes) * g.S[1] * g.S[2];
+	size_t nChunks = header.chunkBytes.size();
+	if(nChunks != (g.S[0] + header.chunkPlanes - 1) / size_t(header.chunkPlanes))
+		die_alone("Inconsistent chunk table in scalar field file '%s'.\n", filename);
+	//Read all chunks:
+	std::vector<size_t> inOffsets(nChunks);
+	size_t inLen = 0;
+	for(size_t i=0; i<nChunks; i++)
+	{	inOffsets[i] = inLen;
+		inLen += header.chunkBytes[i];
+	}
+	string in(inLen, 0);
+	FILE* fp = fopen(filename, "rb");
+	fseek(fp, header.dataOffset, SEEK_SET);
+	if(fread(&in[0], 1, inLen, fp) != inLen)
+		die_alone("Read failed for scalar field file '%s'.\n", filename);
+	fclose(fp);
+	//Decode in parallel:
+	threadLaunch(decodeFieldChunks_sub, nChunks, in.data(), &inOffsets, &header, X->data(), chunkLen, size_t(g.nr));
+	watch.stop();
+}
@@ -28,6 +28,8 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #include <core/ScalarField.h>
 #include <core/vector3.h>
 #include <core/Util.h>
+#include <core/matrix3.h>
+#include <core/string.h>
 
 #define Tptr std::shared_ptr<T>
 
@@ -68,6 +70,56 @@ template<typename T> void loadRawBinary(Tptr& X, const char* filename)
 
 #undef Tptr
 
+//! Data encodings for the self-describing scalar field format (see saveField)
+enum FieldCodec
+{	FieldCodecRaw, //!< uncompressed little-endian doubles
+	FieldCodecLossless, //!< byte-shuffled doubles compressed with deflate (requires zlib)
+	FieldCodecLossy //!< values quantized within an absolute error bound, delta-coded along the contiguous dimension and packed as variable-length integers
+};
+
+//! Options for writing scalar fields in the self-describing format
+struct FieldFormat
+{	FieldCodec codec;
+	double errorBound; //!< maximum absolute error of any grid point value (FieldCodecLossy only)
+	int chunkPlanes; //!< number of planes along the first grid dimension per chunk (the unit of compression and parallel output)
+	FieldFormat() : codec(FieldCodecLossless), errorBound(1e-6), chunkPlanes(4) {}
+};
+
+//! Contents of the header of a self-describing scalar field file
+struct FieldHeader
+{	vector3<int> S; //!< grid dimensions
+	matrix3<> R; //!< lattice vectors in columns (bohrs)
+	string name; //!< variable name
+	string spin; //!< spin channel: none, up, dn, re or im
+	string units; //!< units of the data values (empty if dimensionless)
+	FieldCodec codec; //!< encoding of chunks
+	double errorBound; //!< absolute error bound (FieldCodecLossy only)
+	int chunkPlanes; //!< number of planes per chunk (along the first grid dimension)
+	std::vector<size_t> chunkBytes; //!< encoded size of each chunk
+	size_t dataOffset; //!< byte offset of first chunk in file
+};
+
+/** Save scalar field in the self-describing format: a text header with the grid, lattice vectors,
+variable name, spin channel, units and encoding, followed by a table of chunk sizes and independently
+encoded chunks of planes along the first grid dimension. This is a collective call over mpiWorld:
+chunks are divided over processes, encoded in parallel (using threads within each process)
+and written to the file at their final offsets concurrently.
+@param X The scalar field to save
+@param filename Output filename
+@param format Encoding and chunking options
+@param name Variable name recorded in the header
+@param spin Spin channel recorded in the header (none, up, dn, re or im)
+@param units Units of the data recorded in the header
+*/
+void saveField(const ScalarField& X, const char* filename, const FieldFormat& format, string name, string spin="none", string units="");
+
+//! Check whether filename is in the self-describing format, and if so, read its header (if header is non-null)
+bool readFieldHeader(const char* filename, FieldHeader* header=0);
+
+//! Load scalar field from either the self-describing format or legacy raw binary, detected automatically.
+//! X must be allocated on a grid matching the data. (Not collective: each process reads independently, as in loadRawBinary.)
+void loadField(ScalarField& X, const char* filename);
+
 /** Save data to a raw binary along with a DataExplorer header
 @param filenamePrefix Binary data is saved to filenamePrefix.bin with DataExplorer header filenamePrefix.dx
 */
@@ -18,6 +18,7 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 -------------------------------------------------------------------*/
 
 #include <core/Spline.h>
+#include <algorithm>
 
 namespace QuinticSpline
 {
@@ -75,4 +76,24 @@ namespace QuinticSpline
 		coeff.push_back(extrap[1][0]*x[N-3] + extrap[1][1]*x[N-2] + extrap[1][2]*x[N-1]);
 		return coeff;
 	}
+	
+	std::vector<double> getIntervalCoeff(const std::vector<double>& coeff)
+	{	int nIntervals = std::max(0, int(coeff.size())-5);
+		std::vector<double> a(6*(nIntervals+1), 0.); //includes a zero interval at the end
+		for(int j=0; j<nIntervals; j++)
+		{	double tR, tL, b[6]; getBernsteinCoeffs(coeff.data(), j, tR, tL, b);
+			//Convert Bernstein to power basis: a_k = binom(5,k) sum_i (-1)^(k-i) binom(k,i) b_i
+			const int binom5[6] = { 1, 5, 10, 10, 5, 1 };
+			double* aj = a.data() + 6*j;
+			for(int k=0; k<6; k++)
+			{	double sum = 0., binomKi = 1.; //binom(k,i) updated as i increases
+				for(int i=0; i<=k; i++)
+				{	sum += ((k-i)%2 ? -binomKi : binomKi) * b[i];
+					binomKi = (binomKi * (k-i)) / (i+1);
+				}
+				aj[k] = binom5[k] * sum;
+			}
+		}
+		return a;
+	}
 }
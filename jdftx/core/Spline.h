@@ -37,6 +37,12 @@ namespace QuinticSpline
 	//! Natural boundary conditions (third and fourth derivatives zero) are imposed on the last sample.
 	std::vector<double> getCoeff(const std::vector<double>& samples, bool oddExtension=false);
 	
+	//! @brief Convert blip coefficients to a compact table of power-series coefficients for each interval.
+	//! Entry 6*j+i is the coefficient of t^i in interval j, where x = j + t; a final interval of zeros
+	//! is appended, so that the table covers x in [0, nCoeff-4) and evaluates to zero in its last interval.
+	//! @param coeff coefficient array generated by getCoeff
+	std::vector<double> getIntervalCoeff(const std::vector<double>& coeff);
+	
 	//! @brief Compute value of quintic spline.
 	//! Warning: x is not range-checked
 	//! @param coeff pointer to coefficient array generated by getCoeff
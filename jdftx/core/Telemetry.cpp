@@ -0,0 +1,213 @@
+/*-------------------------------------------------------------------
+Copyright 2026 Ravishankar Sundararaman
+
+This file is part of JDFTx.
+
+JDFTx is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+JDFTx is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------*/
+
+#include <core/Telemetry.h>
+#include <core/Util.h>
+#include <core/Thread.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <cmath>
+
+namespace Telemetry
+{
+	bool enabled = false;
+	static std::atomic<uint64_t> calls[TelemetryCounterCount]; //number of calls of each counter on this process
+	static std::atomic<uint64_t> nanoseconds[TelemetryCounterCount]; //time spent in each counter on this process (summed over threads)
+	static const char* counterNames[TelemetryCounterCount] = { "fft", "mpi" };
+
+	//Sink (only used on the process that opened it):
+	static bool isWriter = false; //whether this process writes records
+	static string targetName;
+	static bool isPipe = false; //whether target is a named pipe (connected lazily and reconnected as needed)
+	static int fd = -1;
+	static string startRecord; //written at start of file, and at each (re)connection of a pipe reader
+
+	//Counters at previous record (all processes):
+	static double tPrev = 0.;
+	static uint64_t callsPrev[TelemetryCounterCount], nanosecondsPrev[TelemetryCounterCount];
+
+	uint64_t timerStart()
+	{	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	void timerStop(TelemetryCounter counter, uint64_t tStart)
+	{	calls[counter]++;
+		nanoseconds[counter] += timerStart() - tStart;
+	}
+
+	//Format a number for JSON output (null if not finite):
+	static string jsonNumber(double x, const char* format="%.6lg")
+	{	if(!std::isfinite(x)) return "null";
+		char buf[64]; snprintf(buf, sizeof(buf), format, x);
+		return buf;
+	}
+
+	//Quote and escape a string for JSON output:
+	static string jsonString(const string& s)
+	{	string out("\"");
+		for(char c: s)
+		{	if(c=='"' or c=='\\') { out += '\\'; out += c; }
+			else if((unsigned char)c < 0x20) { char buf[8]; snprintf(buf, sizeof(buf), "\\u%04x", c); out += buf; }
+			else out += c;
+		}
+		return out + "\"";
+	}
+
+	//Write a complete line to the sink. Lines are shorter than PIPE_BUF, so that each
+	//non-blocking write to a pipe either succeeds completely or fails with EAGAIN (record dropped).
+	static void writeLine(const string& line)
+	{	if(!isWriter) return;
+		if(isPipe and fd<0)
+		{	fd = ::open(targetName.c_str(), O_WRONLY | O_NONBLOCK); //fails with ENXIO until a reader is connected
+			if(fd<0) return;
+			if(::write(fd, startRecord.data(), startRecord.length()) < 0) { ::close(fd); fd = -1; return; }
+		}
+		if(fd<0) return;
+		if(::write(fd, line.data(), line.length()) < 0 and isPipe and errno==EPIPE)
+		{	::close(fd); //reader disconnected: reconnect at a later record
+			fd = -1;
+		}
+	}
+
+	//Resident and peak memory of this process in MB (from /proc; zero where unavailable):
+	static void getMemoryUsage(double& rss, double& peak)
+	{	rss = 0.; peak = 0.;
+		FILE* fp = fopen("/proc/self/status", "r");
+		if(!fp) return;
+		char line[256];
+		while(fgets(line, sizeof(line), fp))
+		{	double kB = 0.;
+			if(sscanf(line, "VmRSS: %lf", &kB)==1) rss = kB/1024.;
+			if(sscanf(line, "VmHWM: %lf", &kB)==1) peak = kB/1024.;
+		}
+		fclose(fp);
+	}
+
+	//Reset reference values for the next record to the current counters:
+	static void resetPrev()
+	{	tPrev = clock_sec();
+		for(int i=0; i<TelemetryCounterCount; i++)
+		{	callsPrev[i] = calls[i];
+			nanosecondsPrev[i] = nanoseconds[i];
+		}
+	}
+
+	void open(string target)
+	{	close();
+		bool ok = true;
+		if(mpiWorld->isHead())
+		{	targetName = target;
+			struct stat st;
+			isPipe = (stat(target.c_str(), &st)==0 and S_ISFIFO(st.st_mode));
+			if(isPipe) signal(SIGPIPE, SIG_IGN); //detect disconnected readers by EPIPE instead
+			else
+			{	fd = ::open(target.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+				ok = (fd >= 0);
+			}
+		}
+		mpiWorld->bcast(ok);
+		if(!ok)
+		{	logPrintf("WARNING: could not open telemetry target '%s' for writing; telemetry disabled.\n", target.c_str());
+			return;
+		}
+		enabled = true;
+		isWriter = mpiWorld->isHead();
+		if(isWriter)
+		{	char hostname[256]; if(gethostname(hostname, sizeof(hostname))) hostname[0] = 0;
+			hostname[sizeof(hostname)-1] = 0;
+			ostringstream oss;
+			oss << "{\"event\":\"start\",\"input\":" << jsonString(inputBasename)
+				<< ",\"host\":" << jsonString(hostname) << ",\"pid\":" << getpid()
+				<< ",\"nProcesses\":" << mpiWorld->nProcesses() << ",\"nThreads\":" << nProcsAvailable
+				<< ",\"t\":" << jsonNumber(clock_sec(), "%.3lf") << "}\n";
+			startRecord = oss.str();
+			if(!isPipe) writeLine(startRecord);
+			else writeLine(string()); //connect now, if a reader is waiting
+		}
+		logPrintf("Writing telemetry records to %s '%s'.\n", isPipe ? "named pipe" : "file", target.c_str());
+		resetPrev();
+	}
+
+	void close(bool success)
+	{	if(!enabled) return;
+		ostringstream oss;
+		oss << "{\"event\":\"end\",\"status\":\"" << (success ? "done" : "failed")
+			<< "\",\"t\":" << jsonNumber(clock_sec(), "%.3lf") << "}\n";
+		writeLine(oss.str());
+		if(fd >= 0) ::close(fd);
+		fd = -1;
+		isWriter = false;
+		enabled = false;
+	}
+
+	void recordIteration(const char* stage, int iter, double energy, double residual, bool collective)
+	{	if(!(collective or isWriter))
+		{	resetPrev(); //local record: only the head reports its own counters
+			return;
+		}
+		//Collect local counter increments and busy time (excluding MPI) since previous record:
+		double t = clock_sec();
+		double dt = t - tPrev;
+		std::vector<double> sums, maxes(TelemetryCounterCount+3), mins(1);
+		for(int i=0; i<TelemetryCounterCount; i++)
+		{	sums.push_back(double(calls[i] - callsPrev[i]));
+			maxes[i] = 1e-9 * (nanoseconds[i] - nanosecondsPrev[i]);
+		}
+		double busy = std::max(0., dt - maxes[TelemetryMPI]);
+		double rss, peak; getMemoryUsage(rss, peak);
+		sums.push_back(busy);
+		sums.push_back(rss);
+		maxes[TelemetryCounterCount] = busy;
+		maxes[TelemetryCounterCount+1] = rss;
+		maxes[TelemetryCounterCount+2] = peak;
+		mins[0] = busy;
+		//Reduce over processes:
+		int nProcesses = 1;
+		if(collective)
+		{	mpiWorld->allReduceData(sums, MPIUtil::ReduceSum);
+			mpiWorld->allReduceData(maxes, MPIUtil::ReduceMax);
+			mpiWorld->allReduceData(mins, MPIUtil::ReduceMin);
+			nProcesses = mpiWorld->nProcesses();
+		}
+		if(isWriter)
+		{	double busyAvg = sums[TelemetryCounterCount] / nProcesses;
+			ostringstream oss;
+			oss << "{\"event\":\"iteration\",\"stage\":" << jsonString(stage) << ",\"iter\":" << iter
+				<< ",\"t\":" << jsonNumber(t, "%.3lf") << ",\"dt\":" << jsonNumber(dt, "%.4lf")
+				<< ",\"energy\":" << jsonNumber(energy, "%.15lg") << ",\"residual\":" << jsonNumber(residual, "%.4le");
+			for(int i=0; i<TelemetryCounterCount; i++)
+				oss << ",\"" << counterNames[i] << "\":{\"calls\":" << jsonNumber(sums[i], "%.0lf")
+					<< ",\"seconds\":" << jsonNumber(maxes[i], "%.4lf") << "}";
+			oss << ",\"busy\":{\"min\":" << jsonNumber(mins[0], "%.4lf")
+				<< ",\"avg\":" << jsonNumber(busyAvg, "%.4lf")
+				<< ",\"max\":" << jsonNumber(maxes[TelemetryCounterCount], "%.4lf")
+				<< ",\"imbalance\":" << jsonNumber(busyAvg>0. ? maxes[TelemetryCounterCount]/busyAvg : 1., "%.3lf") << "}"
+				<< ",\"memoryMB\":{\"rssMax\":" << jsonNumber(maxes[TelemetryCounterCount+1], "%.1lf")
+				<< ",\"rssTotal\":" << jsonNumber(sums[TelemetryCounterCount+1], "%.1lf")
+				<< ",\"peakMax\":" << jsonNumber(maxes[TelemetryCounterCount+2], "%.1lf") << "}";
+			if(!collective) oss << ",\"local\":true"; //statistics of the head process alone
+			oss << "}\n";
+			writeLine(oss.str());
+		}
+		resetPrev(); //exclude the cost of telemetry itself from the next record
+	}
+}
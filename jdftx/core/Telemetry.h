@@ -0,0 +1,62 @@
+/*-------------------------------------------------------------------
+Copyright 2026 Ravishankar Sundararaman
+
+This file is part of JDFTx.
+
+JDFTx is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+JDFTx is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------*/
+
+#ifndef JDFTX_CORE_TELEMETRY_H
+#define JDFTX_CORE_TELEMETRY_H
+
+//! @addtogroup Utilities
+//! @{
+
+//! @file Telemetry.h Optional machine-readable stream of per-iteration progress and performance records
+
+#include <core/TelemetryTimer.h>
+#include <core/string.h>
+
+//! Telemetry sink which emits one JSON record per line for every iteration of the
+//! electronic, ionic and fluid loops, to a regular file or a named pipe.
+//! When no sink is open, instrumentation costs a single branch per call.
+namespace Telemetry
+{
+	//! Open sink at target, which is overwritten if a regular file. If target is a named pipe, readers may
+	//! connect and reconnect at any time, and records are dropped (rather than blocking the calculation)
+	//! while no reader is connected or the pipe is full. Collective over mpiWorld; only the head writes.
+	void open(string target);
+
+	//! Write an end record with the final status and close the sink, if open (not collective)
+	void close(bool success=true);
+
+	void recordIteration(const char* stage, int iter, double energy, double residual, bool collective); //!< implementation of record() and recordLocal()
+
+	//! Emit a record for iteration iter of stage, with the current energy (or other minimized quantity)
+	//! and residual (NAN if not available). This is collective over mpiWorld when a sink is open,
+	//! and must therefore only be called from loops that run in lock step on all processes.
+	//! Does nothing if stage is null, so that minimizers can opt in by name (see Minimizable::telemetryStage).
+	inline void record(const char* stage, int iter, double energy, double residual)
+	{	if(enabled and stage) recordIteration(stage, iter, energy, residual, true);
+	}
+	
+	//! Non-collective version of record() for cheap inner iterations, where the reductions over processes would
+	//! be comparable to the work per iteration. Counters, busy time and memory are then those of the head alone.
+	inline void recordLocal(const char* stage, int iter, double energy, double residual)
+	{	if(enabled and stage) recordIteration(stage, iter, energy, residual, false);
+	}
+}
+
+//! @}
+#endif // JDFTX_CORE_TELEMETRY_H
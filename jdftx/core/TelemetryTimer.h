@@ -0,0 +1,58 @@
+/*-------------------------------------------------------------------
+Copyright 2026 Ravishankar Sundararaman
+
+This file is part of JDFTx.
+
+JDFTx is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+JDFTx is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------*/
+
+#ifndef JDFTX_CORE_TELEMETRYTIMER_H
+#define JDFTX_CORE_TELEMETRYTIMER_H
+
+//! @addtogroup Utilities
+//! @{
+
+//! @file TelemetryTimer.h Minimal interface for instrumenting hot paths with telemetry counters (see Telemetry.h)
+
+#include <cstdint>
+
+//! Instrumented hot paths, whose call counts and times are included in each telemetry record
+enum TelemetryCounter
+{	TelemetryFFT, //!< fourier transforms (I, Idag and their complex / in-place variants)
+	TelemetryMPI, //!< blocking MPI communication and waits on asynchronous requests
+	TelemetryCounterCount //!< number of counters (not a valid counter)
+};
+
+namespace Telemetry
+{
+	extern bool enabled; //!< whether a sink is open (consistent on all processes of mpiWorld)
+	
+	uint64_t timerStart(); //!< current time in nanoseconds, for Timer
+	void timerStop(TelemetryCounter counter, uint64_t tStart); //!< accumulate a call and the time elapsed since tStart into counter, for Timer
+
+	//! Scoped timer that accumulates a call and its elapsed time into a counter, while a sink is open
+	//! (and if condition is true, eg. to time only blocking variants of communication calls).
+	//! When no sink is open, this costs a single branch.
+	class Timer
+	{	TelemetryCounter counter;
+		bool active;
+		uint64_t tStart;
+	public:
+		Timer(TelemetryCounter counter, bool condition=true) : counter(counter), active(enabled and condition), tStart(active ? timerStart() : 0) {}
+		~Timer() { if(active) timerStop(counter, tStart); }
+	};
+}
+
+//! @}
+#endif // JDFTX_CORE_TELEMETRYTIMER_H
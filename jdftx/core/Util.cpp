@@ -21,6 +21,7 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #include <core/Thread.h>
 #include <core/ManagedMemory.h>
 #include <core/GpuUtil.h>
+#include <core/Telemetry.h>
 #include <cmath>
 #include <csignal>
 #include <list>
@@ -73,6 +74,9 @@ void printUsage(const char *name, const InitParams& ip)
 	logPrintf("\t-c --cores              number of cores per process (ignored when launched using SLURM)\n");
 	logPrintf("\t-G --nGroups            number of MPI process groups (default or 0 => each process in own group of size 1)\n");
 	logPrintf("\t-s --skip-defaults      skip printing status of default commands issued automatically.\n");
+	if(ip.e)
+		logPrintf("\t-b --batch <list|dir>   run all input files listed in <list> (or named *.in in directory <dir>)\n"
+			"\t                        one after another within each process group (see -G), with output in <input>.out\n");
 	logPrintf("\n");
 }
 
@@ -145,11 +149,18 @@ void logResume()
 {	globalLog = globalLogOrig;
 }
 
+FILE* logRedirect(FILE* fp)
+{	FILE* fpPrev = globalLogOrig;
+	globalLog = globalLogOrig = fp;
+	return fpPrev;
+}
+
 int nProcessGroups = 0;
 MPIUtil* mpiWorld = 0;
 MPIUtil* mpiGroup = 0;
 MPIUtil* mpiGroupHead = 0;
 bool mpiDebugLog = false;
+bool batchMode = false;
 bool manualThreadCount = false;
 size_t mempoolSize = 0;
 static double startTime_us; //Time at which system was initialized in microseconds
@@ -318,10 +329,11 @@ void initSystemCmdline(int argc, char** argv, InitParams& ip)
 			{"nGroups", required_argument, 0, 'G'},
 			{"skip-defaults", no_argument, 0, 's'},
 			{"write-manual", required_argument, 0, 'w'},
+			{"batch", required_argument, 0, 'b'},
 			{0, 0, 0, 0}
 		};
 	while (1)
-	{	int c = getopt_long(argc, argv, "hvi:o:dtmnc:G:sw:", long_options, 0);
+	{	int c = getopt_long(argc, argv, "hvi:o:dtmnc:G:sw:b:", long_options, 0);
 		if (c == -1) break; //end of options
 		#define RUN_HEAD(code) if(mpiWorld->isHead()) { code } delete mpiWorld;
 		switch (c)
@@ -352,6 +364,7 @@ void initSystemCmdline(int argc, char** argv, InitParams& ip)
 				break;
 			}
 			case 's': ip.printDefaults=false; break;
+			case 'b': ip.batchInput.assign(optarg); break;
 			case 'w': RUN_HEAD( if(ip.e) writeCommandManual(*ip.e, optarg); ) exit(0);
 			default: RUN_HEAD( printUsage(argv[0], ip); ) exit(1);
 		}
@@ -408,6 +421,8 @@ void finalizeSystem(bool successful)
 	logPrintf("End date and time: %s  (Duration: %d-%d:%02d:%05.2lf)\n",
 		endTimeString, durationDays, durationHrs, durationMin, durationSec);
 	
+	Telemetry::close(successful); //no-op unless a sink is still open (eg. on exit via die())
+	
 	if(successful) logPrintf("Done!\n");
 	else
 	{	logPrintf("Failed.\n");
@@ -45,6 +45,8 @@ extern MPIUtil* mpiGroup; //!< MPI within current group of processes
 extern MPIUtil* mpiGroupHead; //!< MPI across equal ranks in each group
 extern bool mpiDebugLog; //!< If true, all processes output to seperate debug log files, otherwise only head process outputs (set before calling initSystem())
 extern size_t mempoolSize; //!< If non-zero, size of memory pool managed internally by JDFTx
+extern bool batchMode; //!< Whether several calculations run one after another in this process: enables in-memory reuse of setup data between them, and makes die() throw BatchJobFailure
+struct BatchJobFailure {}; //!< Thrown by die() in batch mode, so that the remaining calculations can proceed
 
 //! Parameters used for common initialization functions
 struct InitParams
@@ -54,6 +56,7 @@ struct InitParams
 	InitParams(const char* description=0, class Everything* e=0);
 	//Output parameters retrieved from command-line:
 	string inputFilename; //!< name of input file
+	string batchInput; //!< file listing input files, or directory of input files, for batch mode (if non-empty)
 	bool dryRun; //!< whether this is a dry run
 	bool printDefaults; //!< whether to print default commands
 	//Optional parameters useful when calling from outside JDFTx:
@@ -127,6 +130,7 @@ extern FILE* globalLog;
 extern FILE* nullLog; //!< pointer to /dev/null
 void logSuspend(); //!< temporarily disable all log output (until logResume())
 void logResume(); //!< re-enable logging after a logSuspend() call
+FILE* logRedirect(FILE* fp); //!< send log output to fp (including after subsequent logSuspend() / logResume() pairs), returning the previous log stream
 
 #define logPrintf(...) fprintf(globalLog, __VA_ARGS__) //!< printf() for log files
 #define logFlush() fflush(globalLog) //!< fflush() for log files
@@ -136,6 +140,7 @@ void logResume(); //!< re-enable logging after a logSuspend() call
 	{	fprintf(globalLog, __VA_ARGS__); \
 		if(mpiWorld->isHead() && globalLog != stdout) \
 			fprintf(stderr, __VA_ARGS__); \
+		if(batchMode) throw BatchJobFailure(); \
 		finalizeSystem(false); \
 		exit(1); \
 	}
@@ -28,6 +28,7 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #include <core/ScalarField.h>
 #include <core/GridInfo.h>
 #include <core/Operators.h>
+#include <core/ScalarFieldExpr.h>
 #include <core/RadialFunction.h>
 
 #define Tptr std::shared_ptr<T> //!< shorthand for writing the template operators (undef'd at end of header)
@@ -155,8 +156,8 @@ template<class T,int N> double sum(const TptrMul& X) { double ret=0.0; Nloop(ret
 inline vector3<> getGzero(const VectorFieldTilde& X) { vector3<> ret; for(int k=0; k<3; k++) if(X[k]) ret[k]=X[k]->getGzero(); return ret; } //!< return G=0 components
 inline void setGzero(const VectorFieldTilde& X, vector3<> v) { for(int k=0; k<3; k++) if(X[k]) X[k]->setGzero(v[k]); } //!< set G=0 components
 inline vector3<> sumComponents(const VectorField& X) { return vector3<>(sum(X[0]), sum(X[1]), sum(X[2])); } //!< Sum of elements (component-wise)
-inline ScalarField lengthSquared(const VectorField& X) { return X[0]*X[0] + X[1]*X[1] + X[2]*X[2]; } //!< Elementwise length squared
-inline ScalarField lengthSquaredWeighted(const vector3<>& w, const VectorField& X) { return w[0]*X[0]*X[0] + w[1]*X[1]*X[1] + w[2]*X[2]*X[2]; } //!< Elementwise length squared (weighted)
+inline ScalarField lengthSquared(const VectorField& X) { return lazy(X[0])*X[0] + lazy(X[1])*X[1] + lazy(X[2])*X[2]; } //!< Elementwise length squared
+inline ScalarField lengthSquaredWeighted(const vector3<>& w, const VectorField& X) { return w[0]*lazy(X[0])*X[0] + w[1]*lazy(X[1])*X[1] + w[2]*lazy(X[2])*X[2]; } //!< Elementwise length squared (weighted)
 inline ScalarField dotElemwise(const VectorField& X, const VectorField& Y) { return X[0]*Y[0] + X[1]*Y[1] + X[2]*Y[2]; } //!< Elementwise dot
 inline matrix3<> dotOuter(const VectorField& X, const VectorField& Y); //!< Compute m(i,j) = dot(X[i], Y[j])
 inline matrix3<> dotOuter(const VectorField& X, const VectorField& Y, const ScalarField& w); //!< Compute m(i,j) = dot(X[i], w * Y[j])
@@ -0,0 +1,134 @@
+/*-------------------------------------------------------------------
+Copyright 2026 Ravishankar Sundararaman
+
+This file is part of JDFTx.
+
+JDFTx is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+JDFTx is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------*/
+
+#include <electronic/BandChFSI.h>
+#include <electronic/Everything.h>
+#include <electronic/ColumnBundle.h>
+
+BandChFSI::BandChFSI(Everything& e, int q): e(e), eVars(e.eVars), eInfo(e.eInfo), q(q)
+{	assert(e.cntrl.fixed_H); // Check whether the electron Hamiltonian is fixed
+}
+
+void BandChFSI::applyH(const ColumnBundle& Y, ColumnBundle& HY)
+{	//Temporarily swap Y into the working set (same approach as the Davidson subspace expansion):
+	ColumnBundle Ytmp = Y;
+	std::vector<matrix> VdagY;
+	e.iInfo.project(Ytmp, VdagY);
+	matrix HsubY; diagMatrix HsubY_eigs;
+	#define SWAP_C_Y \
+		std::swap(eVars.C[q], Ytmp); \
+		std::swap(eVars.VdagC[q], VdagY); \
+		std::swap(eVars.Hsub[q], HsubY); \
+		std::swap(eVars.Hsub_eigs[q], HsubY_eigs);
+	SWAP_C_Y
+	HY = ColumnBundle();
+	Energies ener; //not used here
+	eVars.applyHamiltonian(q, eye(Y.nCols()), HY, ener, true, false);
+	SWAP_C_Y
+	#undef SWAP_C_Y
+}
+
+double BandChFSI::upperBound()
+{	const int nLanczos = 6;
+	ColumnBundle v = eVars.C[q].similar(1), vPrev;
+	randomize(v);
+	v = (1./sqrt(trace(v^O(v)).real())) * v;
+	matrix T = zeroes(nLanczos, nLanczos);
+	double beta = 0.;
+	for(int j=0; j<nLanczos; j++)
+	{	ColumnBundle f; applyH(v, f);
+		double alpha = trace(v^f).real();
+		f -= alpha * v;
+		if(j) f -= beta * vPrev;
+		beta = sqrt(trace(f^f).real());
+		T.set(j,j, alpha);
+		if(j+1 < nLanczos)
+		{	T.set(j,j+1, beta);
+			T.set(j+1,j, beta);
+		}
+		if(!beta) break; //invariant subspace found (unlikely)
+		vPrev = v;
+		v = (1./beta) * f;
+	}
+	matrix Tevecs; diagMatrix Teigs;
+	T.diagonalize(Tevecs, Teigs);
+	return Teigs.back() + beta; //largest Ritz value + norm of residual bounds the spectrum
+}
+
+void BandChFSI::minimize(int nPasses, int degree)
+{	ColumnBundle& C = eVars.C[q];
+	std::vector<matrix>& VdagC = eVars.VdagC[q];
+	matrix& Hsub = eVars.Hsub[q];
+	matrix& Hsub_evecs = eVars.Hsub_evecs[q];
+	diagMatrix& Hsub_eigs = eVars.Hsub_eigs[q];
+	const QuantumNumber& qnum = eInfo.qnums[q];
+	int nBands = eInfo.nBands;
+	diagMatrix I = eye(nBands);
+	Energies ener; //not really used here
+	
+	//Ritz values of current subspace (bracket the wanted part of the spectrum):
+	if(int(Hsub_eigs.size()) != nBands)
+	{	ColumnBundle HC;
+		eVars.applyHamiltonian(q, I, HC, ener, true, true);
+	}
+	double Eband = qnum.weight * trace(Hsub_eigs);
+	
+	for(int iPass=1; iPass<=nPasses; iPass++)
+	{	//Spectral bounds: filter damps (a,b] relative to the lowest Ritz value a0:
+		double a0 = Hsub_eigs.front();
+		double a = Hsub_eigs.back();
+		double b = upperBound();
+		if(b <= a) b = a + 1.; //safety for tiny bases (filter then reduces to a shifted power iteration)
+		
+		//Scaled Chebyshev filter (three-term recurrence, scaled to avoid overflow):
+		double halfWidth = 0.5*(b-a), center = 0.5*(b+a);
+		double sigma = halfWidth / (a0 - center), sigma1 = sigma;
+		ColumnBundle X = C, Y;
+		applyH(X, Y);
+		Y -= center * X;
+		Y *= (sigma1 / halfWidth);
+		for(int i=2; i<=degree; i++)
+		{	double sigmaNew = 1. / (2./sigma1 - sigma);
+			ColumnBundle Ynew; applyH(Y, Ynew);
+			Ynew -= center * Y;
+			Ynew *= (2.*sigmaNew / halfWidth);
+			Ynew -= (sigma*sigmaNew) * X;
+			X = Y;
+			std::swap(Y, Ynew);
+			sigma = sigmaNew;
+		}
+		X = ColumnBundle();
+		
+		//Orthonormalize and solve subspace eigenvalue problem (Rayleigh-Ritz):
+		C = Y * orthoMatrix(Y^O(Y));
+		Y = ColumnBundle();
+		e.iInfo.project(C, VdagC);
+		ColumnBundle HC;
+		eVars.applyHamiltonian(q, I, HC, ener, true, true); ///update Hsub, Hsub_evecs and Hsub_eigs
+		C = C * Hsub_evecs;
+		e.iInfo.project(C, VdagC, &Hsub_evecs);
+		
+		double EbandPrev = Eband;
+		Eband = qnum.weight * trace(Hsub_eigs);
+		logPrintf("BandChFSI: Iter: %3d  Eband: %+.15lf  dEband: %le  bounds: [%lg, %lg, %lg]  t[s]: %9.2lf\n",
+			iPass, Eband, Eband-EbandPrev, a0, a, b, clock_sec()); fflush(globalLog);
+	}
+	Hsub = Hsub_eigs;
+	Hsub_evecs = I;
+}
@@ -0,0 +1,51 @@
+/*-------------------------------------------------------------------
+Copyright 2026 Ravishankar Sundararaman
+
+This file is part of JDFTx.
+
+JDFTx is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+JDFTx is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------*/
+
+#ifndef JDFTX_ELECTRONIC_BANDCHFSI_H
+#define JDFTX_ELECTRONIC_BANDCHFSI_H
+
+#include <core/matrix.h>
+
+class Everything;
+class ColumnBundle;
+
+//! @addtogroup ElecSystem
+//! @{
+
+//! Chebyshev-filtered subspace iteration (for the inner eigenvalue updates within SCF)
+//! Each pass applies a Chebyshev polynomial of H that damps the unwanted part of the spectrum,
+//! followed by a single orthonormalization and subspace diagonalization (Rayleigh-Ritz).
+class BandChFSI
+{
+public:
+	BandChFSI(Everything& e, int q); //!< Construct filtered subspace iteration for quantum number q
+	void minimize(int nPasses, int degree); //!< Apply nPasses filter passes with Chebyshev polynomials of specified degree
+	
+private:
+	Everything& e;
+	class ElecVars& eVars;
+	const class ElecInfo& eInfo;
+	int q;  //!< Current quantum number
+	
+	void applyH(const ColumnBundle& Y, ColumnBundle& HY); //!< Apply Hamiltonian to arbitrary Y (using eVars.C[q] as the working set)
+	double upperBound(); //!< Estimate upper bound of spectrum using a few Lanczos steps
+};
+
+//! @}
+#endif // JDFTX_ELECTRONIC_BANDCHFSI_H
@@ -25,6 +25,22 @@ BandDavidson::BandDavidson(Everything& e, int q): e(e), eVars(e.eVars), eInfo(e.
 {	assert(e.cntrl.fixed_H); // Check whether the electron Hamiltonian is fixed
 }
 
+//Append columns of X to Y (for accumulating locked eigenvectors and their projections):
+inline void appendColumns(ColumnBundle& Y, const ColumnBundle& X)
+{	if(!Y) { Y = X; return; }
+	ColumnBundle YX = Y.similar(Y.nCols() + X.nCols());
+	YX.setSub(0, Y);
+	YX.setSub(Y.nCols(), X);
+	std::swap(Y, YX);
+}
+inline void appendColumns(matrix& Y, const matrix& X)
+{	if(!Y) { Y = X; return; }
+	matrix YX(Y.nRows(), Y.nCols() + X.nCols());
+	YX.set(0,Y.nRows(), 0,Y.nCols(), Y);
+	YX.set(0,Y.nRows(), Y.nCols(),YX.nCols(), X);
+	std::swap(Y, YX);
+}
+
 void BandDavidson::minimize(bool isInner)
 {	//Use the same working set as the CG minimizer:
 	ColumnBundle& C = eVars.C[q];
@@ -48,11 +64,28 @@ void BandDavidson::minimize(bool isInner)
 	}
 	int nEigsDone = 0;
 	
+	//Hard locking: leading bands that have converged are removed from C (which then holds only the active bands),
+	//and excluded from subsequent subspace expansions, Rayleigh-Ritz problems, rotations and Hamiltonian applications.
+	//Locked eigenpairs are therefore not refined further; the active bands are kept O-orthogonal to them.
+	//(Converged active bands that are not yet locked are only skipped in the expansion, i.e. soft-locked.)
+	int nLocked = 0;
+	ColumnBundle Clocked;
+	std::vector<matrix> VdagClocked(VdagC.size());
+	diagMatrix eigsLocked;
+	
+	//Statistics of Hamiltonian applications:
+	size_t nHcols = nBandsOut; //number of columns that H was applied to
+	size_t nHcolsFull = nBandsOut; //number of columns for expanding all bands in each iteration
+	double tH = 0.; //time spent in Hamiltonian applications
+	
 	//Initial subspace eigenvalue problem:
 	ColumnBundle HC;
 	diagMatrix I = eye(nBandsOut);
 	Energies ener; //not really used here
-	eVars.applyHamiltonian(q, I, HC, ener, true, true); ///update Hsub, Hsub_evecs and Hsub_eigs
+	{	double tStart = clock_sec();
+		eVars.applyHamiltonian(q, I, HC, ener, true, true); ///update Hsub, Hsub_evecs and Hsub_eigs
+		tH += clock_sec() - tStart;
+	}
 	//--- switch C to subspace eigenbasis:
 	C = C * Hsub_evecs;
 	HC = HC * Hsub_evecs;
@@ -74,7 +107,7 @@ void BandDavidson::minimize(bool isInner)
 		{	//Drop columns whose norm falls below above cutoff
 			complex* CexpData = Cexp.dataPref();
 			int bOut = 0;
-			for(int b=nEigsDone; b<nBands; b++)
+			for(int b=std::max(nEigsDone-nLocked,0); b<nBands; b++)
 			{	if(CexpNorm[b]<CexpNormCut) continue;
 				CexpNorm[bOut] = 1/sqrt(CexpNorm[b]);
 				if(bOut<b) callPref(eblas_copy)(CexpData+Cexp.index(bOut,0), CexpData+Cexp.index(b,0), Cexp.colLength());
@@ -90,6 +123,7 @@ void BandDavidson::minimize(bool isInner)
 			}
 		}
 		Cexp = Cexp * CexpNorm;
+		if(nLocked) Cexp -= Clocked * (Clocked ^ O(Cexp)); //exclude locked eigenvectors from the expansion
 		int nBandsNew = Cexp.nCols();
 		int nBandsBig = nBands + nBandsNew;
 		//Expansion subspace overlaps:
@@ -114,7 +148,11 @@ void BandDavidson::minimize(bool isInner)
 				std::swap(Hsub, HsubExp); \
 				std::swap(Hsub_eigs, HsubExp_eigs);
 			SWAP_C_Cexp //Temporarily swap C and Cexp
+			double tStart = clock_sec();
 			eVars.applyHamiltonian(q, eye(nBandsNew), HCexp, ener, true, false); //compute Hsub (for Cexp) but don't diagonalize
+			tH += clock_sec() - tStart;
+			nHcols += nBandsNew;
+			nHcolsFull += nLocked + nBands;
 			SWAP_C_Cexp  //Restore C and Cexp to correct places
 			matrix CdagHCexp = C  ^ HCexp;
 			bigHsub.set(0,nBands, 0,nBands, Hsub_eigs);
@@ -128,7 +166,7 @@ void BandDavidson::minimize(bool isInner)
 		matrix bigHsub_evecs; diagMatrix bigHsub_eigs;
 		bigHsub.diagonalize(bigHsub_evecs, bigHsub_eigs);
 		matrix rot = bigU * bigHsub_evecs; //rotation from [C,Cexp] to the expanded subspace eigenbasis
-		int nBandsNext = std::min(nBandsMax, nBandsBig); //number of bands to retain for next iteration
+		int nBandsNext = std::min(nBandsMax-nLocked, nBandsBig); //number of active bands to retain for next iteration
 		matrix Crot = rot(0,nBands, 0,nBandsNext); //contribution of C to lowest nBandsNext eigenvectors
 		matrix CexpRot = rot(nBands,nBandsBig, 0,nBandsNext); //contribution of Cexp to lowest nBandsNext eigenvectors
 		//Update C to optimum nBands subspace from [C,Cexp]
@@ -140,14 +178,15 @@ void BandDavidson::minimize(bool isInner)
 			VdagC[sp] = VdagC[sp]*Crot + VdagCexp[sp]*CexpRot;
 		//Print and test convergence
 		double EbandPrev = Eband;
-		Eband = qnum.weight * trace(Hsub_eigs(0,nBandsOut));
+		Eband = qnum.weight * (trace(eigsLocked) + trace(Hsub_eigs(0,nBandsOut-nLocked)));
 		double dEband = Eband - EbandPrev;
 		//Check number of converged eigenvalues:
-		nEigsDone = 0;
-		for(nEigsDone=0; nEigsDone<nBands; nEigsDone++)
-			if(fabs(Hsub_eigs[nEigsDone] - Hsub_eigs_prev[nEigsDone]) > mp.energyDiffThreshold)
+		int nActiveDone = 0;
+		for(nActiveDone=0; nActiveDone<std::min(nBands,nBandsNext); nActiveDone++)
+			if(fabs(Hsub_eigs[nActiveDone] - Hsub_eigs_prev[nActiveDone]) > mp.energyDiffThreshold)
 				break;
-		logPrintf("BandDavidson: Iter: %3d  Eband: %+.15lf  dEband: %le  t[s]: %9.2lf\n", iter, Eband, dEband, clock_sec()); fflush(globalLog);
+		nEigsDone = nLocked + nActiveDone;
+		logPrintf("BandDavidson: Iter: %3d  Eband: %+.15lf  dEband: %le  nLocked: %d  t[s]: %9.2lf\n", iter, Eband, dEband, nLocked, clock_sec()); fflush(globalLog);
 		if(dEband<0 and fabs(dEband)<mp.energyDiffThreshold)
 		{	logPrintf("BandDavidson: Converged (dEband<%le)\n", mp.energyDiffThreshold);
 			break;
@@ -156,11 +195,40 @@ void BandDavidson::minimize(bool isInner)
 		{	logPrintf("BandDavidson: Converged (nEigsDone>=%d)\n", nEigsMin);
 			break;
 		}
+		//Hard-lock converged leading eigenpairs (retaining at least one active output band):
+		int nLock = std::min(nActiveDone, nBandsOut-1-nLocked);
+		if(nLock > 0)
+		{	appendColumns(Clocked, C.getSub(0,nLock));
+			C = C.getSub(nLock, nBandsNext);
+			HC = HC.getSub(nLock, nBandsNext);
+			for(size_t sp=0; sp<VdagC.size(); sp++) if(VdagC[sp])
+			{	int nRows = VdagC[sp].nRows();
+				appendColumns(VdagClocked[sp], VdagC[sp](0,nRows, 0,nLock));
+				VdagC[sp] = VdagC[sp](0,nRows, nLock,nBandsNext);
+			}
+			eigsLocked.insert(eigsLocked.end(), Hsub_eigs.begin(), Hsub_eigs.begin()+nLock);
+			Hsub_eigs = Hsub_eigs(nLock, nBandsNext);
+			nLocked += nLock;
+		}
 	}
 	if(iter>mp.nIterations)
 		logPrintf("BandDavidson: None of the convergence criteria satisfied after %d iterations.\n", mp.nIterations);
+	logPrintf("BandDavidson: Applied H to %lu columns (%lu avoided by deflation and locking) in %.2lf s; %d bands hard-locked.\n",
+		nHcols, nHcolsFull-nHcols, tH, nLocked);
 	fflush(globalLog);
 	
+	//Restore locked eigenpairs:
+	if(nLocked)
+	{	appendColumns(Clocked, C);
+		std::swap(C, Clocked);
+		for(size_t sp=0; sp<VdagC.size(); sp++) if(VdagC[sp])
+		{	appendColumns(VdagClocked[sp], VdagC[sp]);
+			std::swap(VdagC[sp], VdagClocked[sp]);
+		}
+		eigsLocked.insert(eigsLocked.end(), Hsub_eigs.begin(), Hsub_eigs.end());
+		std::swap(Hsub_eigs, eigsLocked);
+	}
+	
 	//Update final quantities:
 	if(C.nCols() != nBandsOut)
 	{	//reduce outputs to size:
@@ -28,7 +28,8 @@ class Everything;
 //! @addtogroup ElecSystem
 //! @{
 
-//! Davidson eigensolver
+//! Davidson eigensolver, with hard locking of converged leading eigenpairs
+//! (they are removed from the active block and its Rayleigh-Ritz problem)
 class BandDavidson
 {
 public:
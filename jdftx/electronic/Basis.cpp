@@ -65,6 +65,20 @@ void Basis::setup(const GridInfo& gInfo, const IonInfo& iInfo, double Ecut, cons
 	logPrintf("nbasis = %lu for k = ", nbasis); k.print(globalLog, " %6.3f ");
 }
 
+size_t Basis::count(const GridInfo& gInfo, double Ecut, const vector3<> k)
+{	vector3<int> iGbox;
+	for(int i=0; i<3; i++)
+		iGbox[i] = 1 + int(sqrt(2*Ecut) * gInfo.R.column(i).length() / (2*M_PI)) + ceil(fabs(k[i]));
+	size_t nbasis = 0;
+	vector3<int> iG;
+	for(iG[0]=-iGbox[0]; iG[0]<=iGbox[0]; iG[0]++)
+		for(iG[1]=-iGbox[1]; iG[1]<=iGbox[1]; iG[1]++)
+			for(iG[2]=-iGbox[2]; iG[2]<=iGbox[2]; iG[2]++)
+				if(0.5*dot(iG+k, gInfo.GGT*(iG+k)) <= Ecut)
+					nbasis++;
+	return nbasis;
+}
+
 void Basis::setup(const GridInfo& gInfo, const IonInfo& iInfo, const std::vector<int>& indexVec)
 {	//Compute the integer G-vectors for the specified indices:
 	std::vector< vector3<int> > iGvec(indexVec.size());
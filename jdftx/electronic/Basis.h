@@ -48,6 +48,9 @@ public:
 	//! Setup the indices and integer G-vectors within Ecut for kpoint k
 	void setup(const GridInfo& gInfo, const IonInfo& iInfo, double Ecut, const vector3<> k);
 
+	//! Number of basis functions that setup() would select for kpoint k (without allocating the basis)
+	static size_t count(const GridInfo& gInfo, double Ecut, const vector3<> k);
+	
 	//! Create a custom basis with an arbitrary indexing scheme
 	void setup(const GridInfo& gInfo, const IonInfo& iInfo, const std::vector<int>& indexVec);
 	
@@ -0,0 +1,224 @@
+/*-------------------------------------------------------------------
+Copyright 2026 Ravishankar Sundararaman
+
+This file is part of JDFTx.
+
+JDFTx is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+JDFTx is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------*/
+
+#include <electronic/CalculatorServer.h>
+#include <electronic/Everything.h>
+#include <electronic/LatticeMinimizer.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <signal.h>
+
+CalculatorServer::CalculatorServer() : e(0), nAtoms(0), listenFd(-1), fpIn(0), fpOut(0)
+{
+}
+
+void CalculatorServer::setup(Everything* e)
+{	this->e = e;
+	//Perform any compatibility checks here (so that dry runs will pick these up)
+	if(e->symm.mode != SymmetriesNone)
+		die("\ncalculator-server requires 'symmetries none', since client geometries need not preserve symmetries.\n\n");
+	if(socketPath.length() >= sizeof(sockaddr_un::sun_path))
+		die("\ncalculator-server socket path '%s' is too long.\n\n", socketPath.c_str());
+	nAtoms = 0;
+	for(const auto& sp: e->iInfo.species)
+		nAtoms += sp->atpos.size();
+}
+
+void CalculatorServer::run()
+{	logPrintf("\n--------- Calculator server ---------\n");
+	//Start listening on socket:
+	void (*sigpipeHandlerPrev)(int) = 0;
+	if(mpiWorld->isHead())
+	{	sigpipeHandlerPrev = signal(SIGPIPE, SIG_IGN); //detect clients that disconnect mid-compute by failed writes instead
+		unlink(socketPath.c_str()); //remove stale socket, if any
+		listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+		sockaddr_un addr; memset(&addr, 0, sizeof(addr));
+		addr.sun_family = AF_UNIX;
+		strcpy(addr.sun_path, socketPath.c_str());
+		if(listenFd < 0
+			or bind(listenFd, (const sockaddr*)&addr, sizeof(addr)) < 0
+			or listen(listenFd, 1) < 0)
+			die_alone("\nFailed to listen on socket '%s'.\n\n", socketPath.c_str());
+	}
+	logPrintf("Listening for clients on '%s'.\n", socketPath.c_str()); logFlush();
+
+	//Helpers for moving lattice / ions (with wavefunction drag) and computing energy, forces and stress:
+	IonicMinimizer imin(*e, true); //used when lattice is unchanged (avoids lattice-dependent updates)
+	LatticeMinimizer lmin(*e, true, false, true); //dynamics mode with anisotropic lattice changes allowed
+
+	int iStep = 0;
+	while(true)
+	{	//Get request on head and broadcast to all processes:
+		matrix3<> R = e->gInfo.R;
+		std::vector<double> pos; pos.reserve(3*nAtoms);
+		for(const auto& sp: e->iInfo.species)
+			for(const vector3<>& x: sp->atpos)
+			{	vector3<> r = e->gInfo.R * x;
+				pos.insert(pos.end(), &r[0], &r[0]+3);
+			}
+		int action = ActionQuit;
+		if(mpiWorld->isHead()) action = readRequest(R, pos);
+		mpiWorld->bcast(action);
+		if(action == ActionQuit) break;
+		mpiWorld->bcast(&R(0,0), 9);
+		mpiWorld->bcastData(pos);
+
+		//Determine lattice and ionic displacements (Cartesian, at current lattice vectors):
+		logPrintf("\n--------- Calculator server request %d ---------\n", iStep); logFlush();
+		LatticeGradient dir; dir.init(e->iInfo);
+		dir.lattice = R * e->gInfo.invR - matrix3<>(1,1,1);
+		matrix3<> invR = inv(R);
+		const double* posData = pos.data();
+		for(unsigned iSp=0; iSp<e->iInfo.species.size(); iSp++)
+			for(unsigned atom=0; atom<dir.ionic[iSp].size(); atom++)
+			{	vector3<> dx = invR * vector3<>(posData[0], posData[1], posData[2]) - e->iInfo.species[iSp]->atpos[atom];
+				for(int k=0; k<3; k++) dx[k] -= floor(0.5 + dx[k]); //minimum image displacement (for wavefunction drag)
+				dir.ionic[iSp][atom] = e->gInfo.R * dx;
+				posData += 3;
+			}
+
+		//Move and compute:
+		double E; IonicGradient grad;
+		if(nrm2(dir.lattice) < 1e-12) //lattice unchanged
+		{	imin.step(dir.ionic, 1.);
+			E = imin.compute(&grad, 0);
+		}
+		else
+		{	lmin.step(dir, 1.);
+			LatticeGradient latticeGrad;
+			E = lmin.compute(&latticeGrad, 0);
+			grad = latticeGrad.ionic;
+		}
+		e->dump(DumpFreq_Ionic, iStep++);
+
+		//Reply from head:
+		if(mpiWorld->isHead())
+		{	bool ok = true;
+			if(std::isnan(E))
+				ok = (fprintf(fpOut, "error geometry rejected (core overlap or excessive strain relative to initial lattice)\n") >= 0);
+			else
+			{	ok = (fprintf(fpOut, "energy %.15le\nforces", E) >= 0);
+				for(const auto& spGrad: grad)
+					for(const vector3<>& g: spGrad)
+						ok = ok and (fprintf(fpOut, " %.15le %.15le %.15le", -g[0], -g[1], -g[2]) >= 0); //Cartesian forces
+				ok = ok and (fprintf(fpOut, "\n") >= 0);
+				if(e->iInfo.computeStress)
+				{	ok = ok and (fprintf(fpOut, "stress") >= 0);
+					for(int i=0; i<3; i++)
+						for(int j=0; j<3; j++)
+							ok = ok and (fprintf(fpOut, " %.15le", e->iInfo.stress(i,j)) >= 0);
+					ok = ok and (fprintf(fpOut, "\n") >= 0);
+				}
+			}
+			ok = ok and (fprintf(fpOut, "end\n") >= 0) and (fflush(fpOut) == 0);
+			if(!ok)
+			{	closeClient(); //client disconnected during compute: wait for next one
+				logPrintf("Client disconnected before reply.\n"); logFlush();
+			}
+		}
+	}
+
+	//Clean up:
+	if(mpiWorld->isHead())
+	{	closeClient();
+		close(listenFd);
+		unlink(socketPath.c_str());
+		signal(SIGPIPE, sigpipeHandlerPrev);
+	}
+	logPrintf("\nCalculator server stopped after %d requests.\n", iStep); logFlush();
+}
+
+//Read a line from a stream; returns false at end of stream
+static bool readLine(FILE* fp, string& line)
+{	char* buf = 0; size_t bufLen = 0;
+	ssize_t len = getline(&buf, &bufLen, fp);
+	if(len >= 0) line.assign(buf, len);
+	free(buf);
+	return len >= 0;
+}
+
+bool CalculatorServer::acceptClient()
+{	int fd = accept(listenFd, 0, 0);
+	if(fd < 0) return false;
+	fpIn = fdopen(fd, "r");
+	fpOut = fdopen(dup(fd), "w");
+	//Send species list defining order of positions and forces:
+	fprintf(fpOut, "species");
+	for(const auto& sp: e->iInfo.species)
+		fprintf(fpOut, " %s %d", sp->name.c_str(), int(sp->atpos.size()));
+	fprintf(fpOut, "\n");
+	if(fflush(fpOut) != 0) //client already gone
+	{	closeClient();
+		return false;
+	}
+	return true;
+}
+
+void CalculatorServer::closeClient()
+{	if(fpIn) { fclose(fpIn); fpIn = 0; }
+	if(fpOut) { fclose(fpOut); fpOut = 0; }
+}
+
+CalculatorServer::Action CalculatorServer::readRequest(matrix3<>& R, std::vector<double>& pos)
+{	const matrix3<> Rcur = R; const std::vector<double> posCur = pos; //current geometry (restored after a failed request)
+	string errMsg; //first error in the pending request, replied to in place of its results
+	while(true)
+	{	//Get a client if needed:
+		if(!fpIn)
+		{	R = Rcur; pos = posCur; errMsg.clear(); //discard any partial request of previous client
+			if(!acceptClient()) continue;
+			logPrintf("Client connected.\n"); logFlush();
+		}
+		//Read next line:
+		string line;
+		if(!readLine(fpIn, line))
+		{	closeClient(); //client disconnected: wait for next one
+			logPrintf("Client disconnected.\n"); logFlush();
+			continue;
+		}
+		istringstream iss(line);
+		string cmd; iss >> cmd;
+		if(cmd == "compute")
+		{	if(!errMsg.length()) return ActionCompute;
+			//Reply with error (terminated by end, like a result) and reset request:
+			if(fprintf(fpOut, "error %s\nend\n", errMsg.c_str()) < 0 or fflush(fpOut) != 0)
+			{	closeClient();
+				logPrintf("Client disconnected.\n"); logFlush();
+			}
+			R = Rcur; pos = posCur; errMsg.clear();
+		}
+		else if(cmd == "quit") return ActionQuit;
+		else if(cmd == "lattice")
+		{	matrix3<> Rin;
+			for(int i=0; i<3; i++)
+				for(int j=0; j<3; j++)
+					iss >> Rin(i,j);
+			if(iss.fail()) { if(!errMsg.length()) errMsg = "lattice requires 9 values"; }
+			else R = Rin;
+		}
+		else if(cmd == "ion-positions")
+		{	std::vector<double> posIn(3*nAtoms);
+			for(double& p: posIn) iss >> p;
+			if(iss.fail()) { if(!errMsg.length()) { ostringstream oss; oss << "ion-positions requires " << 3*nAtoms << " values"; errMsg = oss.str(); } }
+			else pos = posIn;
+		}
+		else if(cmd.length() and (not errMsg.length())) errMsg = "unknown command '" + cmd + "'";
+	}
+}
@@ -0,0 +1,75 @@
+/*-------------------------------------------------------------------
+Copyright 2026 Ravishankar Sundararaman
+
+This file is part of JDFTx.
+
+JDFTx is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+JDFTx is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------*/
+
+#ifndef JDFTX_ELECTRONIC_CALCULATORSERVER_H
+#define JDFTX_ELECTRONIC_CALCULATORSERVER_H
+
+#include <core/matrix3.h>
+#include <core/string.h>
+#include <vector>
+#include <cstdio>
+
+class Everything;
+
+//! @addtogroup IonicSystem
+//! @{
+
+/** @brief Persistent calculator driven by an external program (eg. ASE) over a local socket
+
+Listens on a UNIX-domain socket and serves energy, force and stress requests for
+geometries sent by the client, moving ions and lattice vectors in place using the
+same update path as lattice minimization, so that wavefunctions, pseudopotentials,
+FFT plans etc. carry over between requests. The protocol is line-based text,
+with all quantities in atomic units (bohrs, Hartrees) and Cartesian coordinates:
+- On connection, the server sends `species <name> <nAtoms> ...` listing the species
+  in the order in which ionic positions and forces are exchanged (atoms of each
+  species in the order of the ion commands).
+- `lattice <R00> <R01> ... <R22>`: set lattice vectors (in columns, as in command lattice)
+- `ion-positions <x1> <y1> <z1> ...`: set positions of all atoms
+- `compute`: the server replies with `energy <E>`, `forces <3*nAtoms values>`,
+  `stress <9 values>` (if enabled) and finally `end`, or with `error <message>` and `end`
+  if the geometry or any line of the request was invalid (the request is then discarded)
+- `quit`: stop the server and complete the calculation (final dumps etc.)
+A client may disconnect and a new one connect any number of times before `quit`.
+*/
+class CalculatorServer
+{
+public:
+	string socketPath; //!< path of the UNIX-domain socket to listen on
+
+	CalculatorServer();
+	void setup(Everything* e);
+	void run(); //!< serve requests till a client sends quit
+
+private:
+	Everything* e;
+	int nAtoms; //!< total number of atoms
+	int listenFd; //!< listening socket (head only)
+	FILE *fpIn, *fpOut; //!< streams for current client (head only)
+
+	//! Action requested by client (broadcast from head to all processes)
+	enum Action { ActionCompute, ActionQuit };
+
+	bool acceptClient(); //!< wait for a new client and send it the species list (head only)
+	Action readRequest(matrix3<>& R, std::vector<double>& pos); //!< read client lines till compute or quit (head only)
+	void closeClient(); //!< close streams of current client (head only)
+};
+
+//! @}
+#endif // JDFTX_ELECTRONIC_CALCULATORSERVER_H
@@ -144,7 +144,9 @@ vector3<matrix> spinOverlap(const scaled<ColumnBundle> &sY); //!< spin-resolved
 //! Return Idag V .* I C (evaluated columnwise)
 //! The handling of the spin structure of V parallels that of diagouterI, with V.size() taking the role of nDensities
 //! If Cout is specified, return output at the k-point and basis of Cout, else use k-point and basis of C.
-ColumnBundle Idag_DiagV_I(const ColumnBundle& C, const ScalarFieldArray& V, const ColumnBundle* Cout = 0);
+//! If singlePrecision, perform the FFTs and potential multiply in single precision (accumulating output in double precision);
+//! this is used only for real collinear potentials on the CPU in builds with SINGLE_PRECISION_FFT, and ignored otherwise.
+ColumnBundle Idag_DiagV_I(const ColumnBundle& C, const ScalarFieldArray& V, const ColumnBundle* Cout = 0, bool singlePrecision = false);
 ColumnBundle Idag_DiagV_I(const ColumnBundle& C, const complexScalarFieldArray& V, const ColumnBundle* Cout = 0); //!< Same as above for complex potentials
 
 ColumnBundle L(const ColumnBundle &Y); //!< Apply Laplacian
@@ -30,6 +30,7 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #include <core/GridInfo.h>
 #include <core/LoopMacros.h>
 #include <core/Operators.h>
+#include <core/TelemetryTimer.h>
 
 //------------------------ Arithmetic operators --------------------
 
@@ -204,6 +205,67 @@ void Idag_DiagV_I_sub(int colStart, int colEnd, const ColumnBundle* C, const std
 			VC->accumColumn(col,s, Idag(Vs * I(C->getColumn(col,s)))); //note VC is zero'd just before
 }
 
+#ifdef SINGLE_PRECISION_FFT
+//Single-precision version of Idag_DiagV_I_sub for real collinear potentials (CPU only):
+//FFTs and potential multiply are in single precision, while input and output stay in double precision
+void Idag_DiagV_I_single_sub(int colStart, int colEnd, const ColumnBundle* C, const std::vector<ManagedArray<float>>* V, ColumnBundle* VC)
+{	const GridInfo& gInfo = *(C->basis->gInfo);
+	const float* Vs = V->at(V->size()==1 ? 0 : C->qnum->index()).data();
+	fftwf_plan planI = gInfo.getPlanSingle(GridInfo::PlanInverseInPlace, 1);
+	fftwf_plan planIdag = gInfo.getPlanSingle(GridInfo::PlanForwardInPlace, 1);
+	ManagedArray<fftwf_complex> work; work.init(gInfo.nr);
+	fftwf_complex* w = work.data();
+	int nbasisIn = C->basis->nbasis, nbasisOut = VC->basis->nbasis;
+	const int* indexIn = C->basis->index.data();
+	const int* indexOut = VC->basis->index.data();
+	int nSpinor = VC->spinorLength();
+	for(int col=colStart; col<colEnd; col++)
+		for(int s=0; s<nSpinor; s++)
+		{	//Scatter to full G-space in single precision:
+			const complex* Cdata = C->data() + C->index(col, s*nbasisIn);
+			work.zero();
+			for(int j=0; j<nbasisIn; j++)
+			{	float* wj = w[indexIn[j]];
+				wj[0] = float(Cdata[j].real());
+				wj[1] = float(Cdata[j].imag());
+			}
+			//Apply potential in real space:
+			{	Telemetry::Timer timer(TelemetryFFT);
+				fftwf_execute_dft(planI, w, w);
+			}
+			for(int i=0; i<gInfo.nr; i++)
+			{	w[i][0] *= Vs[i];
+				w[i][1] *= Vs[i];
+			}
+			{	Telemetry::Timer timer(TelemetryFFT);
+				fftwf_execute_dft(planIdag, w, w);
+			}
+			//Gather-accumulate in double precision:
+			complex* VCdata = VC->data() + VC->index(col, s*nbasisOut);
+			for(int j=0; j<nbasisOut; j++)
+			{	const float* wj = w[indexOut[j]];
+				VCdata[j] += complex(wj[0], wj[1]);
+			}
+		}
+}
+
+//Launch the single-precision version above if applicable, and return whether it was used:
+bool Idag_DiagV_I_single(const ColumnBundle& C, const ScalarFieldArray& V, ColumnBundle& VC)
+{	if(isGpuEnabled() || V.size()>2) return false;
+	std::vector<ManagedArray<float>> Vsingle(V.size());
+	for(size_t s=0; s<V.size(); s++)
+	{	const double* Vdata = V[s]->data();
+		Vsingle[s].init(V[s]->nElem);
+		float* VsingleData = Vsingle[s].data();
+		for(int i=0; i<V[s]->nElem; i++)
+			VsingleData[i] = float(Vdata[i]);
+	}
+	threadLaunch(Idag_DiagV_I_single_sub, C.nCols(), &C, &Vsingle, &VC);
+	return true;
+}
+inline bool Idag_DiagV_I_single(const ColumnBundle& C, const complexScalarFieldArray& V, ColumnBundle& VC) { return false; } //complex potentials always in double precision
+#endif
+
 //Noncollinear version of above (with the preprocessing of complex off-diagonal potentials done in calling function)
 template<typename ScalarFieldType> //templated over ScalarField and complexScalarField
 void Idag_DiagVmat_I_sub(int colStart, int colEnd, const ColumnBundle* C,
@@ -231,7 +293,7 @@ inline void getVupDn(const complexScalarField& Vre, const complexScalarField& Vi
 }
 
 template<typename ScalarFieldType> //templated over ScalarField and complexScalarField
-ColumnBundle Idag_DiagV_I_apply(const ColumnBundle& C, const std::vector<ScalarFieldType>& V, const ColumnBundle* Cout)
+ColumnBundle Idag_DiagV_I_apply(const ColumnBundle& C, const std::vector<ScalarFieldType>& V, const ColumnBundle* Cout, bool singlePrecision=false)
 {	static StopWatch watch("Idag_DiagV_I"); watch.start();
 	ColumnBundle VC = Cout->similar(); VC.zero();
 	//Convert V to wfns grid if necessary:
@@ -243,6 +305,12 @@ ColumnBundle Idag_DiagV_I_apply(const ColumnBundle& C, const std::vector<ScalarF
 	const std::vector<ScalarFieldType>& Vwfns = Vtmp.size() ? Vtmp : V;
 	assert(Vwfns.size()==1 || Vwfns.size()==2 || Vwfns.size()==4);
 	if(Vwfns.size()==2) assert(!C.isSpinor());
+	#ifdef SINGLE_PRECISION_FFT
+	if(singlePrecision && Idag_DiagV_I_single(C, Vwfns, VC))
+	{	watch.stop();
+		return VC;
+	}
+	#endif
 	if(Vwfns.size()==1 || Vwfns.size()==2)
 	{	threadLaunch(isGpuEnabled()?1:0, Idag_DiagV_I_sub<ScalarFieldType>, C.nCols(), &C, &Vwfns, &VC);
 	}
@@ -256,8 +324,8 @@ ColumnBundle Idag_DiagV_I_apply(const ColumnBundle& C, const std::vector<ScalarF
 	return VC;
 }
 //Specialize template above for the two allowed cases:
-ColumnBundle Idag_DiagV_I(const ColumnBundle& C, const ScalarFieldArray& V, const ColumnBundle* Cout)
-{	return Idag_DiagV_I_apply<ScalarField>(C, V, Cout ? Cout : &C);
+ColumnBundle Idag_DiagV_I(const ColumnBundle& C, const ScalarFieldArray& V, const ColumnBundle* Cout, bool singlePrecision)
+{	return Idag_DiagV_I_apply<ScalarField>(C, V, Cout ? Cout : &C, singlePrecision);
 }
 ColumnBundle Idag_DiagV_I(const ColumnBundle& C, const std::vector<complexScalarField>& V, const ColumnBundle* Cout)
 {	return Idag_DiagV_I_apply<complexScalarField>(C, V, Cout ? Cout : &C);
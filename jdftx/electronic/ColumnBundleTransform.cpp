@@ -23,6 +23,8 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #include <core/LatticeUtils.h>
 #include <core/BlasExtra.h>
 #include <algorithm>
+#include <sys/mman.h>
+#include <unistd.h>
 
 ColumnBundleTransform::BasisWrapper::BasisWrapper(const Basis& basis) : basis(basis)
 {	//Determine bounds on iG:
@@ -115,12 +117,97 @@ void ColumnBundleTransform::gatherAxpy(complex alpha, const ColumnBundle& C_D, i
 				phase.dataPref(), true);
 }
 
+#ifndef GPU_ENABLED
+template<bool conj> inline complex conjIf(const complex& z) { return conj ? z.conj() : z; }
+
+//Scatter columns [bStart,bStop) of x to columns yStart + b*yStep of y, handling all spinor components
+//in a single pass over index and phase; coeff(sOut,sIn) is stored at coeff[sOut*nSpinor+sIn]
+template<bool conjx> void scatterColumns_sub(size_t bStart, size_t bStop, int nIndex, const int* index, const complex* phase, bool conjPhase,
+	int nSpinor, const complex* coeff, const complex* x, size_t xColLength, size_t xSpinorStride,
+	complex* y, size_t yStart, size_t yStep, size_t ySpinorStride)
+{	for(size_t b=bStart; b<bStop; b++)
+	{	const complex* xb = x + b*xColLength;
+		complex* yb = y + (yStart + b*yStep);
+		for(int i=0; i<nIndex; i++)
+		{	complex w = phase ? (conjPhase ? phase[i].conj() : phase[i]) : complex(1.,0.);
+			for(int sIn=0; sIn<nSpinor; sIn++)
+			{	complex xw = w * conjIf<conjx>(xb[sIn*xSpinorStride + i]);
+				for(int sOut=0; sOut<nSpinor; sOut++)
+					yb[sOut*ySpinorStride + index[i]] += coeff[sOut*nSpinor+sIn] * xw;
+			}
+		}
+	}
+}
+
+//Gather columns xStart + b*xStep of x to columns [bStart,bStop) of y (conventions as in scatterColumns_sub, with phase always conjugated)
+template<bool conjx> void gatherColumns_sub(size_t bStart, size_t bStop, int nIndex, const int* index, const complex* phase,
+	int nSpinor, const complex* coeff, const complex* x, size_t xStart, size_t xStep, size_t xSpinorStride,
+	complex* y, size_t yColLength, size_t ySpinorStride)
+{	for(size_t b=bStart; b<bStop; b++)
+	{	const complex* xb = x + (xStart + b*xStep);
+		complex* yb = y + b*yColLength;
+		for(int i=0; i<nIndex; i++)
+		{	complex w = phase ? phase[i].conj() : complex(1.,0.);
+			for(int sIn=0; sIn<nSpinor; sIn++)
+			{	complex xw = w * conjIf<conjx>(xb[sIn*xSpinorStride + index[i]]);
+				for(int sOut=0; sOut<nSpinor; sOut++)
+					yb[sOut*ySpinorStride + i] += coeff[sOut*nSpinor+sIn] * xw;
+			}
+		}
+	}
+}
+#endif
+
 void ColumnBundleTransform::scatterAxpy(complex alpha, const ColumnBundle& C_C, ColumnBundle& C_D, int bDstart, int bDstep) const
-{	for(int bC=0; bC<C_C.nCols(); bC++) scatterAxpy(alpha, C_C,bC, C_D,bDstart+bDstep*bC);
+{
+	#ifdef GPU_ENABLED
+	for(int bC=0; bC<C_C.nCols(); bC++) scatterAxpy(alpha, C_C,bC, C_D,bDstart+bDstep*bC);
+	#else
+	//Check inputs:
+	int nCols = C_C.nCols();
+	if(!nCols) return;
+	assert(C_C.colLength() == nSpinor*basisC.nbasis);
+	assert(C_D.colLength() == nSpinor*basisD.nbasis);
+	assert(bDstart >= 0 && bDstart < C_D.nCols());
+	assert(bDstart+bDstep*(nCols-1) >= 0 && bDstart+bDstep*(nCols-1) < C_D.nCols());
+	//Scatter all columns:
+	std::vector<complex> coeff(nSpinor*nSpinor);
+	for(int sD=0; sD<nSpinor; sD++)
+		for(int sC=0; sC<nSpinor; sC++)
+			coeff[sD*nSpinor+sC] = alpha*spinorRot(sD,sC);
+	size_t nWork = size_t(nCols) * index.nData() * nSpinor * nSpinor;
+	int nThreads = (bDstep==0 or nWork<100000) ? 1 : 0; //destination columns must be distinct across threads
+	threadLaunch(nThreads, (invert<0) ? scatterColumns_sub<true> : scatterColumns_sub<false>, nCols,
+		int(index.nData()), index.data(), phase.data(), invert<0, nSpinor, coeff.data(),
+		C_C.data(), C_C.colLength(), basisC.nbasis,
+		C_D.data(), C_D.index(bDstart,0), C_D.colLength()*bDstep, basisD.nbasis);
+	#endif
 }
 
 void ColumnBundleTransform::gatherAxpy(complex alpha, const ColumnBundle& C_D, int bDstart, int bDstep, ColumnBundle& C_C) const
-{	for(int bC=0; bC<C_C.nCols(); bC++) gatherAxpy(alpha, C_D,bDstart+bDstep*bC, C_C,bC);
+{
+	#ifdef GPU_ENABLED
+	for(int bC=0; bC<C_C.nCols(); bC++) gatherAxpy(alpha, C_D,bDstart+bDstep*bC, C_C,bC);
+	#else
+	//Check inputs:
+	int nCols = C_C.nCols();
+	if(!nCols) return;
+	assert(C_C.colLength() == nSpinor*basisC.nbasis);
+	assert(C_D.colLength() == nSpinor*basisD.nbasis);
+	assert(bDstart >= 0 && bDstart < C_D.nCols());
+	assert(bDstart+bDstep*(nCols-1) >= 0 && bDstart+bDstep*(nCols-1) < C_D.nCols());
+	//Gather all columns:
+	matrix spinorRotInv = (invert<0) ? transpose(spinorRot) : dagger(spinorRot);
+	std::vector<complex> coeff(nSpinor*nSpinor);
+	for(int sC=0; sC<nSpinor; sC++)
+		for(int sD=0; sD<nSpinor; sD++)
+			coeff[sC*nSpinor+sD] = alpha*spinorRotInv(sC,sD);
+	size_t nWork = size_t(nCols) * index.nData() * nSpinor * nSpinor;
+	threadLaunch((nWork<100000) ? 1 : 0, (invert<0) ? gatherColumns_sub<true> : gatherColumns_sub<false>, nCols,
+		int(index.nData()), index.data(), phase.data(), nSpinor, coeff.data(),
+		C_D.data(), C_D.index(bDstart,0), C_D.colLength()*bDstep, basisD.nbasis,
+		C_C.data(), C_C.colLength(), basisC.nbasis);
+	#endif
 }
 
 std::vector<matrix> ColumnBundleTransform::transformVdagC(const std::vector<matrix>& VdagC_C, int iSym) const
@@ -178,3 +265,126 @@ std::vector<matrix> ColumnBundleTransform::transformVdagC(const std::vector<matr
 	}
 	return VdagC_D;
 }
+
+
+//------------- ColumnBundleTransformCache -------------
+
+bool ColumnBundleTransformCache::Key::operator<(const ColumnBundleTransformCache::Key& other) const
+{	if(q!=other.q) return q<other.q;
+	if(iSym!=other.iSym) return iSym<other.iSym;
+	if(invert!=other.invert) return invert<other.invert;
+	return offset<other.offset;
+}
+
+ColumnBundleTransformCache::ColumnBundleTransformCache(size_t maxBytes, string spillPrefix)
+: maxBytes(maxBytes), spillPrefix(spillPrefix), nBytes(0), spillFd(-1), spillSize(0),
+	nHits(0), nMisses(0), nSpillReads(0), nEvictions(0), peakBytes(0)
+{
+}
+
+ColumnBundleTransformCache::~ColumnBundleTransformCache()
+{	if(spillFd >= 0) close(spillFd);
+}
+
+const ColumnBundle& ColumnBundleTransformCache::get(const ColumnBundleTransformCache::Key& key, const ColumnBundleTransform& transform,
+	const ColumnBundle& C_C, const Basis& basisD, const QuantumNumber& qnumD)
+{	static StopWatch watch("ColumnBundleTransformCache::get"); watch.start();
+	auto iter = entryMap.find(key);
+	if(iter != entryMap.end())
+	{	Entry& entry = *(iter->second);
+		nHits++;
+		if(!entry.C)
+		{	//Restore from spill file:
+			entry.C.init(entry.nCols, entry.colLength, &basisD, &qnumD, isGpuEnabled());
+			size_t len = entry.C.nData() * sizeof(complex);
+			void* map = mmap(0, len, PROT_READ, MAP_SHARED, spillFd, entry.spillOffset); //offsets are page-aligned
+			if(map == MAP_FAILED) die("Failed to memory-map unfolded wavefunction spill file.\n");
+			memcpy(entry.C.data(), map, len);
+			munmap(map, len);
+			nBytes += len;
+			nSpillReads++;
+		}
+		entries.splice(entries.begin(), entries, iter->second); //mark most recently used
+	}
+	else
+	{	//Compute and insert as most recently used:
+		nMisses++;
+		entries.push_front(Entry());
+		Entry& entry = entries.front();
+		entry.key = key;
+		entry.nCols = C_C.nCols();
+		entry.colLength = C_C.spinorLength() * basisD.nbasis;
+		entry.spillOffset = -1;
+		entry.C.init(entry.nCols, entry.colLength, &basisD, &qnumD, isGpuEnabled());
+		entry.C.zero();
+		transform.scatterAxpy(1., C_C, entry.C,0,1);
+		entryMap[key] = entries.begin();
+		nBytes += entry.C.nData() * sizeof(complex);
+	}
+	peakBytes = std::max(peakBytes, nBytes);
+	evict();
+	//Point to caller's basis and k-point (equivalent to those of any previous caller for this key):
+	ColumnBundle& C = entries.front().C;
+	C.basis = &basisD;
+	C.qnum = &qnumD;
+	watch.stop();
+	return C;
+}
+
+void ColumnBundleTransformCache::evict()
+{	auto iter = entries.end();
+	while(nBytes > maxBytes)
+	{	//Find least recently used resident entry, excluding the most recent one:
+		do { iter--; } while(iter!=entries.begin() && !iter->C);
+		if(iter == entries.begin()) break;
+		size_t len = iter->C.nData() * sizeof(complex);
+		if(spillPrefix.length())
+		{	if(iter->spillOffset < 0)
+			{	//Open spill file on first use (unlinked immediately, so that it is private and cleaned up automatically):
+				if(spillFd < 0)
+				{	string filename = spillPrefix + ".XXXXXX";
+					std::vector<char> buf(filename.begin(), filename.end()); buf.push_back(0);
+					spillFd = mkstemp(buf.data());
+					if(spillFd < 0) die("Failed to create unfolded wavefunction spill file with prefix '%s'.\n", spillPrefix.c_str());
+					unlink(buf.data());
+				}
+				//Write at page-aligned offset (entries are immutable, so this is done at most once per entry):
+				const long pageSize = sysconf(_SC_PAGESIZE);
+				iter->spillOffset = ceildiv(spillSize, off_t(pageSize)) * pageSize;
+				const char* data = (const char*)iter->C.data();
+				size_t nDone = 0;
+				while(nDone < len)
+				{	ssize_t nWritten = pwrite(spillFd, data+nDone, len-nDone, iter->spillOffset+nDone);
+					if(nWritten <= 0) die("Failed to write unfolded wavefunction spill file (disk full?).\n");
+					nDone += nWritten;
+				}
+				spillSize = iter->spillOffset + len;
+			}
+			iter->C.free();
+		}
+		else
+		{	entryMap.erase(iter->key);
+			iter = entries.erase(iter);
+		}
+		nBytes -= len;
+		nEvictions++;
+	}
+}
+
+void ColumnBundleTransformCache::clear()
+{	entries.clear();
+	entryMap.clear();
+	nBytes = 0;
+	if(spillFd >= 0)
+	{	if(ftruncate(spillFd, 0) != 0) die("Failed to truncate unfolded wavefunction spill file.\n");
+		spillSize = 0;
+	}
+}
+
+void ColumnBundleTransformCache::printStats(const char* name) const
+{	size_t stats[5] = { nHits, nMisses, nSpillReads, nEvictions, peakBytes };
+	mpiWorld->allReduce(stats, 5, MPIUtil::ReduceSum);
+	size_t nAccess = stats[0] + stats[1];
+	logPrintf("%s cache: %lu hits (%lu from spill), %lu misses (%.1lf%% hit rate), %lu evictions, %.1lf MB peak (all processes).\n",
+		name, stats[0], stats[2], stats[1], nAccess ? (stats[0]*100.)/nAccess : 0., stats[3], stats[4]/1e6);
+}
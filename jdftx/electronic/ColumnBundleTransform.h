@@ -20,10 +20,10 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #ifndef JDFTX_ELECTRONIC_COLUMNBUNDLETRANSFORM_H
 #define JDFTX_ELECTRONIC_COLUMNBUNDLETRANSFORM_H
 
-#include <electronic/Basis.h>
+#include <electronic/ColumnBundle.h>
 #include <core/matrix.h>
-
-class ColumnBundle;
+#include <list>
+#include <map>
 
 //! @addtogroup Operators
 //! @{
@@ -62,8 +62,10 @@ public:
 	void scatterAxpy(complex alpha, const ColumnBundle& C_C, int bC, ColumnBundle& C_D, int bD) const; //!< scatter-accumulate a single column
 	void gatherAxpy(complex alpha, const ColumnBundle& C_D, int bD, ColumnBundle& C_C, int bC) const; //!< gather-accumulate a single column
 	
-	void scatterAxpy(complex alpha, const ColumnBundle& C_C, ColumnBundle& C_D, int bDstart, int bDstep) const; //!< scatter-accumulate all columns of C_C
-	void gatherAxpy(complex alpha, const ColumnBundle& C_D, int bDstart, int bDstep, ColumnBundle& C_C) const; //!< gather-accumulate all columns of C_C
+	//! Scatter-accumulate all columns of C_C (in one pass over the index array per column, threaded over columns on the CPU)
+	void scatterAxpy(complex alpha, const ColumnBundle& C_C, ColumnBundle& C_D, int bDstart, int bDstep) const;
+	//! Gather-accumulate all columns of C_C (in one pass over the index array per column, threaded over columns on the CPU)
+	void gatherAxpy(complex alpha, const ColumnBundle& C_D, int bDstart, int bDstep, ColumnBundle& C_C) const;
 
 	//! Transform psp projection VdagC_C to VdagC_D.
 	//! Need iSym for spherical and atom transformations.
@@ -85,5 +87,60 @@ private:
 	friend class WannierMinimizer;
 };
 
+/**
+Bounded least-recently-used cache of ColumnBundles unfolded (scattered with a ColumnBundleTransform)
+from reduced k-points, for repeated use of the same transformed wavefunctions eg. in exact exchange and Wannier.
+Entries are identified by the source state, symmetry operation and inversion (and optionally an offset),
+and are never modified after creation. When the resident entries exceed maxBytes, the least recently used
+ones are dropped or, if spillPrefix is set, written once to a private spill file and memory-mapped back on reuse.
+The most recently used entry is always retained, so that maxBytes = 0 caches only the latest entry.
+*/
+class ColumnBundleTransformCache
+{
+public:
+	//! Identify an unfolded ColumnBundle
+	struct Key
+	{	int q; //!< source state index
+		int iSym; //!< symmetry operation index (as numbered by the caller)
+		int invert; //!< explicit inversion (+/-1)
+		vector3<int> offset; //!< reciprocal lattice vector offset of target k-point, if caller distinguishes these (else zero)
+		bool operator<(const Key& other) const;
+	};
+	
+	size_t maxBytes; //!< limit on memory used by resident entries
+	string spillPrefix; //!< if non-empty, spill evicted entries to a temporary file with this path prefix
+	
+	ColumnBundleTransformCache(size_t maxBytes=0, string spillPrefix=string());
+	~ColumnBundleTransformCache();
+	
+	//Non-copyable:
+	ColumnBundleTransformCache(const ColumnBundleTransformCache&)=delete;
+	ColumnBundleTransformCache& operator=(const ColumnBundleTransformCache&)=delete;
+	
+	//! Get all columns of C_C scattered by transform to basisD (with k-point qnumD), computing it only on a miss.
+	//! The returned ColumnBundle is valid till the next call to get() or clear().
+	const ColumnBundle& get(const Key& key, const ColumnBundleTransform& transform, const ColumnBundle& C_C,
+		const Basis& basisD, const QuantumNumber& qnumD);
+	
+	void clear(); //!< drop all entries (required whenever the source wavefunctions change); statistics are retained
+	void printStats(const char* name) const; //!< report hit / miss statistics summed over mpiWorld (collective)
+	
+private:
+	struct Entry
+	{	Key key;
+		int nCols; size_t colLength; //!< dimensions (needed to restore spilled entries)
+		ColumnBundle C; //!< resident data (null if evicted)
+		off_t spillOffset; //!< location in spill file (-1 if never spilled)
+	};
+	std::list<Entry> entries; //!< entries in order of most to least recently used
+	std::map<Key, std::list<Entry>::iterator> entryMap; //!< look-up of entries by key
+	size_t nBytes; //!< total size of resident entries
+	int spillFd; //!< spill file descriptor (-1 if not yet opened)
+	off_t spillSize; //!< current length of spill file
+	size_t nHits, nMisses, nSpillReads, nEvictions, peakBytes; //!< statistics
+	
+	void evict(); //!< drop / spill least recently used entries till within maxBytes
+};
+
 //! @}
 #endif //JDFTX_ELECTRONIC_COLUMNBUNDLETRANSFORM_H
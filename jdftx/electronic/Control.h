@@ -22,6 +22,7 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #define JDFTX_ELECTRONIC_CONTROL_H
 
 #include <core/vector3.h>
+#include <core/string.h>
 
 //! @addtogroup ElectronicDFT
 //! @{
@@ -43,6 +44,8 @@ public:
 	double davidsonBandRatio; //!< ratio of number of Davidson working bands to actual bands in system (>= 1)
 	int exxBlockSize; //!< number of bands per FFT block used in exact exchange
 	int nOuterVxx; //!< number of outer loop iterations used to converge ACE representation of exact exchange operator
+	double unfoldCacheMB; //!< memory limit (in MB per process) for caching symmetry-unfolded wavefunctions in exact exchange and Wannier
+	string unfoldCacheSpill; //!< if non-empty, path prefix for a temporary file that evicted unfolded wavefunctions spill to
 	
 	ElecEigenAlgo elecEigenAlgo; //!< Eigenvalue algorithm
 	BasisKdep basisKdep; //!< k-dependence of basis
@@ -68,7 +71,7 @@ public:
 	
 	Control()
 	:	fixed_H(false),
-		cacheProjectors(true), davidsonBandRatio(1.1), exxBlockSize(16), nOuterVxx(20),
+		cacheProjectors(true), davidsonBandRatio(1.1), exxBlockSize(16), nOuterVxx(20), unfoldCacheMB(512.),
 		elecEigenAlgo(ElecEigenDavidson), basisKdep(BasisKpointDep), Ecut(0), EcutRho(0), dragWavefunctions(true),
 		fluidGummel_nIterations(10), fluidGummel_Atol(1e-5),
 		shouldPrintEigsFillings(false), shouldPrintEcomponents(false), shouldPrintMuSearch(false), shouldPrintKpointsBasis(false),
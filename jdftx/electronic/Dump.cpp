@@ -33,7 +33,7 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #include <ctime>
 
 Dump::Dump()
-: potentialSubtraction(true), bandProjectionOrtho(false), bandProjectionNorm(true), Munfold(1,1,1), curIter(0)
+: potentialSubtraction(true), bandProjectionOrtho(false), bandProjectionNorm(true), transitionHistogramBin(0.001), Munfold(1,1,1), curIter(0)
 {
 }
 
@@ -64,6 +64,38 @@ void Dump::setup(const Everything& everything)
 }
 
 
+//Units of scalar field dump variables (recorded in the self-describing format header)
+static string fieldUnits(const string& name)
+{	static const std::set<string> densities = { "n", "nAccum", "nCore", "Nion", "nbound", "dn", "dn-q", "dn+q" };
+	static const std::set<string> potentials = { "d_vac", "d_fluid", "d_tot", "V_cavity", "V_fluidTot", "Vlocps", "Vscloc", "VsclocDisc",
+		"dVext", "dVext-q", "dVext+q", "dVscloc", "dVscloc-q", "dVscloc+q" };
+	if(densities.count(name)) return "electrons/bohr^3";
+	if(potentials.count(name)) return "Eh";
+	if(name=="tau" or name=="tauW") return "Eh/bohr^3";
+	if(name.substr(0,2)=="N_") return "bohr^-3"; //fluid site densities
+	return string();
+}
+
+void Dump::saveField(const ScalarField& X, const string& fname, const string& varName) const
+{	if(!fieldFormat)
+	{	if(mpiWorld->isHead()) saveRawBinary(X, fname.c_str());
+		return;
+	}
+	//Separate spin channel suffix, if any:
+	string name = varName, spin = "none";
+	for(const string suffix: { "up", "dn", "re", "im" })
+		if(name.length() > 3 and name.substr(name.length()-3) == "_"+suffix)
+		{	spin = suffix;
+			name = name.substr(0, name.length()-3);
+			break;
+		}
+	::saveField(X, fname.c_str(), *fieldFormat, name, spin, fieldUnits(name));
+}
+
+void Dump::saveField(const complexScalarField& X, const string& fname, const string& varName) const
+{	if(mpiWorld->isHead()) saveRawBinary(X, fname.c_str());
+}
+
 void Dump::operator()(DumpFrequency freq, int iter)
 {
 	if(!checkInterval(freq, iter)) return; // => don't dump this time
@@ -98,7 +130,7 @@ void Dump::operator()(DumpFrequency freq, int iter)
 
 	#define DUMP_nocheck(object, prefix) \
 		{	StartDump(prefix) \
-			if(mpiWorld->isHead()) saveRawBinary(object, fname.c_str()); \
+			saveField(object, fname, prefix); \
 			EndDump \
 		}
 	
@@ -486,47 +518,52 @@ void Dump::operator()(DumpFrequency freq, int iter)
 		EndDump
 	}
 	
-	if(ShouldDump(Momenta) or ShouldDump(Velocities) or ShouldDump(FermiVelocity))
+	if(ShouldDump(Momenta) or ShouldDump(Velocities) or ShouldDump(FermiVelocity) or ShouldDump(TransitionHistogram))
 	{
-		//Common code: compute matrix elements:
-		std::vector<matrix> momenta(eInfo.nStates); //full matrices
+		//Common code: compute matrix elements one state at a time, streaming full matrices to file / histogram:
 		std::vector<std::vector<vector3<>>> v(eInfo.nStates, std::vector<vector3<>>(eInfo.nBands)); //diagonal parts
-		bool needFull = ShouldDump(Momenta); //whether full matrices are needed
+		bool needFull = ShouldDump(Momenta) or ShouldDump(TransitionHistogram); //whether full matrices are needed
+		std::shared_ptr<StateRecordWriter> momentaWriter;
+		std::shared_ptr<TransitionHistogram> histogram;
+		string fnameMomenta = getFilename("momenta");
+		if(ShouldDump(Momenta))
+		{	logPrintf("Dumping '%s' ... ", fnameMomenta.c_str()); logFlush();
+			momentaWriter = std::make_shared<StateRecordWriter>(eInfo, fnameMomenta.c_str(), sizeof(complex), eInfo.nBands*eInfo.nBands*3);
+		}
+		if(ShouldDump(TransitionHistogram))
+			histogram = std::make_shared<TransitionHistogram>(*e, transitionHistogramBin);
 		for(int q=eInfo.qStart; q<eInfo.qStop; q++) //kpoint/spin
-		{	if(needFull) momenta[q] = zeroes(eInfo.nBands, eInfo.nBands*3);
+		{	matrix Pq; if(needFull) Pq = zeroes(eInfo.nBands, eInfo.nBands*3);
 			for(int iDir=0; iDir<3; iDir++) //cartesian direction
 			{	matrix Pqk = complex(0,-1) * iInfo.rHcommutator(eVars.C[q], iDir, eVars.Hsub_eigs[q]);
 				if(needFull)
-					momenta[q].set(0,eInfo.nBands, eInfo.nBands*iDir,eInfo.nBands*(iDir+1), Pqk);
+					Pq.set(0,eInfo.nBands, eInfo.nBands*iDir,eInfo.nBands*(iDir+1), Pqk);
 				for(int b=0; b<eInfo.nBands; b++)
 					v[q][b][iDir] = Pqk(b,b).real();
 			}
+			if(momentaWriter) momentaWriter->write(q, Pq);
+			if(histogram) histogram->add(q, Pq);
 		}
 		
-		//Output full momentum matrix elements:
-		if(ShouldDump(Momenta))
-		{	StartDump("momenta")
-			eInfo.write(momenta, fname.c_str(), eInfo.nBands, eInfo.nBands*3);
+		//Complete full momentum matrix element output:
+		if(momentaWriter)
+		{	momentaWriter = 0; //closes file
+			EndDump
+		}
+		
+		//Output joint density of states and oscillator strength histogram:
+		if(histogram)
+		{	StartDump("transitionHistogram")
+			histogram->write(fname.c_str());
 			EndDump
 		}
 		
 		//Output diagonal band-velocity matrix elements:
 		if(ShouldDump(Velocities))
 		{	StartDump("velocities")
-			FILE* fp;
-			if(mpiWorld->isHead())
-			{	fp = fopen(fname.c_str(), "w");
-				if(!fp) die_alone("Error opening %s for writing.\n", fname.c_str());
-				for(int q=0; q<eInfo.nStates; q++)
-				{	if(not eInfo.isMine(q)) mpiWorld->recvData(v[q], eInfo.whose(q), q);
-					fwrite(v[q].data(), sizeof(vector3<>), eInfo.nBands, fp);
-				}
-				fclose(fp);
-			}
-			else
-			{	for(int q=eInfo.qStart; q<eInfo.qStop; q++)
-					mpiWorld->sendData(v[q], 0, q);
-			} 
+			StateRecordWriter velocitiesWriter(eInfo, fname.c_str(), sizeof(vector3<>), eInfo.nBands);
+			for(int q=eInfo.qStart; q<eInfo.qStop; q++)
+				velocitiesWriter.write(q, v[q]);
 			EndDump
 		}
 		
@@ -51,7 +51,7 @@ enum DumpVariable { DumpNone, DumpState, //None or exactly those required to res
 	DumpEcomponents, DumpExcCompare,
  	DumpBoundCharge, DumpSolvationRadii, DumpQMC, DumpOcean, DumpBGW, DumpRealSpaceWfns, DumpFluidDebug, DumpSlabEpsilon, DumpBulkEpsilon, DumpChargedDefect,
 	DumpDOS, DumpPolarizability, DumpElectronScattering, DumpSIC, DumpDipole, DumpStress, DumpExcitations, DumpFCI, DumpSpin,
-	DumpMomenta, DumpVelocities, DumpFermiVelocity, DumpR, DumpL, DumpQ, DumpBerry,
+	DumpMomenta, DumpVelocities, DumpFermiVelocity, DumpTransitionHistogram, DumpR, DumpL, DumpQ, DumpBerry,
 	DumpSymmetries, DumpKpoints, DumpGvectors, DumpOrbitalDep, DumpXCanalysis, DumpEresolvedDensity, DumpFermiDensity,
 	DumpDWfns, DumpDn, DumpDVext, DumpDVscloc,
 	DumpDelim //special value used as a delimiter during command processing
@@ -75,6 +75,11 @@ public:
 	//! Check whether to dump at given frequency and iteration:
 	bool checkInterval(DumpFrequency freq, int iter) const;
 	
+	//! Save scalar field variable varName (with optional _up/_dn/_re/_im spin suffix) to fname,
+	//! in the format selected by dump-field-format (collective call; legacy raw binary written from head by default)
+	void saveField(const ScalarField& X, const string& fname, const string& varName) const;
+	void saveField(const complexScalarField& X, const string& fname, const string& varName) const; //!< complex fields are always written as legacy raw binary
+	
 	std::shared_ptr<class DOS> dos; //!< density-of-states calculator
 	std::shared_ptr<struct Polarizability> polarizability; //!< electronic polarizability calculator
 	std::shared_ptr<struct ElectronScattering> electronScattering; //!< electron-electron scattering calculator
@@ -87,7 +92,10 @@ public:
 	std::shared_ptr<struct DumpCprime> dumpCprime; //!< dC/dk calculator, if needed
 	bool potentialSubtraction; //!< whether to subtract neutral-atom potentials in Dvac and Dtot output
 	bool bandProjectionOrtho, bandProjectionNorm; //!< whether band projections use ortho-orbitals and are complex/norm-only
+	double transitionHistogramBin; //!< energy bin width for the transition histogram output
 	matrix3<int> Munfold; //!< transformation matrix for band structure unfolding
+	std::shared_ptr<struct FieldFormat> fieldFormat; //!< self-describing (optionally compressed) format for scalar field output, legacy raw binary if null
+	string telemetryTarget; //!< file or named pipe for per-iteration telemetry records (none if empty)
 private:
 	const Everything* e;
 	string format; //!< Filename format containing $VAR, $STAMP, $FREQ etc.
@@ -96,6 +104,7 @@ private:
 	std::map<DumpFrequency,int> interval; //!< for each frequency, dump every interval times
 	std::map<DumpFrequency,string> formatFreq; //!< frequency-dependent format override
 	friend class Phonon;
+	friend class NEB;
 	friend class DefectSupercell;
 	friend struct CommandDump;
 	friend struct CommandDumpName;
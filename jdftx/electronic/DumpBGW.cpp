@@ -129,39 +129,48 @@ void BGW::writeWfn() const
 	else //Default output of bands from usual totalE / bandstructure calculation
 	{	//Create dataset (must happen on all processes together):
 		hsize_t dims[4] = { hsize_t(nBands), hsize_t(nSpins*nSpinor), iGarr.size(), 2 };
-		hid_t sid = H5Screate_simple(4, dims, NULL);
-		hid_t did = H5Dcreate(gidWfns, "coeffs", H5T_NATIVE_DOUBLE, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+		hsize_t chunkDims[4] = { hsize_t(std::min(nBands, bgwp.chunkBands)), 1, std::min(hsize_t(iGarr.size()), hsize_t(nBasisMax)), 2 };
+		hid_t did = createDataset(gidWfns, "coeffs", 4, dims, chunkDims);
 		hid_t plid = H5Pcreate(H5P_DATASET_XFER);
-		H5Sclose(sid);
-		//Loop over k, bands and spin/spinors:
-		hsize_t offset[4] = { 0, 0, 0, 0 };
-		hsize_t count[4] = { 1, 1, 1, 2 };
-		std::vector<complex> buffer(*std::max_element(nBasis.begin(), nBasis.end()));
+		H5Pset_dxpl_mpio(plid, H5FD_MPIO_COLLECTIVE);
+		//Each process writes all bands and spinor components of its states directly,
+		//with one collective write per state (processes with fewer states participate with empty selections):
+		H5DatasetTimer timer("wfns/coeffs");
+		int nStatesMine = eInfo.qStop - eInfo.qStart;
+		int nStatesMax = nStatesMine; mpiWorld->allReduce(nStatesMax, MPIUtil::ReduceMax);
 		double volScaleFac = sqrt(gInfo.detR);
-		for(int iSpin=0; iSpin<nSpins; iSpin++)
-		for(int iSpinor=0; iSpinor<nSpinor; iSpinor++)
-		{	offset[1] = iSpin*nSpinor + iSpinor;
-			for(int ik=0; ik<nReducedKpts; ik++)
-			{	int q=iSpin*nReducedKpts+ik;
-				if(!eInfo.isMine(q)) continue;
-				count[2] = nBasis[ik];
-				offset[2] = nBasisPrev[ik];
+		for(int iState=0; iState<nStatesMax; iState++)
+		{	hid_t sid = H5Dget_space(did);
+			if(iState < nStatesMine)
+			{	int q = eInfo.qStart + iState;
+				int iSpin = q / nReducedKpts;
+				int ik = q % nReducedKpts;
+				//Copy to buffer and scale (layout of C[q] matches bands x spinors x G-vectors in dataset):
+				const ColumnBundle& Cq = eVars.C[q];
+				std::vector<complex> buffer(Cq.nData());
+				eblas_copy(buffer.data(), Cq.data(), buffer.size());
+				eblas_zdscal(buffer.size(), volScaleFac, buffer.data(), 1);
+				//Write buffer to HDF5:
+				hsize_t offset[4] = { 0, hsize_t(iSpin*nSpinor), hsize_t(nBasisPrev[ik]), 0 };
+				hsize_t count[4] = { hsize_t(nBands), hsize_t(nSpinor), hsize_t(nBasis[ik]), 2 };
+				H5Sselect_hyperslab(sid, H5S_SELECT_SET, offset, NULL, count, NULL);
 				hid_t sidMem = H5Screate_simple(4, count, NULL);
-				for(int b=0; b<nBands; b++)
-				{	offset[0] = b;
-					sid = H5Dget_space(did);
-					H5Sselect_hyperslab(sid, H5S_SELECT_SET, offset, NULL, count, NULL);
-					//Copy to buffer and scale:
-					eblas_copy(buffer.data(), eVars.C[q].data()+eVars.C[q].index(b, iSpinor*nBasis[ik]), nBasis[ik]);
-					eblas_zdscal(nBasis[ik], volScaleFac, buffer.data(), 1);
-					//Write buffer to HDF5:
-					H5Dwrite(did, H5T_NATIVE_DOUBLE, sidMem, sid, plid, buffer.data());
-				}
+				timer.start();
+				H5Dwrite(did, H5T_NATIVE_DOUBLE, sidMem, sid, plid, buffer.data());
+				timer.stop(buffer.size()*sizeof(complex));
 				H5Sclose(sidMem);
 			}
+			else
+			{	H5Sselect_none(sid);
+				timer.start();
+				H5Dwrite(did, H5T_NATIVE_DOUBLE, sid, sid, plid, NULL);
+				timer.stop(0);
+			}
+			H5Sclose(sid);
 		}
 		H5Pclose(plid);
 		H5Dclose(did);
+		timer.report();
 	}
 	H5Gclose(gidWfns);
 	
@@ -292,6 +301,32 @@ hid_t BGW::openHDF5(string fname) const
 }
 
 
+//Create double-precision dataset, chunked and optionally compressed:
+hid_t BGW::createDataset(hid_t gid, const char* name, int rank, const hsize_t* dims, const hsize_t* chunkDims) const
+{	hid_t plid = H5Pcreate(H5P_DATASET_CREATE);
+	if(chunkDims)
+	{	H5Pset_chunk(plid, rank, chunkDims);
+		if(bgwp.compressLevel) H5Pset_deflate(plid, bgwp.compressLevel); //requires collective writes in parallel HDF5
+	}
+	hid_t sid = H5Screate_simple(rank, dims, NULL);
+	hid_t did = H5Dcreate(gid, name, H5T_NATIVE_DOUBLE, sid, H5P_DEFAULT, plid, H5P_DEFAULT);
+	H5Sclose(sid);
+	H5Pclose(plid);
+	if(did<0) die("Could not create dataset '%s' in HDF5 file.\n", name);
+	return did;
+}
+
+
+//Report write statistics of a dataset:
+void H5DatasetTimer::report()
+{	mpiWorld->allReduce(nBytes, MPIUtil::ReduceSum);
+	mpiWorld->allReduce(tWrite, MPIUtil::ReduceMax);
+	logPrintf("\n\tWrote dataset '%s': %.1lf MB in %.2lf s (%.1lf MB/s) ", name.c_str(),
+		nBytes*1e-6, tWrite, tWrite ? nBytes*1e-6/tWrite : 0.);
+	logFlush();
+}
+
+
 //Write common HDF5 header specifying the mean-field claculation for BGW outputs
 void BGW::writeHeaderMF(hid_t fid) const
 {
@@ -196,12 +196,11 @@ void BGW::denseWriteWfn(hid_t gidWfns)
 	//Create dataset (must happen on all processes together):
 	hsize_t nGtot = nBasisPrev.back() + nBasis.back();
 	hsize_t dims[4] = { hsize_t(nBands), hsize_t(nSpins*nSpinor), nGtot, 2 };
-	hid_t sid = H5Screate_simple(4, dims, NULL);
-	hid_t did = H5Dcreate(gidWfns, "coeffs", H5T_NATIVE_DOUBLE, sid, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+	hsize_t chunkDims[4] = { hsize_t(std::min(nBands, bgwp.chunkBands)), 1, std::min(nGtot, hsize_t(nBasisMax)), 2 };
+	hid_t did = createDataset(gidWfns, "coeffs", 4, dims, chunkDims);
 	hid_t plid = H5Pcreate(H5P_DATASET_XFER);
-	H5Pset_dxpl_mpio(plid, H5FD_MPIO_INDEPENDENT);
-	H5Sclose(sid);
-	H5Fflush(gidWfns, H5F_SCOPE_GLOBAL);
+	H5Pset_dxpl_mpio(plid, H5FD_MPIO_COLLECTIVE); //all processes write their column blocks of each state together
+	H5DatasetTimer timer("wfns/coeffs");
 	
 	//Loop over states:
 	for(int iSpin=0; iSpin<nSpins; iSpin++)
@@ -408,12 +407,20 @@ void BGW::denseWriteWfn(hid_t gidWfns)
 		//Select destination in hdf5 file and wwrite from buffer:
 		hsize_t offset[4] = { hsize_t(iFullColStart), hsize_t(iSpin), hsize_t(nBasisPrev[ik]), 0 };
 		hsize_t count[4] = { hsize_t(nFullColsMine), 1, hsize_t(nRows), 2 };
-		sid = H5Dget_space(did);
-		H5Sselect_hyperslab(sid, H5S_SELECT_SET, offset, NULL, count, NULL);
-		hid_t sidMem = H5Screate_simple(4, count, NULL);
-		H5Dwrite(did, H5T_NATIVE_DOUBLE, sidMem, sid, plid, buf.data());
-		H5Sclose(sidMem);
-		H5Fflush(gidWfns, H5F_SCOPE_GLOBAL);
+		hid_t sid = H5Dget_space(did);
+		timer.start();
+		if(nFullColsMine)
+		{	H5Sselect_hyperslab(sid, H5S_SELECT_SET, offset, NULL, count, NULL);
+			hid_t sidMem = H5Screate_simple(4, count, NULL);
+			H5Dwrite(did, H5T_NATIVE_DOUBLE, sidMem, sid, plid, buf.data());
+			H5Sclose(sidMem);
+		}
+		else //participate in collective write with empty selection
+		{	H5Sselect_none(sid);
+			H5Dwrite(did, H5T_NATIVE_DOUBLE, sid, sid, plid, NULL);
+		}
+		timer.stop(buf.nData()*sizeof(complex));
+		H5Sclose(sid);
 		buf = 0; //cleanup
 		watchIO.stop();
 		
@@ -431,6 +438,7 @@ void BGW::denseWriteWfn(hid_t gidWfns)
 	}
 	H5Pclose(plid);
 	H5Dclose(did);
+	timer.report(); logPrintf("\n");
 	
 	//Update fillings if necessary:
 	if(eInfo.fillingsUpdate == ElecInfo::FillingsHsub)
@@ -36,6 +36,8 @@ struct BGWparams
 	bool saveVxx; //!< whether to write exact-exchange matrix elements
 	bool rpaExx; //!< whether to compute RPA-consistent exact-exchange energy
 	bool offDiagV; //!< whether to write off-diagonal matrix elements of Vxc and/or Vxx (default: false)
+	int chunkBands; //!< number of bands per HDF5 chunk of the wavefunction coefficients
+	int compressLevel; //!< deflate compression level (0-9) for wavefunction coefficients (disabled if 0)
 
 	double EcutChiFluid; //!< KE cutoff for fluid polarizability output (enabled if non-zero)
 	bool elecOnly; //!< whether to only output electronic polarizability of fluid (default: true)
@@ -51,7 +53,7 @@ struct BGWparams
 	bool kernelSym_rALDA; //!< whether to use kernel symmetrization for rALDA (wavevector symmetrization if false, the default)
 	
 	BGWparams() : nBandsDense(0), blockSize(32), clusterSize(10), nBandsV(0),
-		saveVxc(true), saveVxx(false), rpaExx(false), offDiagV(false),
+		saveVxc(true), saveVxx(false), rpaExx(false), offDiagV(false), chunkBands(32), compressLevel(0),
 		EcutChiFluid(0.), elecOnly(true),
 		freqReMax_eV(30.), freqReStep_eV(1.), freqBroaden_eV(0.1),
 		freqNimag(25), freqPlasma(1.),
@@ -65,6 +67,17 @@ struct BGWparams
 #include <electronic/Everything.h>
 #include <core/H5io.h>
 
+//! Accumulate time and data volume of writes to one HDF5 dataset, and report totals over all processes
+class H5DatasetTimer
+{	string name;
+	double tStart, tWrite, nBytes;
+public:
+	H5DatasetTimer(string name) : name(name), tStart(0.), tWrite(0.), nBytes(0.) {}
+	void start() { tStart = clock_sec(); }
+	void stop(size_t nBytesWritten) { tWrite += clock_sec() - tStart; nBytes += nBytesWritten; }
+	void report(); //!< Collectively print write statistics
+};
+
 //! Helper class for DumpBGW
 //Methods implemented in DumpBGW.cpp except where indicated otherwise
 class BGW
@@ -93,6 +106,7 @@ class BGW
 	std::vector<diagMatrix> VxcDiag, VxxDiag; //!< diagonal parts of the above
 	
 	hid_t openHDF5(string fname) const; //!< Open HDF5 file for collective access
+	hid_t createDataset(hid_t gid, const char* name, int rank, const hsize_t* dims, const hsize_t* chunkDims=0) const; //!< Create double dataset, chunked and optionally compressed (if chunkDims non-null)
 	void writeHeaderMF(hid_t fid) const; //!< Write common HDF5 header specifying the mean-field claculation for BGW outputs
 	void writeHeaderEps(hid_t gidHeader, bool write_q0, string mode,
 		std::vector<vector3<>>& q, std::vector<complex>& freq,
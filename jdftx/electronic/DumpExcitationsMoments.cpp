@@ -93,17 +93,31 @@ void dumpExcitations(const Everything& e, const char* filename)
 		if(eigs[q][HOMO]   > maxHOMO) { maxHOMOq = q; maxHOMOn = HOMO;   maxHOMO = eigs[q][HOMO];   }
 		if(eigs[q][HOMO+1] < minLUMO) { minLUMOq = q; minLUMOn = HOMO+1; minLUMO = eigs[q][HOMO+1]; }
 		
-		for(int o=HOMO; o>=0; o--)
-		{	for(int u=(HOMO+1); u<e.eInfo.nBands; u++)
-			{	vector3<> dreal, dimag, dnorm;
-				for(int iDir=0; iDir<3; iDir++)
-				{	complex xi = integral(I(e.eVars.C[q].getColumn(u,0)) * r[iDir] * I(e.eVars.C[q].getColumn(o,0)));
-					dreal[iDir] = xi.real();
-					dimag[iDir] = xi.imag();
-					dnorm[iDir] = xi.abs();
+		//Real-space wavefunctions, transformed in blocks of unoccupied bands (bounded memory),
+		//so that each unoccupied band is transformed once and each occupied band once per block:
+		const int uBlockSize = 16;
+		int nUnocc = e.eInfo.nBands - (HOMO+1);
+		size_t qOffset = excitations.size();
+		excitations.resize(qOffset + (HOMO+1)*nUnocc, excitation(q, 0, 0, 0., 0., 0., 0.)); //same order as o, u loops below
+		for(int uStart=HOMO+1; uStart<e.eInfo.nBands; uStart+=uBlockSize)
+		{	int uStop = std::min(uStart+uBlockSize, e.eInfo.nBands);
+			std::vector<complexScalarField> Ipsi_u(uStop-uStart);
+			for(int u=uStart; u<uStop; u++)
+				Ipsi_u[u-uStart] = I(e.eVars.C[q].getColumn(u,0));
+			for(int o=HOMO; o>=0; o--)
+			{	complexScalarField Ipsi_o = I(e.eVars.C[q].getColumn(o,0));
+				for(int u=uStart; u<uStop; u++)
+				{	vector3<> dreal, dimag, dnorm;
+					complexScalarField IpsiPair = Ipsi_u[u-uStart] * Ipsi_o;
+					for(int iDir=0; iDir<3; iDir++)
+					{	complex xi = integral(IpsiPair * r[iDir]);
+						dreal[iDir] = xi.real();
+						dimag[iDir] = xi.imag();
+						dnorm[iDir] = xi.abs();
+					}
+					double dE = eigs[q][u]-eigs[q][o]; //Excitation energy
+					excitations[qOffset + (HOMO-o)*nUnocc + (u-HOMO-1)] = excitation(q, o, u, dE, dreal.length_squared(), dimag.length_squared(), dnorm.length_squared());
 				}
-				double dE = eigs[q][u]-eigs[q][o]; //Excitation energy
-				excitations.push_back(excitation(q, o, u, dE, dreal.length_squared(), dimag.length_squared(), dnorm.length_squared()));
 			}
 		}
 	}
@@ -647,58 +661,198 @@ void dumpProjections(const Everything& e, const char* filename, bool ortho, bool
 {	const ElecVars& eVars = e.eVars;
 	const ElecInfo& eInfo = e.eInfo;
 	const IonInfo& iInfo = e.iInfo;
-	FILE* fp = 0;
-	if(mpiWorld->isHead())
-	{	fp = fopen(filename, "w");
-		//Write header:
-		fprintf(fp, "%d states, %d bands, %d %sorbital-projections, %lu species\n",
+	//Header (identical on all processes):
+	ostringstream ossHeader;
+	{	char buf[256];
+		sprintf(buf, "%d states, %d bands, %d %sorbital-projections, %lu species\n",
 			eInfo.nStates, eInfo.nBands, iInfo.nAtomicOrbitals(),
 			(ortho ? "ortho-" : ""), iInfo.species.size());
-		fprintf(fp, "# Symbol nAtoms nOrbitalsPerAtom lMax nShells(l=0) ... nShells(l=lMax)\n");
+		ossHeader << buf << "# Symbol nAtoms nOrbitalsPerAtom lMax nShells(l=0) ... nShells(l=lMax)\n";
 		for(const auto& sp: iInfo.species)
 		{	int nAtoms = sp->atpos.size();
 			int nOrbitalsPerAtom = sp->nAtomicOrbitals() / nAtoms;
 			int lMax = sp->lMaxAtomicOrbitals();
-			fprintf(fp, "%s %d %d %d", sp->name.c_str(), nAtoms, nOrbitalsPerAtom, lMax);
+			ossHeader << sp->name << ' ' << nAtoms << ' ' << nOrbitalsPerAtom << ' ' << lMax;
 			for(int l=0; l<=lMax; l++)
-				fprintf(fp, " %d", sp->nAtomicOrbitals(l));
-			fprintf(fp, "\n");
+				ossHeader << ' ' << sp->nAtomicOrbitals(l);
+			ossHeader << '\n';
 		}
 	}
-	for(int q=0; q<eInfo.nStates; q++)
+	//Format projections of local states, one state at a time:
+	ostringstream oss;
+	for(int q=eInfo.qStart; q<eInfo.qStop; q++)
 	{	matrix proj; //orbitals: nOrbitals x nBands
-		if(eInfo.isMine(q))
-		{	if(ortho)
-			{	ColumnBundle psi = iInfo.getAtomicOrbitals(q, false);
-				ColumnBundle Opsi = O(psi);
-				matrix orthoMat = invsqrt(psi ^ Opsi); //orthonormalizing matrix
-				proj = orthoMat * (Opsi ^ eVars.C[q]);
-			}
-			else proj = iInfo.getAtomicOrbitals(q, true) ^ eVars.C[q]; //dagger(Opsi).Cq
-			if(not mpiWorld->isHead()) mpiWorld->sendData(proj, 0, q); //send to head for writing
+		if(ortho)
+		{	ColumnBundle psi = iInfo.getAtomicOrbitals(q, false);
+			ColumnBundle Opsi = O(psi);
+			matrix orthoMat = invsqrt(psi ^ Opsi); //orthonormalizing matrix
+			proj = orthoMat * (Opsi ^ eVars.C[q]);
 		}
-		if(mpiWorld->isHead())
-		{	if(not eInfo.isMine(q)) //recv from process that stored q
-			{	proj.init(iInfo.nAtomicOrbitals(), eInfo.nBands);
-				mpiWorld->recvData(proj, eInfo.whose(q), q);
-			}
-			//Write projections:
-			fprintf(fp, "# ");
-			eInfo.kpointPrint(fp, q, true);
-			fprintf(fp, "; lines per band, with %s per orbital:\n",
-				norm ? "|projection|^2" : "projectionRe, projectionIm");
-			complex* projData = proj.data();
-			for(int b=0; b<proj.nCols(); b++) //bands
-			{	for(int a=0; a<proj.nRows(); a++) //orbitals
-				{	if(norm)
-						fprintf(fp, "%9.7lf ", projData->norm()); //write |projection|^2
-					else
-						fprintf(fp, "%9.7lf %9.7lf ", projData->real(), projData->imag()); //write complex projection
-					projData++;
-				}
-				fprintf(fp, "\n");
+		else proj = iInfo.getAtomicOrbitals(q, true) ^ eVars.C[q]; //dagger(Opsi).Cq
+		//Write projections:
+		char* kpointBuf = 0; size_t kpointLen = 0;
+		FILE* fpBuf = open_memstream(&kpointBuf, &kpointLen); //buffer grows to fit
+		fprintf(fpBuf, "# ");
+		eInfo.kpointPrint(fpBuf, q, true);
+		fclose(fpBuf);
+		oss << kpointBuf << "; lines per band, with " << (norm ? "|projection|^2" : "projectionRe, projectionIm") << " per orbital:\n";
+		free(kpointBuf);
+		char buf[64];
+		const complex* projData = proj.data();
+		for(int b=0; b<proj.nCols(); b++) //bands
+		{	for(int a=0; a<proj.nRows(); a++) //orbitals
+			{	if(norm)
+					sprintf(buf, "%9.7lf ", projData->norm()); //write |projection|^2
+				else
+					sprintf(buf, "%9.7lf %9.7lf ", projData->real(), projData->imag()); //write complex projection
+				oss << buf;
+				projData++;
 			}
+			oss << '\n';
+		}
+	}
+	string header = ossHeader.str();
+	string local = oss.str();
+#if MPI_SAFE_WRITE
+	//Safe mode / write from head:
+	if(mpiWorld->isHead())
+	{	FILE* fp = fopen(filename, "w");
+		if(!fp) die_alone("Error opening %s for writing.\n", filename);
+		fputs(header.c_str(), fp);
+		fputs(local.c_str(), fp);
+		for(int jProcess=1; jProcess<mpiWorld->nProcesses(); jProcess++)
+		{	string buf; mpiWorld->recv(buf, jProcess, 0);
+			fputs(buf.c_str(), fp);
+		}
+		fclose(fp);
+	}
+	else mpiWorld->send(local, 0, 0);
+#else
+	//Collective write using MPI I/O, with offsets from the text length on each process:
+	std::vector<size_t> nBytes(mpiWorld->nProcesses(), 0);
+	nBytes[mpiWorld->iProcess()] = local.length();
+	mpiWorld->allReduceData(nBytes, MPIUtil::ReduceSum);
+	size_t offset = header.length();
+	for(int jProcess=0; jProcess<mpiWorld->iProcess(); jProcess++)
+		offset += nBytes[jProcess];
+	MPIUtil::File fp; mpiWorld->fopenWrite(fp, filename);
+	if(mpiWorld->isHead()) mpiWorld->fwrite(header.data(), sizeof(char), header.length(), fp);
+	mpiWorld->fseek(fp, offset, SEEK_SET);
+	mpiWorld->fwrite(local.data(), sizeof(char), local.length(), fp);
+	mpiWorld->fclose(fp);
+#endif
+}
+
+//---------------------------- Streamed per-state output ------------------------------------
+
+StateRecordWriter::StateRecordWriter(const ElecInfo& eInfo, const char* fname, size_t elemSize, size_t nElemPerRecord)
+: eInfo(eInfo), elemSize(elemSize), nElemPerRecord(nElemPerRecord), recordBytes(elemSize*nElemPerRecord)
+{
+#if MPI_SAFE_WRITE
+	fp = 0;
+	if(mpiWorld->isHead())
+	{	fp = fopen(fname, "w");
+		if(!fp) die_alone("Error opening file '%s' for writing.\n", fname);
+	}
+	else buf.reserve((eInfo.qStop-eInfo.qStart) * recordBytes);
+#else
+	mpiWorld->fopenWrite(fp, fname);
+	mpiWorld->fseek(fp, eInfo.qStart*recordBytes, SEEK_SET);
+#endif
+}
+
+StateRecordWriter::~StateRecordWriter()
+{
+#if MPI_SAFE_WRITE
+	if(mpiWorld->isHead())
+	{	std::vector<char> bufRecv(recordBytes);
+		for(int q=eInfo.qStop; q<eInfo.nStates; q++)
+		{	mpiWorld->recvData(bufRecv, eInfo.whose(q), q);
+			fwriteLE(bufRecv.data(), elemSize, nElemPerRecord, fp);
 		}
+		fclose(fp);
 	}
-	if(mpiWorld->isHead()) fclose(fp);
+	else
+	{	for(int q=eInfo.qStart; q<eInfo.qStop; q++)
+			mpiWorld->send(buf.data()+(q-eInfo.qStart)*recordBytes, recordBytes, 0, q);
+	}
+#else
+	mpiWorld->fclose(fp);
+#endif
+}
+
+void StateRecordWriter::write(int q, const matrix& M)
+{	assert(elemSize == sizeof(complex));
+	assert(size_t(M.nData()) == nElemPerRecord);
+	writeRecord(q, M.data());
+}
+
+void StateRecordWriter::write(int q, const std::vector<vector3<>>& v)
+{	assert(elemSize == sizeof(vector3<>));
+	assert(v.size() == nElemPerRecord);
+	writeRecord(q, v.data());
+}
+
+void StateRecordWriter::writeRecord(int q, const void* data)
+{	assert(eInfo.isMine(q));
+#if MPI_SAFE_WRITE
+	if(mpiWorld->isHead())
+		fwriteLE(data, elemSize, nElemPerRecord, fp); //head states are the first in the file
+	else
+		buf.insert(buf.end(), (const char*)data, (const char*)data+recordBytes); //converted to little-endian on head
+#else
+	mpiWorld->fwrite(data, elemSize, nElemPerRecord, fp);
+#endif
+}
+
+
+TransitionHistogram::TransitionHistogram(const Everything& e, double dE) : e(e), dE(dE)
+{	//Determine range of transition energies from all states:
+	double Emin = +DBL_MAX, Emax = -DBL_MAX;
+	for(int q=e.eInfo.qStart; q<e.eInfo.qStop; q++)
+	{	Emin = std::min(Emin, e.eVars.Hsub_eigs[q].front());
+		Emax = std::max(Emax, e.eVars.Hsub_eigs[q].back());
+	}
+	mpiWorld->allReduce(Emin, MPIUtil::ReduceMin);
+	mpiWorld->allReduce(Emax, MPIUtil::ReduceMax);
+	size_t nBins = size_t(ceil((Emax-Emin)/dE)) + 1;
+	jdos.assign(nBins, 0.);
+	osc.assign(nBins, vector3<>());
+}
+
+void TransitionHistogram::add(int q, const matrix& P)
+{	const int nBands = e.eInfo.nBands;
+	const diagMatrix& E = e.eVars.Hsub_eigs[q];
+	const diagMatrix& F = e.eVars.F[q];
+	const double prefac = e.eInfo.qnums[q].weight / (e.gInfo.detR * dE); //per unit volume and transition energy
+	const complex* Pdata = P.data();
+	for(int b1=0; b1<nBands; b1++)
+		for(int b2=0; b2<nBands; b2++)
+		{	double omega = E[b2] - E[b1]; //transition energy
+			double dF = F[b1] - F[b2]; //occupation difference
+			if(omega <= 0. or fabs(dF) < 1e-12) continue; //only upward transitions with non-zero occupation difference
+			double iBinReal = floor(omega / dE);
+			if(iBinReal >= jdos.size()) continue; //outside range
+			size_t iBin = size_t(iBinReal);
+			double w = prefac * dF;
+			jdos[iBin] += w;
+			for(int iDir=0; iDir<3; iDir++)
+				osc[iBin][iDir] += w * (2./omega) * Pdata[P.index(b1, iDir*nBands+b2)].norm(); //oscillator strength 2|p|^2/omega (atomic units)
+		}
+}
+
+void TransitionHistogram::write(const char* filename)
+{	mpiWorld->allReduceData(jdos, MPIUtil::ReduceSum);
+	mpiWorld->allReduce((double*)osc.data(), 3*osc.size(), MPIUtil::ReduceSum);
+	if(!mpiWorld->isHead()) return;
+	//Drop trailing empty bins:
+	size_t nBins = jdos.size();
+	while(nBins>1 and jdos[nBins-1]==0. and osc[nBins-1].length_squared()==0.) nBins--;
+	FILE* fp = fopen(filename, "w");
+	if(!fp) die_alone("Error opening %s for writing.\n", filename);
+	fprintf(fp, "#omega[Eh] JDOS[1/(Eh.a0^3)] oscillator strength density along x,y,z [1/(Eh.a0^3)]\n");
+	for(size_t iBin=0; iBin<nBins; iBin++)
+		fprintf(fp, "%.6le %.6le %.6le %.6le %.6le\n", (iBin+0.5)*dE,
+			jdos[iBin], osc[iBin][0], osc[iBin][1], osc[iBin][2]);
+	fclose(fp);
 }
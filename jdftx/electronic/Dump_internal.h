@@ -22,9 +22,11 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <core/ScalarFieldArray.h>
 #include <core/Coulomb.h>
+#include <core/matrix.h>
 
 class Everything;
 class ColumnBundle;
+class ElecInfo;
 
 //! @addtogroup Output
 //! @{
@@ -67,6 +69,46 @@ namespace XC_Analysis
 //! Dump band projections to atomic orbitals or ortho-orbitals depending on ortho, and complex or real based on norm
 void dumpProjections(const Everything& e, const char* filename, bool ortho, bool norm);
 
+//! Stream fixed-size per-state binary records to a file in state order as they are computed.
+//! Each process writes its own states at their offsets using MPI-IO, so that no process needs
+//! to hold the records of all states (in MPI_SAFE_WRITE mode, records are instead collected
+//! and written by the head process when the writer is destroyed). Records are written
+//! little-endian, element by element, as with MPIUtil::fwriteData.
+class StateRecordWriter
+{
+public:
+	StateRecordWriter(const ElecInfo& eInfo, const char* fname, size_t elemSize, size_t nElemPerRecord); //!< collective
+	~StateRecordWriter(); //!< collective
+	//Write record of state q: call for each q from eInfo.qStart to eInfo.qStop-1 in order
+	void write(int q, const matrix& M); //!< record of complex elements (elemSize = sizeof(complex))
+	void write(int q, const std::vector<vector3<>>& v); //!< record of vector elements (elemSize = sizeof(vector3<>))
+private:
+	const ElecInfo& eInfo;
+	size_t elemSize, nElemPerRecord, recordBytes;
+	void writeRecord(int q, const void* data); //!< write record of native-endian elements
+#if MPI_SAFE_WRITE
+	FILE* fp; //!< file pointer (head only)
+	std::vector<char> buf; //!< records buffered for head (non-head only)
+#else
+	MPIUtil::File fp;
+#endif
+};
+
+//! Accumulate a k-weighted joint density of states and oscillator strength histogram of vertical
+//! transitions one state at a time, so that full momentum matrices need not be stored
+class TransitionHistogram
+{
+public:
+	TransitionHistogram(const Everything& e, double dE); //!< collective: determines energy range from all states
+	void add(int q, const matrix& P); //!< add transitions of state q, given momentum matrix elements P (nBands x 3nBands, as in the Momenta dump)
+	void write(const char* filename); //!< collective: reduce histograms over processes and write from head
+private:
+	const Everything& e;
+	double dE; //!< bin width
+	std::vector<double> jdos; //!< joint density of states
+	std::vector<vector3<>> osc; //!< oscillator strength density for each Cartesian direction
+};
+
 //---------------- Implemented in DumpChargedDefects.cpp -----------------
 
 //! Slab dielectric function calculator
@@ -60,7 +60,12 @@ void ElecInfo::setup(const Everything &everything, std::vector<diagMatrix>& F, E
 	nStates = qnums.size();
 	
 	//Determine distribution amongst processes:
-	qDivision.init(nStates, mpiWorld);
+	//--- balance cost ~ nbasis nBands^2, where nBands is the same for all states
+	qCost.assign(nStates, 1.);
+	if(mpiWorld->nProcesses()>1 && e->cntrl.basisKdep==BasisKpointDep)
+		for(int q=0; q<nStates; q++)
+			qCost[q] = Basis::count(e->gInfo, e->cntrl.Ecut, qnums[q].k);
+	qDivision.init(qCost, mpiWorld);
 	qDivision.myRange(qStart, qStop);
 	
 	//Allocate the fillings matrices.
@@ -257,6 +262,38 @@ void ElecInfo::smearReport(const double* muOverride) const
 
 
 // Fermi legendre multipliers (TS and optionally muN)
+void ElecInfo::printLoadBalance(double tMine) const
+{	int nProcs = mpiWorld->nProcesses();
+	if(nProcs==1) return;
+	//Collect predicted and actual loads:
+	std::vector<double> predicted(nProcs, 0.), actual(nProcs, 0.);
+	for(int jProc=0; jProc<nProcs; jProc++)
+		for(int q=qStartOther(jProc); q<qStopOther(jProc); q++)
+			predicted[jProc] += qCost[q] * nBands * nBands;
+	actual[mpiWorld->iProcess()] = tMine;
+	mpiWorld->allReduceData(actual, MPIUtil::ReduceSum);
+	//Report relative to mean:
+	double predictedMean = 0., actualMean = 0.;
+	for(int jProc=0; jProc<nProcs; jProc++)
+	{	predictedMean += predicted[jProc] / nProcs;
+		actualMean += actual[jProc] / nProcs;
+	}
+	if(!predictedMean || !actualMean) return;
+	logPrintf("\n---- Load balance of states over processes (relative to mean) ----\n");
+	logPrintf("%7s %7s %7s %10s %10s\n", "Process", "qStart", "qStop", "Predicted", "Actual");
+	double predictedMax = 0., actualMax = 0.;
+	for(int jProc=0; jProc<nProcs; jProc++)
+	{	double predictedRel = predicted[jProc] / predictedMean;
+		double actualRel = actual[jProc] / actualMean;
+		logPrintf("%7d %7d %7d %10.3lf %10.3lf\n", jProc, qStartOther(jProc), qStopOther(jProc), predictedRel, actualRel);
+		predictedMax = std::max(predictedMax, predictedRel);
+		actualMax = std::max(actualMax, actualRel);
+	}
+	logPrintf("Imbalance (max/mean):  predicted: %.3lf  actual: %.3lf  (actual: %.2lf s mean per process)\n",
+		predictedMax, actualMax, actualMean);
+	logFlush();
+}
+
 void ElecInfo::updateFillingsEnergies(const std::vector<diagMatrix>& eps, Energies& ener) const
 {
 	//Determine relevant Legenedre multipliers:
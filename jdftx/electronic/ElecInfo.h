@@ -67,6 +67,7 @@ public:
 	int whose(int q) const { return qDivision.whose(q); } //!< find out which process this state index belongs to
 	int qStartOther(int iProc) const { return qDivision.start(iProc); } //!< find out qStart for another process
 	int qStopOther(int iProc) const { return qDivision.stop(iProc); } //!< find out qStop for another process
+	void printLoadBalance(double tMine) const; //!< report predicted and actual (tMine = time in state-local work on this process) load per process
 	
 	SpinType spinType; //!< type of spin treatment
 	double nElectrons; //!< the number of electrons = Sum w Tr[F]
@@ -153,6 +154,7 @@ public:
 private:
 	const Everything* e;
 	TaskDivision qDivision; //!< MPI division of k-points
+	std::vector<double> qCost; //!< predicted relative cost (nbasis) of each state, used to balance qDivision
 	
 	//Initial fillings:
 	int nBandsOld; //!<number of bands in file being read
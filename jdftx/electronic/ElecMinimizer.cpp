@@ -415,6 +415,8 @@ void elecFluidMinimize(Everything &e)
 				"or elec-initial-eigenvals, or be automatically initialized during LCAO.");
 	}
 	
+	if(eVars.fluidSolver) eVars.fluidSolver->beginIonicStep(); //extrapolate fluid state from previous ionic steps (if any)
+	
 	double Evac0 = NAN;
 	if(eVars.isRandom && eVars.fluidParams.fluidType!=FluidNone)
 	{	logPrintf("Fluid solver invoked on fresh (random / LCAO) wavefunctions\n");
@@ -486,6 +488,8 @@ void elecFluidMinimize(Everything &e)
 				cntrl.fluidGummel_Atol, cntrl.fluidGummel_nIterations, clock_sec());
 	}
 	
+	if(eVars.fluidSolver) eVars.fluidSolver->endIonicStep(); //record fluid state for extrapolation
+	
 	if(!std::isnan(Evac0))
 		logPrintf("Single-point solvation energy estimate, Delta%s = %+.15f\n", relevantFreeEnergyName(e), relevantFreeEnergy(e)-Evac0);
 }
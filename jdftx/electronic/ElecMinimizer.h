@@ -60,6 +60,7 @@ public:
 	bool report(int iter);
 	void constrain(ElecGradient&);
 	double sync(double x) const; //!< All processes minimize together; make sure scalars are in sync to round-off error
+	const char* telemetryStage() const { return "electronic"; } //!< emit telemetry records for each iteration
 	
 private:
 	Everything& e;
@@ -32,7 +32,7 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #include <limits.h>
 
 ElecVars::ElecVars()
-: isRandom(true), initLCAO(true), skipWfnsInit(false), HauxInitialized(false), lcaoIter(-1), lcaoTol(1e-6)
+: singlePrecisionVscloc(false), isRandom(true), initLCAO(true), skipWfnsInit(false), HauxInitialized(false), tStatesMine(0.), lcaoIter(-1), lcaoTol(1e-6), lcaoEigTol(0.)
 {
 }
 
@@ -62,7 +62,7 @@ void readDensityArray(ScalarFieldArray& var, string varName, string fnamePattern
 		fname.replace(pos,4, (suffix)); \
 		logPrintf("Reading %s from file '%s' ... ", (suffix).c_str(), fname.c_str()); logFlush(); \
 		nullToZero(var, e->gInfo); \
-		loadRawBinary(var, fname.c_str()); \
+		loadField(var, fname.c_str()); \
 		logPrintf("done\n"); logFlush(); \
 	}
 	var.resize(e->eInfo.nDensities);
@@ -102,7 +102,7 @@ void ElecVars::setup(const Everything &everything)
 		for(unsigned s=0; s<Vexternal.size(); s++)
 		{	Vexternal[s] = ScalarFieldData::alloc(gInfo);
 			logPrintf("Reading external potential from '%s'\n", VexternalFilename[s].c_str());
-			loadRawBinary(Vexternal[s], VexternalFilename[s].c_str());
+			loadField(Vexternal[s], VexternalFilename[s].c_str());
 		}
 		if(Vexternal.size()==1 && n.size()==2) //Replicate potential for second spin:
 			Vexternal.push_back(Vexternal[0]->clone());
@@ -355,8 +355,8 @@ void ElecVars::EdensityAndVscloc(Energies& ener, const ExCorr* alternateExCorr)
 		}
 		if(VtauTilde) Vtau[s] += I(VtauTilde);
 	}
-	e->symm.symmetrize(Vscloc);
-	if(Vtau[0]) e->symm.symmetrize(Vtau);
+	if(Vtau[0]) e->symm.symmetrize({&Vscloc, &Vtau}); //symmetrize both in a single pass
+	else e->symm.symmetrize(Vscloc);
 	watch.stop();
 }
 
@@ -389,9 +389,17 @@ double ElecVars::elecEnergyAndGrad(Energies& ener, ElecGradient* grad, ElecGradi
 	}
 	
 	//Update the density and density-dependent pieces if required:
-	n = calcDensity();
-	if(e->exCorr.needsKEdensity()) tau = KEdensity();
+	//--- density reductions proceed in the background while KE density and DFT+U contributions are computed
+	std::vector<MPIUtil::Request> densityRequests;
+	n = calcDensity(&densityRequests);
+	if(e->exCorr.needsKEdensity()) tau = KEdensity(&densityRequests);
 	if(eInfo.hasU) e->iInfo.rhoAtom_calc(F, C, rhoAtom); //Atomic density matrix contributions for DFT+U
+	MPIUtil::waitAll(densityRequests); //complete reductions before XC evaluation
+	if(e->exCorr.needsKEdensity())
+	{	e->symm.symmetrize({&n, &tau}); //symmetrize both in a single pass
+		finishKEdensity(tau, true);
+	}
+	else e->symm.symmetrize(n);
 	EdensityAndVscloc(ener); //Calculate density functional and its gradient
 	if(need_Hsub) e->iInfo.augmentDensityGridGrad(Vscloc); //Update Vscloc projected onto spherical functions for ultrasoft psps
 	
@@ -598,27 +606,40 @@ void ElecVars::setEigenvectors()
 	}
 }
 
-ScalarFieldArray ElecVars::KEdensity() const
+//Sum-reduce each component of x over processes, asynchronously if requests is non-null
+void allReduceDensity(ScalarFieldArray& x, std::vector<MPIUtil::Request>* requests)
+{	for(ScalarField& xs: x)
+	{	if(requests && mpiWorld->nProcesses()>1)
+		{	requests->push_back(MPIUtil::Request());
+			xs->allReduceData(mpiWorld, MPIUtil::ReduceSum, false, &requests->back());
+		}
+		else xs->allReduceData(mpiWorld, MPIUtil::ReduceSum);
+	}
+}
+
+ScalarFieldArray ElecVars::KEdensity(std::vector<MPIUtil::Request>* requests) const
 {	ScalarFieldArray tau(n.size());
 	//Compute KE density from valence electrons:
 	for(int q=e->eInfo.qStart; q<e->eInfo.qStop; q++)
 		for(int iDir=0; iDir<3; iDir++)
 			tau += (0.5*C[q].qnum->weight) * diagouterI(F[q], D(C[q],iDir), tau.size(), &e->gInfo);
-	for(ScalarField& tau_s: tau)
-	{	nullToZero(tau_s, e->gInfo);
-		tau_s->allReduceData(mpiWorld, MPIUtil::ReduceSum);
-	}
-	e->symm.symmetrize(tau); //Symmetrize
+	nullToZero(tau, e->gInfo);
+	allReduceDensity(tau, requests);
+	if(!requests) finishKEdensity(tau);
+	return tau;
+}
+
+void ElecVars::finishKEdensity(ScalarFieldArray& tau, bool symmetrized) const
+{	if(!symmetrized) e->symm.symmetrize(tau); //Symmetrize
 	//Add core KE density model:
 	if(e->iInfo.tauCore)
 	{	int nSpins = std::min(2, int(tau.size())); //don't add to Re/Im(UpDn) in vector-spin mode
 		for(int s=0; s<nSpins; s++)
 			tau[s] += (1./nSpins) * e->iInfo.tauCore; //add core KE density
 	}
-	return tau;
 }
 
-ScalarFieldArray ElecVars::calcDensity() const
+ScalarFieldArray ElecVars::calcDensity(std::vector<MPIUtil::Request>* requests) const
 {	ScalarFieldArray density(n.size()); nullToZero(density, e->gInfo);
 	//Runs over all states and accumulates density to the corresponding spin channel of the total density
 	e->iInfo.augmentDensityInit();
@@ -627,11 +648,9 @@ ScalarFieldArray ElecVars::calcDensity() const
 		e->iInfo.augmentDensitySpherical(e->eInfo.qnums[q], F[q], VdagC[q]); //pseudopotential contribution
 	}
 	e->iInfo.augmentDensityGrid(density);
-	for(ScalarField& ns: density)
-	{	nullToZero(ns, e->gInfo);
-		ns->allReduceData(mpiWorld, MPIUtil::ReduceSum);
-	}
-	e->symm.symmetrize(density);
+	nullToZero(density, e->gInfo);
+	allReduceDensity(density, requests);
+	if(!requests) e->symm.symmetrize(density);
 	return density;
 }
 
@@ -646,12 +665,13 @@ void ElecVars::orthonormalize(int q, matrix* extraRotation)
 
 double ElecVars::applyHamiltonian(int q, const diagMatrix& Fq, ColumnBundle& HCq, Energies& ener, bool need_Hsub, bool diagonalize_Hsub)
 {	assert(C[q]); //make sure wavefunction is available for this state
+	double tStart = clock_sec();
 	const QuantumNumber& qnum = e->eInfo.qnums[q];
 	std::vector<matrix> HVdagCq(e->iInfo.species.size());
 	
 	//Propagate grad_n (Vscloc) to HCq (which is grad_Cq upto weights and fillings) if required
 	if(need_Hsub)
-	{	HCq += Idag_DiagV_I(C[q], Vscloc); //Accumulate Idag Diag(Vscloc) I C
+	{	HCq += Idag_DiagV_I(C[q], Vscloc, 0, singlePrecisionVscloc); //Accumulate Idag Diag(Vscloc) I C
 		e->iInfo.augmentDensitySphericalGrad(qnum, VdagC[q], HVdagCq); //Contribution via pseudopotential density augmentation
 		if(e->exCorr.needsKEdensity() && Vtau[qnum.index()]) //Contribution via orbital KE:
 		{	for(int iDir=0; iDir<3; iDir++)
@@ -687,5 +707,6 @@ double ElecVars::applyHamiltonian(int q, const diagMatrix& Fq, ColumnBundle& HCq
 		if(diagonalize_Hsub)
 			Hsub[q].diagonalize(Hsub_evecs[q], Hsub_eigs[q]);
 	}
+	tStatesMine += clock_sec() - tStart;
 	return KEq;
 }
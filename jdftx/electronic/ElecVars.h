@@ -59,6 +59,7 @@ public:
 	ScalarFieldArray Vscloc; //! Local part of (optionally spin-dependent) self-consistent potential
 	ScalarFieldArray Vxc; //! Exchange-correlation potential
 	ScalarFieldArray Vtau; //! Gradient w.r.t kinetic energy density (if meta-GGA)
+	bool singlePrecisionVscloc; //!< whether to apply Vscloc with single-precision FFTs (set by SCF in early iterations)
 	
 	std::vector<matrix> rhoAtom, U_rhoAtom; //!< Atomic density matrices and gradients w.r.t them (for DFT+U)
 	
@@ -113,10 +114,15 @@ public:
 	void setEigenvectors(); 
 	
 	//! Compute the kinetic energy density
-	ScalarFieldArray KEdensity() const;
+	//! If requests is non-null, the MPI reduction is only started (appending its requests);
+	//! the caller must then wait on them and call finishKEdensity() on the result.
+	ScalarFieldArray KEdensity(std::vector<MPIUtil::Request>* requests=0) const;
+	void finishKEdensity(ScalarFieldArray& tau, bool symmetrized=false) const; //!< symmetrize (unless already symmetrized) and add core contributions to a reduced KE density
 	
 	//! Calculate density using current orthonormal wavefunctions (C)
-	ScalarFieldArray calcDensity() const;
+	//! If requests is non-null, the MPI reduction is only started (appending its requests);
+	//! the caller must then wait on them and symmetrize the result.
+	ScalarFieldArray calcDensity(std::vector<MPIUtil::Request>* requests=0) const;
 	
 	//! Orthonormalise wavefunctions, with an optional extra rotation
 	//! If extraRotation is present, it is applied after symmetric orthononormalization,
@@ -128,6 +134,8 @@ public:
 	//! Returns the Kinetic energy contribution from q, which can be used for the inverse kinetic preconditioner
 	double applyHamiltonian(int q, const diagMatrix& Fq, ColumnBundle& HCq, Energies& ener, bool need_Hsub = false, bool diagonalize_Hsub=true);
 	
+	double tStatesMine; //!< wall time spent in applyHamiltonian on this process (for ElecInfo::printLoadBalance)
+	
 private:
 	const Everything* e;
 	
@@ -139,6 +147,7 @@ private:
 
 	int lcaoIter; //!< number of iterations for LCAO (automatic if negative)
 	double lcaoTol; //!< tolerance for LCAO subspace minimization
+	double lcaoEigTol; //!< if positive, stop LCAO subspace minimization once subspace eigenvalues change by less than this
 	int LCAO(); //!< Initialize LCAO wavefunctions (returns the number of bands initialized)
 	friend struct CommandWavefunction;
 	friend struct CommandLcaoParams;
@@ -38,12 +38,31 @@ struct LCAOminimizer : Minimizable<ElecGradient> //Uses only the Haux entries of
 	const ExCorr* exCorr;
 	std::vector<matrix> HniSub;
 	std::vector<matrix> rotPrev; //Accumulated rotations of the wavefunctions
+	double eigTol; //Subspace eigenvalue convergence threshold (disabled if zero)
+	std::vector<diagMatrix> eigsPrev; //Subspace eigenvalues at previous convergence check
 	
-	LCAOminimizer(ElecVars& eVars, const Everything& e)
-	: eVars(eVars), e(e), eInfo(e.eInfo), HniSub(eInfo.nStates), rotPrev(eInfo.nStates)
+	LCAOminimizer(ElecVars& eVars, const Everything& e, double eigTol)
+	: eVars(eVars), e(e), eInfo(e.eInfo), HniSub(eInfo.nStates), rotPrev(eInfo.nStates), eigTol(eigTol), eigsPrev(eInfo.nStates)
 	{
 	}
 	
+	//Orthonormalize atomic orbitals and set non-interacting part of subspace Hamiltonian for states qOffset+[iStart,iStop) (can run in parallel over states):
+	static void initHni_thread(size_t iStart, size_t iStop, LCAOminimizer* lcao, int qOffset)
+	{	ElecVars& eVars = lcao->eVars;
+		const IonInfo& iInfo = lcao->e.iInfo;
+		for(size_t i=iStart; i<iStop; i++)
+		{	int q = qOffset + i;
+			eVars.orthonormalize(q);
+			//Non-interacting Hamiltonian:
+			ColumnBundle HniCq = -0.5*L(eVars.C[q]);
+			std::vector<matrix> HVdagCq(iInfo.species.size());
+			iInfo.EnlAndGrad(lcao->eInfo.qnums[q], eye(lcao->nBands), eVars.VdagC[q], HVdagCq); //non-local pseudopotentials
+			iInfo.projectGrad(HVdagCq, eVars.C[q], HniCq);
+			lcao->HniSub[q] = eVars.C[q]^HniCq;
+			lcao->rotPrev[q] = eye(lcao->nBands);
+		}
+	}
+	
 	void step(const ElecGradient& dir, double alpha)
 	{	for(int q=eInfo.qStart; q<eInfo.qStop; q++)
 		{	assert(dir.Haux[q]);
@@ -144,6 +163,26 @@ struct LCAOminimizer : Minimizable<ElecGradient> //Uses only the Haux entries of
 	{	eInfo.smearReport();
 		return false;
 	}
+	
+	//Optionally converge on subspace eigenvalues of the requested bands (updated in each compute() with gradient):
+	bool checkConvergence(string& reason)
+	{	if(!eigTol) return false;
+		double maxChange = 0.; bool first = false;
+		for(int q=eInfo.qStart; q<eInfo.qStop; q++)
+		{	const diagMatrix& eigs = eVars.Hsub_eigs[q];
+			if(eigsPrev[q].nRows() != eigs.nRows()) first = true;
+			else
+				for(int b=0; b<std::min(eInfo.nBands, eigs.nRows()); b++)
+					maxChange = std::max(maxChange, fabs(eigs[b] - eigsPrev[q][b]));
+			eigsPrev[q] = eigs;
+		}
+		mpiWorld->allReduce(&first, 1, MPIUtil::ReduceLOr);
+		mpiWorld->allReduce(maxChange, MPIUtil::ReduceMax);
+		if(first || maxChange >= eigTol) return false;
+		ostringstream oss; oss << "|Delta eigs|<" << std::scientific << eigTol;
+		reason = oss.str().c_str();
+		return true;
+	}
 };
 
 
@@ -164,7 +203,7 @@ int ElecVars::LCAO()
 		return 0;
 	}
 	
-	LCAOminimizer lcao(*this, *e);
+	LCAOminimizer lcao(*this, *e, lcaoEigTol);
 	
 	//Check exchange-correlation functional, and replace with PBE if not strictly (semi-)local
 	ExCorr exCorrPBE; //defaults to gga-PBE
@@ -185,18 +224,13 @@ int ElecVars::LCAO()
 	//Get orthonormal atomic orbitals and non-interacting part of subspace Hamiltonian:
 	lcao.nBands = std::max(nAtomic+1, std::max(eInfo.nBands, int(ceil(1+eInfo.nElectrons/eInfo.qWeightSum))));
 	for(int q=eInfo.qStart; q<eInfo.qStop; q++)
-	{	C[q] = iInfo.getAtomicOrbitals(q, false, lcao.nBands-nAtomic);
+	{	C[q] = iInfo.getAtomicOrbitals(q, false, lcao.nBands-nAtomic); //orbital evaluation is threaded internally
 		if(nAtomic<lcao.nBands) C[q].randomize(nAtomic, lcao.nBands); //Randomize extra columns if any
-		orthonormalize(q);
-		//Non-interacting Hamiltonian:
-		ColumnBundle HniCq = -0.5*L(C[q]);
-		std::vector<matrix> HVdagCq(iInfo.species.size());
-		iInfo.EnlAndGrad(eInfo.qnums[q], eye(lcao.nBands), VdagC[q], HVdagCq); //non-local pseudopotentials
-		iInfo.projectGrad(HVdagCq, C[q], HniCq);
-		lcao.HniSub[q] = C[q]^HniCq;
-		lcao.rotPrev[q] = eye(lcao.nBands);
 		F[q].resize(lcao.nBands, 0.);
 	}
+	int nStatesMine = eInfo.qStop - eInfo.qStart;
+	bool threadStates = (!isGpuEnabled()) && nStatesMine >= nProcsAvailable; //thread over states only when there are enough of them
+	threadLaunch(threadStates ? 0 : 1, LCAOminimizer::initHni_thread, nStatesMine, &lcao, eInfo.qStart);
 	
 	//Get electron density obtained by adding those of the atoms:
 	if(!e->cntrl.fixed_H)
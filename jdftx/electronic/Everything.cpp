@@ -21,6 +21,7 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #include <electronic/ExactExchange.h>
 #include <electronic/VanDerWaalsD3.h>
 #include <electronic/Vibrations.h>
+#include <electronic/CalculatorServer.h>
 #include <electronic/DOS.h>
 #include <electronic/DumpBGW_internal.h>
 #include <electronic/IonicMinimizer.h>
@@ -152,6 +153,9 @@ void Everything::setup()
 	//Setup vibrations module:
 	if(vibrations) vibrations->setup(this);
 	
+	//Setup calculator server:
+	if(server) server->setup(this);
+	
 	//Setup electronic minimization parameters:
 	elecMinParams.nDim = 0;
 	for(int q=eInfo.qStart; q<eInfo.qStop; q++)
@@ -77,6 +77,8 @@ public:
 	std::shared_ptr<VanDerWaals> vanDerWaals; //! vdw correction calculator for electronic system
 	std::shared_ptr<VanDerWaalsD2> vanDerWaalsFluid; //!< vdW correction calculation for fluid coupling / solvation
 	std::shared_ptr<class Vibrations> vibrations; //! Vibrational mode calculator
+	std::shared_ptr<class CalculatorServer> server; //!< Persistent calculator server for external drivers (eg. ASE)
+	std::shared_ptr<class NEB> neb; //!< Nudged elastic band reaction path calculator
 
 	//! Call the setup/initialize routines of all the above in the necessray order
 	void setup();
@@ -1018,10 +1018,10 @@ void ExCorr::getSecondDerivatives(const ScalarField& n, ScalarField& e_nn, Scala
 	}
 	
 	//Compute finite difference derivatives:
-	ScalarField nDen = (0.5/eps) * inv(n) * mask;
+	ScalarField nDen = (0.5/eps) * lazy(mask) / n;
 	e_nn = nDen * (configs[1].e_n - configs[2].e_n);
 	if(needsSigma)
-	{	ScalarField sigmaDen = (0.5/eps) * inv(sigma) * mask;
+	{	ScalarField sigmaDen = (0.5/eps) * lazy(mask) / sigma;
 		e_sigma = configs[0].e_sigma*mask; //First derivative available analytically
 		e_nsigma = 0.5*(nDen * (configs[1].e_sigma - configs[2].e_sigma) + sigmaDen * (configs[3].e_n - configs[4].e_n));
 		e_sigmasigma = sigmaDen * (configs[3].e_sigma - configs[4].e_sigma);
@@ -109,7 +109,7 @@ void ExCorr_OrbitalDep_GLLBsc::dump() const
 			logPrintf("done\n"); logFlush();
 		#define DUMP(object, prefix) \
 			{	StartDump(prefix) \
-				if(mpiWorld->isHead()) saveRawBinary(object, fname.c_str()); \
+				e.dump.saveField(object, fname, prefix); \
 				EndDump \
 			}
 		if(e.eInfo.spinType == SpinZ)
@@ -38,6 +38,7 @@ public:
 	{	vector3<> k; //transformed k
 		SpaceGroupOp sym; //symmetry operation
 		int invert; //whether inversion involved (+/-1)
+		int iSym; //index of this transform among distinct transforms of the same reduced k (identifies it in unfoldCache)
 		double weight;
 		std::shared_ptr<Basis> basis;
 		std::shared_ptr<ColumnBundleTransform> transform; //wavefunction transformation from reduced set
@@ -86,6 +87,7 @@ private:
 	std::vector<std::vector<LocalState>> localStates; //local state descriptions on each process
 	std::vector<LocalState>& localStatesMine; //reference to local state on this process
 	size_t progressMax, progressInterval; //for progress reporting in compute / computePair
+	mutable ColumnBundleTransformCache unfoldCache; //transformed k-states for current reduced k (reused over q-states and blocks)
 };
 
 
@@ -121,6 +123,7 @@ double ExactExchange::operator()(double aXX, double omega,
 		logPrintf("Computing exact exchange ... "); logFlush();
 		double EXX = eval->compute(aXX, omega, F, C, HC, EXX_RRTptr, rpaMode, Hsub_eigs);
 		logPrintf("done.\n");
+		eval->unfoldCache.printStats("\tUnfolded k-state");
 		return EXX;
 	}
 }
@@ -142,6 +145,7 @@ void ExactExchange::prepareHamiltonian(double omega, const std::vector<diagMatri
 		isSingularAny = isSingularAny or isSingular;
 	}
 	logPrintf("done.\n");
+	eval->unfoldCache.printStats("\tUnfolded k-state");
 	//Check and report any singular inversions:
 	mpiWorld->allReduce(isSingularAny, MPIUtil::ReduceLOr);
 	if(isSingularAny) logPrintf("WARNING: singularity encountered in constructing ACE representation.\n");
@@ -259,7 +263,8 @@ ExactExchangeEval::ExactExchangeEval(const Everything& e)
 	blockSize(e.cntrl.exxBlockSize),
 	omegaACE(NAN),
 	localStates(mpiWorld->nProcesses()),
-	localStatesMine(localStates[mpiWorld->iProcess()])
+	localStatesMine(localStates[mpiWorld->iProcess()]),
+	unfoldCache(size_t(e.cntrl.unfoldCacheMB*1e6), e.cntrl.unfoldCacheSpill)
 {
 	//Find all symmtries relating each kmesh point to corresponding reduced point:
 	const Supercell& supercell = *(e.coulombParams.supercell);
@@ -368,12 +373,15 @@ ExactExchangeEval::ExactExchangeEval(const Everything& e)
 	kpairs.assign(qCount, std::vector<std::vector<KpairEntry>>(qCount));
 	size_t nTransformsMin = transforms[0][0].size(), nTransformsMax = 0;
 	std::vector<size_t> jCost(qCount); //estimated relative cost of a band in each jq
+	std::vector<std::vector<Ktransform>> iqTransforms(qCount); //distinct transforms of each iq over all jq
 	for(int iq=0; iq<qCount; iq++)
 	for(int jq=0; jq<qCount; jq++)
 	{	for(const Ktransform& kt: transforms[iq][jq])
 		{	KpairEntry kpair;
 			kpair.sym = kt.sym;
 			kpair.invert = kt.invert;
+			kpair.iSym = std::find(iqTransforms[iq].begin(), iqTransforms[iq].end(), kt) - iqTransforms[iq].begin();
+			if(kpair.iSym == int(iqTransforms[iq].size())) iqTransforms[iq].push_back(kt);
 			kpair.k = kpair.sym.applyRecip(e.eInfo.qnums[iq].k) * kpair.invert; 
 			kpair.weight = e.eInfo.spinWeight * pow(kmesh.size(),-2) * kt.multiplicity;
 			kpairs[iq][jq].push_back(kpair); //note that kpair setup is run below after determining load balancing
@@ -527,11 +535,13 @@ double ExactExchangeEval::compute(double aXX, double omega,
 			if(rpaMode) mpiWorld->bcastData(Hsub_eigsk, e.eInfo.whose(ikSrc));
 			
 			//Calculate energy (and gradient):
+			unfoldCache.clear(); //transformed k-states of previous ik no longer needed
 			for(LocalState& ls: localStatesMine)
 				EXX += computePair(ikReduced, ls.iqReduced, progress, progressTarget, aXX, omega,
 					Fk, CkRed, ls.Fq, ls.Cq, HC ? &(ls.HCq) : 0, EXX_RRTptr ? &EXX_RRT : 0,
 					rpaMode, &Hsub_eigsk, &ls.Hsub_eigsq);
 		}
+		unfoldCache.clear(); //free memory (wavefunctions change between calls)
 		
 		//Free local wavefunction chunks:
 		for(LocalState& ls: localStatesMine) ls.Cq.free();
@@ -602,21 +612,20 @@ double ExactExchangeEval::computePair(int ikReduced, int iqReduced, size_t& prog
 			for(int s=0; s<nSpinor; s++)
 				Ipsiq[bq-bqStart][s] = I(Cq.getColumn(bq,s));
 		}
-		//Loop over k-states:
-		for(int bk=0; bk<CkRed.nCols(); bk++)
-		{	//Loop over symmetry transformations of this k-state:
-			for(const KpairEntry& kpair: kpairs[ikReduced][iqReduced])
-			{	//Prepare transformed k-state in reciprocal space:
-				const Basis& basis_k = *(kpair.basis);
-				QuantumNumber qnum_k = *(CkRed.qnum); qnum_k.k =  kpair.k;
-				ColumnBundle Ck(1, basis_k.nbasis*nSpinor, &basis_k, &qnum_k, isGpuEnabled());
-				Ck.zero();
-				kpair.transform->scatterAxpy(1., CkRed,bk, Ck,0);
-				const double prefac = -0.5*aXX * kpair.weight / (qnum_k.weight * qnum_q.weight);
-				//Put this state in real space:
+		//Loop over symmetry transformations of k-states:
+		for(const KpairEntry& kpair: kpairs[ikReduced][iqReduced])
+		{	//Get all transformed k-states in reciprocal space (unfolded once per ik, and reused for each q-state and block):
+			const Basis& basis_k = *(kpair.basis);
+			QuantumNumber qnum_k = *(CkRed.qnum); qnum_k.k =  kpair.k;
+			ColumnBundleTransformCache::Key key = { ikReduced, kpair.iSym, kpair.invert, vector3<int>() };
+			const ColumnBundle& Ck = unfoldCache.get(key, *kpair.transform, CkRed, basis_k, qnum_k);
+			const double prefac = -0.5*aXX * kpair.weight / (qnum_k.weight * qnum_q.weight);
+			//Loop over k-states:
+			for(int bk=0; bk<CkRed.nCols(); bk++)
+			{	//Put this state in real space:
 				std::vector<complexScalarField> Ipsik(nSpinor);
 				for(int s=0; s<nSpinor; s++)
-					Ipsik[s] = I(Ck.getColumn(0,s));
+					Ipsik[s] = I(Ck.getColumn(bk,s));
 				double wFk = qnum_k.weight * Fk[bk];
 				//Loop over q-bands within block:
 				for(int bq=bqStart; bq<bqStop; bq++)
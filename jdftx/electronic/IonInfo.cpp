@@ -350,11 +350,21 @@ void IonInfo::augmentDensitySpherical(const QuantumNumber& qnum, const diagMatri
 	}
 }
 void IonInfo::augmentDensityGrid(ScalarFieldArray& n) const
-{	for(auto sp: species) sp->augmentDensityGrid(n);
+{	//Accumulate all species in reciprocal space, and transform once:
+	ScalarFieldTildeArray nAugTilde(n.size());
+	for(auto sp: species) sp->augmentDensityGridTilde(nAugTilde);
+	for(unsigned s=0; s<n.size(); s++)
+		if(nAugTilde[s]) n[s] += I(nAugTilde[s]);
 }
 void IonInfo::augmentDensityGridGrad(const ScalarFieldArray& E_n, IonicGradient* forces, matrix3<>* Eaug_RRT) const
-{	for(unsigned sp=0; sp<species.size(); sp++)
-		((SpeciesInfo&)(*species[sp])).augmentDensityGridGrad(E_n, forces ? &forces->at(sp) : 0, Eaug_RRT);
+{	bool hasAugmentation = false;
+	for(auto sp: species) if(sp->isUltrasoft() and sp->atpos.size()) hasAugmentation = true;
+	if(!hasAugmentation) return;
+	//Transform gradient once, and share between all species:
+	ScalarFieldTildeArray ccE_n(E_n.size());
+	for(unsigned s=0; s<E_n.size(); s++) ccE_n[s] = Idag(E_n[s]);
+	for(unsigned sp=0; sp<species.size(); sp++)
+		((SpeciesInfo&)(*species[sp])).augmentDensityGridGradTilde(ccE_n, forces ? &forces->at(sp) : 0, Eaug_RRT);
 }
 void IonInfo::augmentDensitySphericalGrad(const QuantumNumber& qnum, const std::vector<matrix>& VdagCq, std::vector<matrix>& HVdagCq) const
 {	for(unsigned sp=0; sp<species.size(); sp++)
@@ -374,20 +384,87 @@ const std::vector<matrix> IonInfo::getE_nAug()
 	return E_nAug;
 }
 
+std::vector<std::vector<IonInfo::ProjectorBlockEntry>> IonInfo::getProjectorBlocks(const std::vector<bool>& spMask, int nColsMax) const
+{	std::vector<std::vector<ProjectorBlockEntry>> blocks(1);
+	int nCols = 0; //number of columns in current block
+	for(unsigned sp=0; sp<species.size(); sp++)
+	{	if(!spMask[sp]) continue;
+		int nAtoms = species[sp]->atpos.size();
+		int nProj = species[sp]->nAtomProjectors();
+		int atomStart = 0;
+		while(atomStart < nAtoms)
+		{	if(nCols && nCols+nProj > nColsMax)
+			{	blocks.push_back(std::vector<ProjectorBlockEntry>()); //start a new block
+				nCols = 0;
+			}
+			int atomStop = std::min(nAtoms, atomStart + std::max(1, (nColsMax-nCols)/nProj));
+			ProjectorBlockEntry entry = { int(sp), atomStart, atomStop, nCols };
+			blocks.back().push_back(entry);
+			nCols += nProj * (atomStop-atomStart);
+			atomStart = atomStop;
+		}
+	}
+	if(!blocks.back().size()) blocks.pop_back();
+	return blocks;
+}
+
+int IonInfo::nProjectorBlockCols(const std::vector<ProjectorBlockEntry>& block) const
+{	const ProjectorBlockEntry& last = block.back();
+	return last.colStart + species[last.sp]->nAtomProjectors() * (last.atomStop - last.atomStart);
+}
+
 void IonInfo::project(const ColumnBundle& Cq, std::vector<matrix>& VdagCq, matrix* rotExisting) const
 {	VdagCq.resize(species.size());
-	for(unsigned sp=0; sp<e->iInfo.species.size(); sp++)
+	std::vector<bool> spMask(species.size(), false); //species whose projections need to be computed
+	for(unsigned sp=0; sp<species.size(); sp++)
 	{	if(rotExisting && VdagCq[sp]) VdagCq[sp] = VdagCq[sp] * (*rotExisting); //rotate and keep the existing projections
-		else
-		{	auto V = e->iInfo.species[sp]->getV(Cq);
-			if(V) VdagCq[sp] = (*V) ^ Cq;
+		else if(species[sp]->nAtomProjectors() && species[sp]->atpos.size())
+		{	VdagCq[sp] = zeroes(species[sp]->nProjectors(), Cq.nCols());
+			spMask[sp] = true;
+		}
+	}
+	//Project onto blocks of projectors concatenated over species:
+	int nSpinor = Cq.spinorLength();
+	const Basis& basis = *(Cq.basis);
+	for(const std::vector<ProjectorBlockEntry>& block: getProjectorBlocks(spMask, std::max(Cq.nCols(), int(projectorBlockSize))))
+	{	ColumnBundle V(nProjectorBlockCols(block), basis.nbasis, &basis, Cq.qnum, isGpuEnabled()); //not a spinor regardless of spin type
+		for(const ProjectorBlockEntry& entry: block)
+			species[entry.sp]->getV(Cq, entry.atomStart, entry.atomStop, V.dataPref() + entry.colStart*basis.nbasis);
+		matrix VdagCblock = V ^ Cq;
+		for(const ProjectorBlockEntry& entry: block)
+		{	int nProj = species[entry.sp]->nAtomProjectors() * nSpinor;
+			int nRows = nProj * (entry.atomStop - entry.atomStart);
+			int rowStart = nSpinor * entry.colStart;
+			VdagCq[entry.sp].set(nProj*entry.atomStart, nProj*entry.atomStop, 0, Cq.nCols(),
+				VdagCblock(rowStart, rowStart+nRows, 0, Cq.nCols()));
 		}
 	}
 }
 
 void IonInfo::projectGrad(const std::vector<matrix>& HVdagCq, const ColumnBundle& Cq, ColumnBundle& HCq) const
-{	for(unsigned sp=0; sp<species.size(); sp++)
-		if(HVdagCq[sp]) HCq += *(species[sp]->getV(Cq)) * HVdagCq[sp];
+{	std::vector<bool> spMask(species.size(), false); //species with non-zero projected gradients
+	int nColsOut = 0;
+	for(unsigned sp=0; sp<species.size(); sp++)
+		if(HVdagCq[sp])
+		{	spMask[sp] = true;
+			nColsOut = HVdagCq[sp].nCols();
+		}
+	//Accumulate from blocks of projectors concatenated over species:
+	int nSpinor = Cq.spinorLength();
+	const Basis& basis = *(Cq.basis);
+	for(const std::vector<ProjectorBlockEntry>& block: getProjectorBlocks(spMask, std::max(Cq.nCols(), int(projectorBlockSize))))
+	{	ColumnBundle V(nProjectorBlockCols(block), basis.nbasis, &basis, Cq.qnum, isGpuEnabled()); //not a spinor regardless of spin type
+		matrix HVdagCblock(V.nCols()*nSpinor, nColsOut, isGpuEnabled());
+		for(const ProjectorBlockEntry& entry: block)
+		{	species[entry.sp]->getV(Cq, entry.atomStart, entry.atomStop, V.dataPref() + entry.colStart*basis.nbasis);
+			int nProj = species[entry.sp]->nAtomProjectors() * nSpinor;
+			int nRows = nProj * (entry.atomStop - entry.atomStart);
+			int rowStart = nSpinor * entry.colStart;
+			HVdagCblock.set(rowStart, rowStart+nRows, 0, nColsOut,
+				HVdagCq[entry.sp](nProj*entry.atomStart, nProj*entry.atomStop, 0, nColsOut));
+		}
+		HCq += V * HVdagCblock;
+	}
 }
 
 //----- DFT+U functions --------
@@ -65,6 +65,9 @@ public:
 	double vdWscale; //!< If non-zero, override the default scale parameter
 	double ljOverride; //!< If non-zero, replace electronic DFT with LJ pair potential with rCut=ljOverride (for testing geometry optimization and dynamics algorithms only)
 	std::vector<IonicGaussianPotential> ionicGaussianPotentials; //!< External Gaussian potentials and forces on atoms
+	string orbitalCacheDir; //!< If non-empty, directory in which reciprocal-space atomic orbitals are cached between runs (eg. in a job array)
+	string pspCacheDir; //!< If non-empty, directory in which reciprocal-space pseudopotential radial functions are cached between runs
+	IonicPreconditioner ionicPrecond; //!< preconditioner for ionic / lattice minimization
 	
 	IonicGradient forces; //!< forces at current atomic positions in latice coordinates
 	matrix3<> stress; //!< stresses at current lattice geometry in Eh/a0^3 (only calculated if optimizing lattice or dumping stress)
@@ -152,6 +155,17 @@ private:
 	
 	//! Compute pulay contributions to energy and optionally stress
 	double calcEpulay(matrix3<>* E_RRT=0) const;
+	
+	//! Range of atoms of one species within a block of projectors concatenated over species
+	struct ProjectorBlockEntry
+	{	int sp; //!< species index
+		int atomStart, atomStop; //!< range of atoms of this species
+		int colStart; //!< column offset of the first projector of these atoms in the block
+	};
+	//! Divide atoms of the species selected by spMask into blocks of at most nColsMax projectors (but at least one atom)
+	std::vector<std::vector<ProjectorBlockEntry>> getProjectorBlocks(const std::vector<bool>& spMask, int nColsMax) const;
+	int nProjectorBlockCols(const std::vector<ProjectorBlockEntry>& block) const; //!< number of projectors in a block
+	static const int projectorBlockSize = 256; //!< minimum number of projectors per block in project() and projectGrad()
 };
 
 //! @}
@@ -27,6 +27,7 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #include <electronic/IonicDynamics.h>
 #include <core/Random.h>
 #include <core/BlasExtra.h>
+#include <core/Telemetry.h>
 
 IonicDynamics::IonicDynamics(Everything& e)
 : e(e),
@@ -248,6 +249,7 @@ LatticeGradient IonicDynamics::thermostat(const LatticeGradient& vel)
 bool IonicDynamics::report(int iter, double t)
 {	logPrintf("\nIonicDynamics: Step: %3d  PE: %10.6lf  KE: %10.6lf  T[K]: %8.3lf  P[Bar]: %8.4le  tMD[fs]: %9.2lf  t[s]: %9.2lf\n",
 		iter, PE, KE, T/Kelvin, p/Bar, t/fs, clock_sec());
+	Telemetry::record("ionic", iter, PE, NAN);
 	if(e.iInfo.computeStress)
 	{	logPrintf("\n# Stress tensor including kinetic terms in Cartesian coordinates [Eh/a0^3]:\n");
 		stress.print(globalLog, "%12lg ", true, 1e-14);
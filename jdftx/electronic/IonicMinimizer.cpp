@@ -26,6 +26,7 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #include <electronic/Dump.h>
 #include <core/Random.h>
 #include <core/BlasExtra.h>
+#include <functional>
 
 const double IonicMinimizer::maxAtomTestDisplacement = 0.1; //in bohrs
 const double IonicMinimizer::maxWfnsDragDisplacement = 0.02; //in bohrs
@@ -311,6 +312,8 @@ double IonicMinimizer::compute(IonicGradient* grad, IonicGradient* Kgrad)
 		//Preconditioned gradient:
 		if(Kgrad)
 		{	*Kgrad = *grad;
+			if((not dynamicsMode) and e.iInfo.ionicPrecond.type==IonicPreconditioner::Exp)
+				applyExpPreconditioner(*Kgrad);
 			//Apply scale factors:
 			for(unsigned sp=0; sp<Kgrad->size(); sp++)
 			{	const SpeciesInfo& spInfo = *(e.iInfo.species[sp]);
@@ -409,6 +412,110 @@ double IonicMinimizer::safeStepSize(const IonicGradient& dir) const
 	return maxAtomTestDisplacement/dMax;
 }
 
+void IonicMinimizer::applyExpPreconditioner(IonicGradient& Kgrad) const
+{	static StopWatch watch("IonicPreconditioner"); watch.start();
+	const IonicPreconditioner& precond = e.iInfo.ionicPrecond;
+	const GridInfo& gInfo = e.gInfo;
+	//Collect atom positions (lattice coordinates), and project gradients of constrained atoms:
+	std::vector< vector3<> > pos, g;
+	std::vector<bool> isFixed;
+	for(unsigned sp=0; sp<Kgrad.size(); sp++)
+	{	const SpeciesInfo& spInfo = *(e.iInfo.species[sp]);
+		pos.insert(pos.end(), spInfo.atpos.begin(), spInfo.atpos.end());
+		for(unsigned atom=0; atom<Kgrad[sp].size(); atom++)
+		{	const SpeciesInfo::Constraint& constraint = spInfo.constraints[atom];
+			g.push_back(constraint(Kgrad[sp][atom]));
+			isFixed.push_back(!constraint.moveScale);
+		}
+	}
+	int nAtoms = pos.size();
+	//Periodic image ranges (none along truncated directions):
+	vector3<bool> isTruncated = e.coulombParams.isTruncated();
+	auto forEachPair = [&](double rMax, std::function<void(int,int,double)> f)
+	{	vector3<int> iCellMax;
+		for(int k=0; k<3; k++)
+			iCellMax[k] = isTruncated[k] ? 0 : int(ceil(rMax * gInfo.invR.row(k).length()));
+		for(int i=0; i<nAtoms; i++)
+			for(int j=i+1; j<nAtoms; j++) //self-image pairs (i==j) do not contribute to the Laplacian
+			{	vector3<> dx = pos[j] - pos[i];
+				for(int k=0; k<3; k++) if(!isTruncated[k]) dx[k] -= floor(0.5 + dx[k]);
+				vector3<int> iCell;
+				for(iCell[0]=-iCellMax[0]; iCell[0]<=iCellMax[0]; iCell[0]++)
+				for(iCell[1]=-iCellMax[1]; iCell[1]<=iCellMax[1]; iCell[1]++)
+				for(iCell[2]=-iCellMax[2]; iCell[2]<=iCellMax[2]; iCell[2]++)
+				{	double r = (gInfo.R * (dx + iCell)).length();
+					if(r > 0. && r < rMax) f(i, j, r);
+				}
+			}
+	};
+	if(mpiWorld->isHead())
+	{	//Nearest-neighbour distance:
+		double rNN = DBL_MAX;
+		forEachPair(20., [&](int i, int j, double r) { rNN = std::min(rNN, r); });
+		if(rNN < DBL_MAX)
+		{	//Sparse preconditioner P = mu (cStab I + L), where L is the graph Laplacian with exponential bond weights.
+			//Bonds to fixed atoms only contribute to the diagonal of the movable atom (fixed atoms do not move),
+			//so that fixed atoms neither mix into, nor receive contributions from, the movable ones:
+			std::vector<double> diag(nAtoms, precond.mu * precond.cStab);
+			std::map<std::pair<int,int>,double> bondMap;
+			forEachPair(2.*rNN, [&](int i, int j, double r)
+			{	double c = precond.mu * exp(-precond.A*(r/rNN - 1.));
+				diag[i] += c;
+				diag[j] += c;
+				if(!(isFixed[i] || isFixed[j])) bondMap[std::make_pair(i,j)] += c;
+			});
+			std::vector< std::pair<std::pair<int,int>,double> > bonds(bondMap.begin(), bondMap.end());
+			auto applyP = [&](const std::vector< vector3<> >& x)
+			{	std::vector< vector3<> > y(nAtoms);
+				for(int i=0; i<nAtoms; i++) y[i] = diag[i] * x[i];
+				for(const auto& bond: bonds)
+				{	int i = bond.first.first, j = bond.first.second;
+					y[i] -= bond.second * x[j];
+					y[j] -= bond.second * x[i];
+				}
+				return y;
+			};
+			//Solve P x = g for each Cartesian direction using Jacobi-preconditioned conjugate gradients:
+			std::vector< vector3<> > x(nAtoms), r = g, z(nAtoms), d(nAtoms);
+			vector3<> rz, rzInit;
+			for(int i=0; i<nAtoms; i++)
+			{	d[i] = z[i] = r[i] * (1./diag[i]);
+				for(int k=0; k<3; k++) rz[k] += r[i][k] * z[i][k];
+			}
+			rzInit = rz;
+			const double tol = 1e-16; //on rz relative to its initial value, i.e. 1e-8 on the preconditioned residual norm
+			for(int iter=0; iter<nAtoms; iter++)
+			{	if(rz[0]<=tol*rzInit[0] && rz[1]<=tol*rzInit[1] && rz[2]<=tol*rzInit[2]) break;
+				std::vector< vector3<> > w = applyP(d);
+				vector3<> dw, rzNew;
+				for(int i=0; i<nAtoms; i++)
+					for(int k=0; k<3; k++) dw[k] += d[i][k] * w[i][k];
+				vector3<> alpha, beta;
+				for(int k=0; k<3; k++) alpha[k] = dw[k] ? rz[k]/dw[k] : 0.;
+				for(int i=0; i<nAtoms; i++)
+					for(int k=0; k<3; k++)
+					{	x[i][k] += alpha[k] * d[i][k];
+						r[i][k] -= alpha[k] * w[i][k];
+						z[i][k] = r[i][k] / diag[i];
+						rzNew[k] += r[i][k] * z[i][k];
+					}
+				for(int k=0; k<3; k++) beta[k] = rz[k] ? rzNew[k]/rz[k] : 0.;
+				for(int i=0; i<nAtoms; i++)
+					for(int k=0; k<3; k++) d[i][k] = z[i][k] + beta[k] * d[i][k];
+				rz = rzNew;
+			}
+			g = x;
+		}
+	}
+	//Distribute result (computed on head to keep all processes exactly in sync):
+	mpiWorld->bcastData(g);
+	int iAtom = 0;
+	for(auto& KgradSp: Kgrad)
+		for(vector3<>& Kg: KgradSp)
+			Kg = g[iAtom++];
+	watch.stop();
+}
+
 double IonicMinimizer::sync(double x) const
 {	mpiWorld->bcast(x);
 	return x;
@@ -54,6 +54,19 @@ void randomize(IonicGradient& x); //!< initialize with random numbers
 
 IonicGradient operator*(const matrix3<>&, const IonicGradient&); //!< coordinate transformations
 
+//! Preconditioner for ionic minimization (also used for the ionic part of lattice minimization)
+struct IonicPreconditioner
+{	enum Type
+	{	None, //!< scale gradient by move scale factors alone
+		Exp //!< exponential Hessian model from atomic connectivity (D. Packwood et al, J. Chem. Phys. 144, 164109 (2016))
+	} type;
+	double A; //!< decay rate of bond stiffness with distance, in units of the nearest-neighbour distance (default: 3)
+	double mu; //!< stiffness scale in Eh/bohr^2 (default: 0.01, about 1 eV/A^2)
+	double cStab; //!< diagonal stabilization relative to mu (default: 0.1)
+	
+	IonicPreconditioner() : type(None), A(3.), mu(0.01), cStab(0.1) {}
+};
+
 //! Ionic minimizer
 class IonicMinimizer : public Minimizable<IonicGradient>
 {	Everything& e;
@@ -69,6 +82,7 @@ public:
 	static const double maxWfnsDragDisplacement; //!< maximum atom displacement for which wavefunction drag is allowed
 	double safeStepSize(const IonicGradient& dir) const; //!< enforces IonicMinimizer::maxAtomTestDisplacement on test step size
 	double sync(double x) const; //!< All processes minimize together; make sure scalars are in sync to round-off error
+	const char* telemetryStage() const { return "ionic"; } //!< emit telemetry records for each iteration
 	
 	double minimize(const MinimizeParams& params); //!< minor addition to Minimizable::minimize to invoke charge analysis at final positions
 private:
@@ -76,6 +90,8 @@ private:
 	bool skipWfnsDrag; //!< whether to temprarily skip wavefunction dragging due to large steps
 	bool anyConstrained; //!< whether any atoms are constrained
 	bool dynamicsMode; //!< class used as a helper for IonicDynamics (changes Kgrad to be acceleration in compute)
+	
+	void applyExpPreconditioner(IonicGradient& Kgrad) const; //!< apply inverse of exponential Hessian model to Kgrad (in place)
 };
 
 //! @}
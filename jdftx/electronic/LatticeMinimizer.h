@@ -62,6 +62,7 @@ public:
 	void constrain(LatticeGradient&);
 	double safeStepSize(const LatticeGradient& dir) const;
 	double sync(double x) const; //!< All processes minimize together; make sure scalars are in sync to round-off error
+	const char* telemetryStage() const { return "lattice"; } //!< emit telemetry records for each iteration
 
 	double minimize(const MinimizeParams& params); //!< minor addition to Minimizable::minimize to invoke charge analysis at final positions
 	int nFree() { return (dynamicsMode and statP) ? 1 : int(round(trace(Pfree))); } //!< number of free lattice directions
@@ -0,0 +1,299 @@
+/*-------------------------------------------------------------------
+Copyright 2026 Ravishankar Sundararaman
+
+This file is part of JDFTx.
+
+JDFTx is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+JDFTx is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------*/
+
+#include <electronic/NEB.h>
+#include <electronic/Everything.h>
+#include <commands/parser.h>
+
+const double NEB::climbThreshold = 5.;
+
+NEB::NEB() : nImages(5), kSpring(0.1), climb(true), nIterations(100), fMax(1e-3), dt(1.), maxStep(0.2)
+{
+}
+
+//Get ionic positions (lattice coordinates) of a system
+inline IonicGradient getPositions(const Everything& e)
+{	IonicGradient x;
+	for(const auto& sp: e.iInfo.species)
+		x.push_back(sp->atpos);
+	return x;
+}
+
+//Largest atomic displacement / force magnitude in a Cartesian IonicGradient
+inline double maxAtomLength(const IonicGradient& v)
+{	double result = 0.;
+	for(const auto& vSp: v)
+		for(const vector3<>& vAtom: vSp)
+			result = std::max(result, vAtom.length());
+	return result;
+}
+
+//Number of atoms (and hence vector3's) in an IonicGradient
+inline int nAtomsTot(const IonicGradient& v)
+{	int n = 0;
+	for(const auto& vSp: v) n += vSp.size();
+	return n;
+}
+
+void NEB::run(Everything& e, const std::vector< std::pair<string,string> >& input, bool dryRun)
+{	logPrintf("\n---------- Nudged elastic band ----------\n");
+	if(nImages < 1) die("\nneb requires at least one intermediate image.\n\n");
+	int nTot = nImages + 2; //including end points
+
+	//Initial state (as parsed):
+	std::vector<IonicGradient> x(nTot); //lattice coordinates of all images
+	x[0] = getPositions(e);
+	int nAtoms = nAtomsTot(x[0]);
+
+	//Final state: re-parse input with ion commands replaced by those in finalFilename
+	{	std::vector< std::pair<string,string> > inputFinal;
+		for(const auto& cmd: input)
+			if(cmd.first != "ion")
+				inputFinal.push_back(cmd);
+		for(const auto& cmd: readInputFile(finalFilename))
+			if(cmd.first == "ion")
+				inputFinal.push_back(cmd);
+		Everything eFinal;
+		logSuspend(); parse(inputFinal, eFinal); logResume();
+		x.back() = getPositions(eFinal);
+		for(size_t sp=0; sp<x[0].size(); sp++)
+			if(x.back()[sp].size() != x[0][sp].size())
+				die("\nNumber of atoms of species %s differs between input file and final state '%s'.\n\n",
+					e.iInfo.species[sp]->name.c_str(), finalFilename.c_str());
+	}
+
+	//Linearly interpolate images, using minimum-image displacements from the initial state:
+	IonicGradient dx = x.back() - x[0];
+	for(auto& dxSp: dx)
+		for(vector3<>& dxAtom: dxSp)
+			for(int k=0; k<3; k++)
+				dxAtom[k] -= floor(0.5 + dxAtom[k]);
+	for(int i=1; i<nTot; i++)
+		x[i] = x[0] + dx * (double(i)/(nTot-1));
+
+	//Divide processes into image groups:
+	MPIUtil* mpiWorldFull = mpiWorld;
+	int nGroups = std::min(nImages, mpiWorldFull->nProcesses());
+	MPIUtil mpiImage(0, 0, MPIUtil::ProcDivision(mpiWorldFull, nGroups));
+	int iGroup = mpiImage.procDivision.iGroup;
+	auto owner = [nGroups](int i) { return std::max(i-1, 0) % nGroups; }; //image i>0 to group (i-1) mod nGroups (round-robin, continuing to the final end point); initial end point with image 1 in group 0
+	logPrintf("Distributing %d images (including end points) over %d process groups.\n", nTot, nGroups);
+	logPrintf("Detailed output follows only for images handled by the first group: ");
+	for(int i=0; i<nTot; i++) if(owner(i)==0) logPrintf(" %d", i);
+	logPrintf("\n"); logFlush();
+
+	//Set up images owned by this group:
+	std::vector< std::shared_ptr<Everything> > eImage(nTot);
+	std::vector< std::shared_ptr<IonicMinimizer> > imin(nTot);
+	mpiWorld = &mpiImage; //all existing code uses mpiWorld, which now refers to this group
+	for(int i=0; i<nTot; i++)
+		if(owner(i) == iGroup)
+		{	logPrintf("\n---------- Setting up NEB image %d ----------\n", i); logFlush();
+			eImage[i] = std::make_shared<Everything>();
+			Everything& ei = *eImage[i];
+			logSuspend(); parse(input, ei); logResume();
+			ei.neb.reset();
+			//Distinguish output files of each image:
+			ostringstream ossPrefix; ossPrefix << "image" << i << ".";
+			size_t pos = ei.dump.format.find("$VAR");
+			if(pos != string::npos) ei.dump.format.insert(pos, ossPrefix.str().c_str());
+			//Set positions and initialize:
+			for(size_t sp=0; sp<x[i].size(); sp++)
+				ei.iInfo.species[sp]->atpos = x[i][sp];
+			if(dryRun) ei.eVars.skipWfnsInit = true;
+			ei.setup();
+			imin[i] = std::make_shared<IonicMinimizer>(ei, true);
+		}
+	mpiWorld = mpiWorldFull;
+	Citations::print();
+	if(dryRun)
+	{	logPrintf("Dry run successful: commands are valid and initialization succeeded.\n");
+		return;
+	}
+	logPrintf("Initialization completed successfully at t[s]: %9.2lf\n\n", clock_sec()); logFlush();
+
+	//Move (if needed) and compute images in [iStart,iStop), exchanging energies and forces between groups:
+	std::vector<double> E(nTot);
+	std::vector<IonicGradient> F(nTot);
+	int iIter = 0;
+	auto computeImages = [&](int iStart, int iStop)
+	{	std::vector<double> buf((iStop-iStart)*(1+3*nAtoms), 0.);
+		mpiWorld = &mpiImage;
+		for(int i=iStart; i<iStop; i++)
+			if(eImage[i])
+			{	Everything& ei = *eImage[i];
+				logPrintf("\n---------- NEB iteration %d: image %d ----------\n", iIter, i); logFlush();
+				//Move to current positions:
+				IonicGradient dir = x[i] - getPositions(ei);
+				for(auto& dirSp: dir)
+					for(vector3<>& dirAtom: dirSp)
+						for(int k=0; k<3; k++)
+							dirAtom[k] -= floor(0.5 + dirAtom[k]); //minimum image (atpos may have been wrapped)
+				if(maxAtomLength(dir) > 0.)
+					imin[i]->step(ei.gInfo.R * dir, 1.); //drags wavefunctions to keep them warm
+				//Compute energy and forces:
+				IonicGradient grad;
+				double Ei = imin[i]->compute(&grad, 0);
+				if(std::isnan(Ei))
+					die_alone("\nNEB image %d rejected (overlapping ionic cores): try more images or a better path.\n\n", i);
+				ei.dump(DumpFreq_Ionic, iIter);
+				//Contribute results from group head:
+				if(mpiImage.isHead())
+				{	double* bufData = buf.data() + (i-iStart)*(1+3*nAtoms);
+					*(bufData++) = Ei;
+					for(const auto& gradSp: grad)
+						for(const vector3<>& g: gradSp)
+							for(int k=0; k<3; k++)
+								*(bufData++) = -g[k];
+				}
+			}
+		mpiWorld = mpiWorldFull;
+		mpiWorld->allReduceData(buf, MPIUtil::ReduceSum);
+		//Unpack on all processes:
+		for(int i=iStart; i<iStop; i++)
+		{	const double* bufData = buf.data() + (i-iStart)*(1+3*nAtoms);
+			E[i] = *(bufData++);
+			F[i] = x[0] * 0.; //zeroes of correct dimensions
+			for(auto& Fsp: F[i])
+				for(vector3<>& f: Fsp)
+					for(int k=0; k<3; k++)
+						f[k] = *(bufData++);
+		}
+	};
+	computeImages(0, nTot); //end points computed only once
+
+	//Band optimization (quick-min velocity projection):
+	const matrix3<>& R = e.gInfo.R;
+	const matrix3<> invR = inv(R); //(e.gInfo.invR is not available, since e.setup() is skipped for NEB)
+	std::vector<IonicGradient> v(nTot); //velocities of interior images
+	for(int i=1; i<=nImages; i++) v[i] = x[0] * 0.;
+	bool climbing = false;
+	double t0 = clock_sec();
+	while(true)
+	{	//NEB forces:
+		int iClimb = 0;
+		if(climb)
+			for(int i=1; i<=nImages; i++)
+				if(!iClimb || E[i]>E[iClimb])
+					iClimb = i;
+		std::vector<IonicGradient> fNEB(nTot);
+		double fMaxCur = 0.;
+		for(int pass=0; pass<2; pass++)
+		{	fMaxCur = 0.;
+			for(int i=1; i<=nImages; i++)
+			{	//Improved tangent estimate (Henkelman and Jonsson, J. Chem. Phys. 113, 9978 (2000)):
+				IonicGradient tPlus = R * (x[i+1] - x[i]);
+				IonicGradient tMinus = R * (x[i] - x[i-1]);
+				IonicGradient tau;
+				if(E[i+1]>E[i] && E[i]>E[i-1]) tau = tPlus;
+				else if(E[i+1]<E[i] && E[i]<E[i-1]) tau = tMinus;
+				else
+				{	double dEmax = std::max(fabs(E[i+1]-E[i]), fabs(E[i-1]-E[i]));
+					double dEmin = std::min(fabs(E[i+1]-E[i]), fabs(E[i-1]-E[i]));
+					tau = (E[i+1]>E[i-1])
+						? tPlus*dEmax + tMinus*dEmin
+						: tPlus*dEmin + tMinus*dEmax;
+				}
+				tau *= 1./sqrt(dot(tau,tau));
+				//Projected forces:
+				double Fpar = dot(F[i], tau);
+				if(climbing && i==iClimb)
+					fNEB[i] = F[i] - tau*(2.*Fpar); //climbing image: invert force along path, no springs
+				else
+				{	double Fspring = kSpring * (sqrt(dot(tPlus,tPlus)) - sqrt(dot(tMinus,tMinus)));
+					fNEB[i] = F[i] + tau*(Fspring - Fpar);
+				}
+				//Apply move constraints:
+				for(size_t sp=0; sp<fNEB[i].size(); sp++)
+					for(size_t atom=0; atom<fNEB[i][sp].size(); atom++)
+						fNEB[i][sp][atom] = e.iInfo.species[sp]->constraints[atom](fNEB[i][sp][atom]);
+				fMaxCur = std::max(fMaxCur, maxAtomLength(fNEB[i]));
+			}
+			//Switch on climbing image once band is reasonably converged:
+			if(climb && !climbing && fMaxCur < climbThreshold*fMax)
+			{	climbing = true;
+				logPrintf("NEB: Turning on climbing image for image %d.\n", iClimb);
+				continue; //recompute forces with climbing image
+			}
+			break;
+		}
+
+		//Report:
+		logPrintf("\nNEB: Iter: %3d  Ebarrier: %+.8lf  fMax: %.3le  t[s]: %9.2lf\n",
+			iIter, *std::max_element(E.begin(), E.end()) - E[0], fMaxCur, clock_sec()-t0);
+		logPrintf("NEB: E-E0:");
+		for(int i=0; i<nTot; i++) logPrintf(" %+.6lf", E[i]-E[0]);
+		logPrintf("\n"); logFlush();
+		if(fMaxCur < fMax)
+		{	logPrintf("NEB: Converged (|f|max < %lg).\n", fMax);
+			break;
+		}
+		if(iIter >= nIterations)
+		{	logPrintf("NEB: None of the convergence criteria satisfied after %d iterations.\n", iIter);
+			break;
+		}
+
+		//Velocity-projection step:
+		double vDotF = 0., fSq = 0.;
+		for(int i=1; i<=nImages; i++)
+		{	vDotF += dot(v[i], fNEB[i]);
+			fSq += dot(fNEB[i], fNEB[i]);
+		}
+		double vScale = (vDotF > 0.) ? vDotF/fSq : 0.; //keep only component of velocity along force (reset if uphill)
+		double dispMax = 0.;
+		for(int i=1; i<=nImages; i++)
+		{	v[i] = fNEB[i] * (vScale + dt);
+			dispMax = std::max(dispMax, dt * maxAtomLength(v[i]));
+		}
+		double stepScale = (dispMax > maxStep) ? maxStep/dispMax : 1.;
+		for(int i=1; i<=nImages; i++)
+			x[i] += invR * (v[i] * (dt*stepScale));
+		iIter++;
+		computeImages(1, nTot-1);
+	}
+
+	//Final dumps of images:
+	mpiWorld = &mpiImage;
+	for(int i=1; i<=nImages; i++)
+		if(eImage[i])
+		{	eImage[i]->eInfo.printLoadBalance(eImage[i]->eVars.tStatesMine);
+			eImage[i]->dump(DumpFreq_End, 0);
+		}
+	mpiWorld = mpiWorldFull;
+
+	//Path summary:
+	e.dump.curFreq = DumpFreq_End; e.dump.curIter = 0;
+	string fname = e.dump.getFilename("nebPath");
+	logPrintf("\nDumping NEB path energies to '%s' ... ", fname.c_str()); logFlush();
+	if(mpiWorld->isHead())
+	{	FILE* fp = fopen(fname.c_str(), "w");
+		if(!fp) die_alone("Error opening '%s' for writing.\n", fname.c_str());
+		fprintf(fp, "#image s[bohr] E-E0[Eh] |F|max[Eh/bohr]\n");
+		double s = 0.;
+		for(int i=0; i<nTot; i++)
+		{	if(i)
+			{	IonicGradient dr = R * (x[i] - x[i-1]);
+				s += sqrt(dot(dr,dr));
+			}
+			fprintf(fp, "%d %.6lf %+.10lf %.3le\n", i, s, E[i]-E[0], maxAtomLength(F[i]));
+		}
+		fclose(fp);
+	}
+	logPrintf("done.\n"); logFlush();
+}
@@ -0,0 +1,62 @@
+/*-------------------------------------------------------------------
+Copyright 2026 Ravishankar Sundararaman
+
+This file is part of JDFTx.
+
+JDFTx is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+JDFTx is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
+-------------------------------------------------------------------*/
+
+#ifndef JDFTX_ELECTRONIC_NEB_H
+#define JDFTX_ELECTRONIC_NEB_H
+
+#include <electronic/IonicMinimizer.h>
+#include <core/string.h>
+#include <vector>
+
+//! @addtogroup IonicSystem
+//! @{
+
+/** @brief Nudged elastic band (optionally climbing-image) reaction path calculator
+
+The input file, with ionic positions of the initial state, and a file containing
+ion commands for the final state define the end points of the path. Each image
+of the band is an independent Everything, re-parsed from the input file as in Phonon.
+mpiWorld is split into image groups using MPIUtil::ProcDivision, and each group
+updates and computes its images concurrently with mpiWorld pointing to the group
+communicator, so that all existing code runs unchanged within a group. Images are
+moved in place (with wavefunction drag) so that their electronic state stays warm
+between band iterations; only positions and forces are exchanged between groups.
+*/
+class NEB
+{
+public:
+	int nImages; //!< number of intermediate images (excluding end points)
+	string finalFilename; //!< file containing ion commands for the final state
+	double kSpring; //!< spring constant between images (Eh/bohr^2)
+	bool climb; //!< whether to use climbing image for highest-energy image
+	int nIterations; //!< maximum number of band iterations
+	double fMax; //!< convergence threshold on maximum atomic NEB force (Eh/bohr)
+	double dt; //!< time step for quick-min velocity projection optimizer
+	double maxStep; //!< maximum displacement of any atom in one band iteration (bohrs)
+
+	NEB();
+	
+	//! Set up images from input (already parsed into e, which is not set up) and optimize the band
+	void run(Everything& e, const std::vector< std::pair<string,string> >& input, bool dryRun);
+	
+	static const double climbThreshold; //!< start climbing once max force is below climbThreshold * fMax
+};
+
+//! @}
+#endif // JDFTX_ELECTRONIC_NEB_H
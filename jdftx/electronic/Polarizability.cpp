@@ -24,25 +24,59 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #include <core/LatticeUtils.h>
 #include <core/VectorField.h>
 #include <core/ScalarFieldIO.h>
+#include <set>
 
 Polarizability::Polarizability() : eigenBasis(NonInteracting), Ecut(0), nEigs(0)
 {
 }
 
 
+//Wavefunctions and eigenvalues of the reduced states needed for the current k-point pair,
+//broadcast from their owners on demand so that no process holds all the states at once:
+class StateCache
+{	const Everything& e;
+	std::map<int,ColumnBundle> Cother; //states owned by other processes
+	std::map<int,diagMatrix> eigs; //eigenvalues of all currently available states
+public:
+	StateCache(const Everything& e) : e(e) {}
+	
+	//Make states in qNeeded available on all processes, and drop all others fetched previously.
+	//This is collective: it must be called with the same qNeeded on all processes.
+	void fetch(const std::set<int>& qNeeded)
+	{	for(auto iter=eigs.begin(); iter!=eigs.end();)
+		{	if(qNeeded.count(iter->first)) iter++;
+			else { Cother.erase(iter->first); iter = eigs.erase(iter); }
+		}
+		for(int q: qNeeded)
+		{	if(eigs.count(q)) continue; //already available (same decision on all processes)
+			diagMatrix& eig = eigs[q];
+			if(e.eInfo.isMine(q)) eig = e.eVars.Hsub_eigs[q];
+			else
+			{	Cother[q].init(e.eInfo.nBands, e.basis[q].nbasis*e.eInfo.spinorLength(), &e.basis[q], &e.eInfo.qnums[q], isGpuEnabled());
+				eig.resize(e.eInfo.nBands);
+			}
+			mpiWorld->bcastData((ColumnBundle&)C(q), e.eInfo.whose(q));
+			mpiWorld->bcastData(eig, e.eInfo.whose(q));
+		}
+	}
+	
+	const ColumnBundle& C(int q) const { return e.eInfo.isMine(q) ? e.eVars.C[q] : Cother.find(q)->second; }
+	const diagMatrix& eig(int q) const { return eigs.find(q)->second; }
+};
+
+
 class PairDensityCalculator
-{
-	int nK;
+{	int nK;
 	
 	struct State
 	{	const ColumnBundle* C;
 		const diagMatrix* eig;
 		std::shared_ptr<ColumnBundleTransform> transform;
 		
-		void setup(const Everything& e, vector3<> k, const Supercell::KmeshTransform& kTransform)
+		void setup(const Everything& e, vector3<> k, const Supercell::KmeshTransform& kTransform, const StateCache& states)
 		{	//Get the columnbundle and eigenvalues:
-			C = &(e.eVars.C[kTransform.iReduced]);
-			eig = &(e.eVars.Hsub_eigs[kTransform.iReduced]);
+			C = &(states.C(kTransform.iReduced));
+			eig = &(states.eig(kTransform.iReduced));
 			//Compute the index array
 			logSuspend();
 			basisOut.setup(e.gInfo, e.iInfo, e.cntrl.Ecut, k);
@@ -99,57 +133,58 @@ class PairDensityCalculator
 
 public:
 	//Setup to compute pair densities between kmesh[ik] and its partner dk away
-	PairDensityCalculator(const Everything& e, const vector3<>& dk, int ik)
+	//(the states listed by reducedStates() must be available in states)
+	PairDensityCalculator(const Everything& e, const vector3<>& dk, int ik, const StateCache& states)
 	{
-		//Find the transformations / data sources for the two k-points:
 		const std::vector< vector3<> >& kmesh = e.coulombParams.supercell->kmesh;
-		const std::vector<Supercell::KmeshTransform>& kmeshTransform = e.coulombParams.supercell->kmeshTransform;
 		nK = kmesh.size();
 		vector3<> k2 = kmesh[ik] + dk;
 		
-		state1.setup(e, kmesh[ik], kmeshTransform[ik]); //setup first state (always from current system's kmesh)
+		state1.setup(e, kmesh[ik], e.coulombParams.supercell->kmeshTransform[ik], states); //setup first state (always from current system's kmesh)
 		
 		if(e.dump.polarizability->dkFilenamePattern.length()) //get second state from external data
 		{	state2.setup(e, k2,
 				e.dump.polarizability->dkFilename(ik,"wfns"),
 				e.dump.polarizability->dkFilename(ik,"eigenvals") );
 		}
-		else //get second state from current system's kmesh as well
-		{	bool foundk2 = false;
-			Supercell::KmeshTransform kTransform2 = {0, 0, 0, vector3<int>()};
-			for(unsigned ik2=0; ik2<kmesh.size(); ik2++)
-				if(circDistanceSquared(kmesh[ik2],k2) < symmThresholdSq)
-				{	double offsetErr;
-					kTransform2 = kmeshTransform[ik2];
-					kTransform2.offset += round(k2 - kmesh[ik2], &offsetErr);
-					foundk2 = true;
-					assert(offsetErr < symmThreshold);
-					break;
-				}
-			assert(foundk2); //such a partner should always be found for a uniform kmesh
-			state2.setup(e, k2, kTransform2);
-		}
+		else state2.setup(e, k2, partnerTransform(e, dk, ik), states); //get second state from current system's kmesh as well
 	}
-
+	
+	//Reduced states (from the current system) needed for pair densities between kmesh[ik] and its partner dk away
+	static std::set<int> reducedStates(const Everything& e, const vector3<>& dk, int ik)
+	{	std::set<int> qNeeded;
+		qNeeded.insert(e.coulombParams.supercell->kmeshTransform[ik].iReduced);
+		if(!e.dump.polarizability->dkFilenamePattern.length())
+			qNeeded.insert(partnerTransform(e, dk, ik).iReduced);
+		return qNeeded;
+	}
+	
 	//Store resulting pair densities scaled by 2*invsqrt(eigenvalue differences) in rho,
 	//so that the non-interacting susceptibility is negative identity in this basis.
-	void compute(int nV, int nC, ColumnBundle& rho, int kOffset) const
-	{	threadLaunch(isGpuEnabled() ? 1 : 0, compute_thread, nV*nC, nV, nC, &rho, kOffset, this);
+	//Pairs (v,c) with index v*nC+c in [pairStart,pairStop) are stored in columns starting at colOffset.
+	void compute(int nV, int nC, ColumnBundle& rho, int colOffset, int pairStart=0, int pairStop=-1) const
+	{	if(pairStop<0) pairStop = nV*nC;
+		threadLaunch(isGpuEnabled() ? 1 : 0, compute_thread, pairStop-pairStart, pairStart, nV, nC, &rho, colOffset-pairStart, this);
 	}
 	
-	//Accumulate contribution from currentkpoint pair to negative of noninteracting susceptibility in plane-wave basis:
-	void accumMinusXniPW(int nV, int nC, const Basis& basis, matrix& minusXni)
-	{	assert(minusXni.nRows() == int(basis.nbasis));
-		assert(minusXni.nCols() == int(basis.nbasis));
-		ColumnBundle rho(nV*nC, basis.nbasis, &basis);
-		compute(nV, nC, rho, 0);
-		//Xni += (detR)*rho*dagger(rho):
-		callPref(eblas_zgemm)(CblasNoTrans, CblasConjTrans, basis.nbasis, basis.nbasis, rho.nCols(),
-			basis.gInfo->detR, rho.dataPref(), rho.colLength(), rho.dataPref(), rho.colLength(),
-			1., minusXni.dataPref(), minusXni.nRows());
+private:
+	//Find the transformation to kmesh[ik] + dk from the current system's kmesh
+	static Supercell::KmeshTransform partnerTransform(const Everything& e, const vector3<>& dk, int ik)
+	{	const std::vector< vector3<> >& kmesh = e.coulombParams.supercell->kmesh;
+		const std::vector<Supercell::KmeshTransform>& kmeshTransform = e.coulombParams.supercell->kmeshTransform;
+		vector3<> k2 = kmesh[ik] + dk;
+		for(unsigned ik2=0; ik2<kmesh.size(); ik2++)
+			if(circDistanceSquared(kmesh[ik2],k2) < symmThresholdSq)
+			{	double offsetErr;
+				Supercell::KmeshTransform kTransform2 = kmeshTransform[ik2];
+				kTransform2.offset += round(k2 - kmesh[ik2], &offsetErr);
+				assert(offsetErr < symmThreshold);
+				return kTransform2;
+			}
+		assert(!"Partner k-point not found"); //such a partner should always be found for a uniform kmesh
+		return kmeshTransform[ik];
 	}
 	
-private:
 	void compute_sub(int bStart, int bStop, int nV, int nC, ColumnBundle* rho, int kOffset) const
 	{	int b = bStart;
 		int v = b / nC;
@@ -164,8 +199,8 @@ private:
 			if(c==nC) { c=0; v++; conjICv = conj(I(state1.getColumn(v))); }
 		}
 	}
-	static void compute_thread(int bStart, int bStop, int nV, int nC, ColumnBundle* rho, int kOffset, const PairDensityCalculator* pdc)
-	{	pdc->compute_sub(bStart, bStop, nV, nC, rho, kOffset);
+	static void compute_thread(int bStart, int bStop, int pairStart, int nV, int nC, ColumnBundle* rho, int kOffset, const PairDensityCalculator* pdc)
+	{	pdc->compute_sub(pairStart+bStart, pairStart+bStop, nV, nC, rho, kOffset);
 	}
 };
 
@@ -174,11 +209,131 @@ inline void coulomb_thread(int bStart, int bStop, const Everything* e, vector3<>
 		Krho->setColumn(b,0, (*(e->coulombWfns))(rho->getColumn(b,0), dk, 0.));
 }
 
-matrix coulombMatrix(const ColumnBundle& V, const Everything& e, vector3<> dk)
+//Assemble on the head process a matrix with nRows x nCols from column blocks Msub (divided over processes by colDiv).
+//Returns an empty matrix on all other processes.
+matrix gatherColumns(const matrix& Msub, int nRows, const TaskDivision& colDiv, int nCols)
+{	const int tag = 0;
+	if(!mpiWorld->isHead())
+	{	if(Msub.nData()) mpiWorld->sendData(Msub, 0, tag);
+		return matrix();
+	}
+	matrix M(nRows, nCols);
+	for(int jProc=0; jProc<mpiWorld->nProcesses(); jProc++)
+	{	int jStart = colDiv.start(jProc), jStop = colDiv.stop(jProc);
+		if(jStart == jStop) continue;
+		if(jProc == mpiWorld->iProcess()) M.set(0,nRows, jStart,jStop, Msub);
+		else
+		{	matrix Mj(nRows, jStop-jStart);
+			mpiWorld->recvData(Mj, jProc, tag);
+			M.set(0,nRows, jStart,jStop, Mj);
+		}
+	}
+	return M;
+}
+
+//Distribute column blocks (divided over processes by colDiv) of matrix M with nRows rows, available only on the head process
+matrix scatterColumns(const matrix& M, int nRows, const TaskDivision& colDiv)
+{	const int tag = 0;
+	matrix Msub(nRows, colDiv.stop()-colDiv.start());
+	if(mpiWorld->isHead())
+	{	for(int jProc=0; jProc<mpiWorld->nProcesses(); jProc++)
+		{	int jStart = colDiv.start(jProc), jStop = colDiv.stop(jProc);
+			if(jStart == jStop) continue;
+			if(jProc == mpiWorld->iProcess()) Msub = M(0,nRows, jStart,jStop);
+			else mpiWorld->sendData(matrix(M(0,nRows, jStart,jStop)), jProc, tag);
+		}
+	}
+	else if(Msub.nData()) mpiWorld->recvData(Msub, 0, tag);
+	return Msub;
+}
+
+//Orthonormal basis V for the response matrices, with columns divided over processes by colDiv.
+//Each process stores only its own block of columns; the other blocks are broadcast one at a time when
+//needed, except in the plane-wave basis where V is a scaled identity and the blocks are generated locally.
+struct ResponseBasis
+{	const Basis& basis;
+	const QuantumNumber& qnum;
+	const int nColumns;
+	const bool pwBasis;
+	const TaskDivision colDiv;
+	ColumnBundle Vsub; //columns [colDiv.start(),colDiv.stop()) of V
+	
+	ResponseBasis(const Basis& basis, const QuantumNumber& qnum, int nColumns, bool pwBasis)
+	: basis(basis), qnum(qnum), nColumns(nColumns), pwBasis(pwBasis), colDiv(nColumns, mpiWorld)
+	{	Vsub = block(colDiv.start(), colDiv.stop());
+	}
+	
+	//Call f(Vj, jStart) with the block of columns Vj of V starting at jStart, for each process's block in turn (collective)
+	template<typename Func> void forEachBlock(const Func& f) const
+	{	for(int jProc=0; jProc<mpiWorld->nProcesses(); jProc++)
+		{	int jStart = colDiv.start(jProc), jStop = colDiv.stop(jProc);
+			if(jStart == jStop) continue;
+			if(jProc == mpiWorld->iProcess())
+			{	if(!pwBasis) mpiWorld->bcastData((ColumnBundle&)Vsub, jProc);
+				f(Vsub, jStart);
+			}
+			else
+			{	ColumnBundle Vj = block(jStart, jStop);
+				if(!pwBasis) mpiWorld->bcastData(Vj, jProc);
+				f(Vj, jStart);
+			}
+		}
+	}
+	
+	//Compute V^Ysub for a local block of columns Ysub (collective)
+	matrix overlap(const ColumnBundle& Ysub) const
+	{	matrix M = zeroes(nColumns, Ysub.nCols());
+		forEachBlock([&](const ColumnBundle& Vj, int jStart)
+		{	if(Ysub.nCols()) M.set(jStart,jStart+Vj.nCols(), 0,Ysub.nCols(), Vj^Ysub);
+		});
+		return M;
+	}
+	
+	//Compute V*Usub for a local block of columns Usub of a matrix with nColumns rows (collective)
+	ColumnBundle transform(const matrix& Usub) const
+	{	ColumnBundle VU(Usub.nCols(), basis.nbasis, &basis, &qnum, isGpuEnabled());
+		if(Usub.nCols()) VU.zero();
+		forEachBlock([&](const ColumnBundle& Vj, int jStart)
+		{	if(Usub.nCols()) VU += Vj * Usub(jStart,jStart+Vj.nCols(), 0,Usub.nCols());
+		});
+		return VU;
+	}
+	
+private:
+	//Storage for columns [jStart,jStop), initialized to the scaled identity in the plane-wave basis
+	ColumnBundle block(int jStart, int jStop) const
+	{	ColumnBundle Vj(jStop-jStart, basis.nbasis, &basis, &qnum, isGpuEnabled());
+		if(pwBasis && Vj.nCols())
+		{	Vj.zero();
+			complex* Vdata = Vj.data();
+			double invsqrtVol = 1./sqrt(basis.gInfo->detR);
+			for(int j=jStart; j<jStop; j++) Vdata[Vj.index(j-jStart,j)] = invsqrtVol;
+		}
+		return Vj;
+	}
+};
+
+//Accumulate contribution from pair densities rho (in the plane-wave basis) to a block of columns
+//starting at colStart of the negative of the non-interacting susceptibility in the plane-wave basis
+void accumMinusXniPW(const ColumnBundle& rho, matrix& minusXniSub, int colStart)
+{	assert(minusXniSub.nRows() == int(rho.colLength()));
+	if(!minusXniSub.nCols()) return;
+	//Xni(:,cols) += (detR)*rho*dagger(rho(cols,:)):
+	callPref(eblas_zgemm)(CblasNoTrans, CblasConjTrans, rho.colLength(), minusXniSub.nCols(), rho.nCols(),
+		rho.basis->gInfo->detR, rho.dataPref(), rho.colLength(), rho.dataPref()+colStart, rho.colLength(),
+		1., minusXniSub.dataPref(), minusXniSub.nRows());
+}
+
+//Assemble the matrix of a kernel on the head process, given its action KVsub on the local columns of V
+matrix kernelMatrix(const ResponseBasis& V, const ColumnBundle& KVsub)
+{	return gatherColumns(V.basis.gInfo->detR * V.overlap(KVsub), V.nColumns, V.colDiv, V.nColumns);
+}
+
+matrix coulombMatrix(const ResponseBasis& V, const Everything& e, vector3<> dk)
 {	logPrintf("\tForming Coulomb matrix\n"); logFlush();
-	ColumnBundle KV = V.similar();
-	threadLaunch(isGpuEnabled() ? 1 : 0, coulomb_thread, V.nCols(), &e, dk, &V, &KV);
-	return e.gInfo.detR * (V^KV);
+	ColumnBundle KVsub = V.Vsub.similar();
+	threadLaunch(isGpuEnabled() ? 1 : 0, coulomb_thread, V.Vsub.nCols(), &e, dk, &V.Vsub, &KVsub);
+	return kernelMatrix(V, KVsub);
 }
 
 
@@ -245,7 +400,7 @@ inline void exCorr_thread(int bStart, int bStop, const ScalarField* exc_nn, cons
 	}
 }
 
-matrix exCorrMatrix(const ColumnBundle& V, const Everything& e, const ScalarField& n, vector3<> dk)
+matrix exCorrMatrix(const ResponseBasis& V, const Everything& e, const ScalarField& n, vector3<> dk)
 {	logPrintf("\tForming Exchange-Correlation matrix\n"); logFlush();
 	//Get second derivatives w.r.t density (and gradients)
 	ScalarField exc_nn, exc_sigma, exc_nsigma, exc_sigmasigma;
@@ -253,19 +408,19 @@ matrix exCorrMatrix(const ColumnBundle& V, const Everything& e, const ScalarFiel
 	e.exCorr.getSecondDerivatives(n, exc_nn, exc_sigma, exc_nsigma, exc_sigmasigma);
 	if(exc_sigma) Dn = gradient(n); //needed for GGAs
 	//Change grid if necessary:
-	if(&(n->gInfo) != V.basis->gInfo)
-	{	exc_nn = changeGrid(exc_nn, *(V.basis->gInfo));
+	if(&(n->gInfo) != V.basis.gInfo)
+	{	exc_nn = changeGrid(exc_nn, *(V.basis.gInfo));
 		if(exc_sigma)
-		{	for(int k=0; k<3; k++) Dn[k] = changeGrid(Dn[k], *(V.basis->gInfo));
-			exc_sigma = changeGrid(exc_sigma, *(V.basis->gInfo));
-			exc_nsigma = changeGrid(exc_nsigma, *(V.basis->gInfo));
-			exc_sigmasigma = changeGrid(exc_sigmasigma, *(V.basis->gInfo));
+		{	for(int k=0; k<3; k++) Dn[k] = changeGrid(Dn[k], *(V.basis.gInfo));
+			exc_sigma = changeGrid(exc_sigma, *(V.basis.gInfo));
+			exc_nsigma = changeGrid(exc_nsigma, *(V.basis.gInfo));
+			exc_sigmasigma = changeGrid(exc_sigmasigma, *(V.basis.gInfo));
 		}
 	}
-	//Compute matrix:
-	ColumnBundle KXCV = V.similar();
-	threadLaunch(isGpuEnabled() ? 1 : 0, exCorr_thread, V.nCols(), &exc_nn, &Dn, &exc_sigma, &exc_nsigma, &exc_sigmasigma, &V, &KXCV);
-	return e.gInfo.detR * (V^KXCV);
+	//Compute matrix (columns distributed over processes):
+	ColumnBundle KXCVsub = V.Vsub.similar();
+	threadLaunch(isGpuEnabled() ? 1 : 0, exCorr_thread, V.Vsub.nCols(), &exc_nn, &Dn, &exc_sigma, &exc_nsigma, &exc_sigmasigma, &V.Vsub, &KXCVsub);
+	return kernelMatrix(V, KXCVsub);
 }
 
 
@@ -297,39 +452,82 @@ void Polarizability::dump(const Everything& e)
 	int nC = e.eInfo.nBands - nV;
 	int nK = kmesh.size();
 	if(nC <= 0) die("\nNo unoccupied states available for polarizability calculation.\n");
-	int nCVK = nC * nV * nK;
+	int nPairs = nV * nC;
+	int nCVK = nPairs * nK;
 	
 	//Determine whether to start out in CV or PW basis:
 	bool pwBasis = (2*nCVK > int(basis.nbasis)); //switch to PW basis a little early since CV basis begins to become numerically unstable
 	int nColumns = pwBasis ? int(basis.nbasis) : nCVK;
 	const char* basisName = pwBasis ? "PW" : "CV";
 	
+	//Vectors and matrices in this basis are stored as column blocks distributed over processes;
+	//the dense nColumns x nColumns matrices are only assembled on the head process for the final solve.
 	QuantumNumber qnum; qnum.k = dk; qnum.spin = 0; qnum.weight = 1./nK;
-	ColumnBundle V(nColumns, basis.nbasis, &basis, &qnum); //orthonormal basis vectors
-	matrix Xni; //non-interacting susceptibility (in basis V)
+	ResponseBasis V(basis, qnum, nColumns, pwBasis); //orthonormal basis vectors
+	matrix Xni; //non-interacting susceptibility (in basis V, on head only)
 	
 	if(pwBasis)
 	{	logPrintf("\tComputing NonInteracting polarizability in plane-wave basis\n"); logFlush();
-		//Set the basis to an identity matrix:
-		V.zero();
-		complex* Vdata = V.data();
-		double invsqrtVol = 1./sqrt(e.gInfo.detR);
-		for(int i=0; i<nColumns; i++) Vdata[V.index(i,i)] = invsqrtVol;
-		//Get the PW basis non-interacting susceptibility matrix:
-		matrix minusXni(nColumns, nColumns); minusXni.zero();
+		//Each process accumulates its own block of columns of the PW basis non-interacting susceptibility.
+		//In each round, every process computes one block of pairs, which is then broadcast to all processes:
+		matrix minusXniSub = zeroes(nColumns, V.Vsub.nCols());
+		int nBlocksPerK = ceildiv(nPairs, nPairsPerBlock);
+		int nProcs = mpiWorld->nProcesses(), iProc = mpiWorld->iProcess();
+		StateCache states(e);
 		for(int ik=0; ik<nK; ik++)
-			PairDensityCalculator(e, dk, ik).accumMinusXniPW(nV, nC, basis, minusXni);
-		Xni = -minusXni;
+		{	states.fetch(PairDensityCalculator::reducedStates(e, dk, ik));
+			PairDensityCalculator pdc(e, dk, ik, states);
+			for(int iRound=0; iRound<nBlocksPerK; iRound+=nProcs)
+			{	int nProcsRound = std::min(nProcs, nBlocksPerK-iRound); //number of processes with a block in this round
+				auto pairRange = [&](int jProc, int& pairStart, int& pairStop)
+				{	pairStart = (iRound+jProc)*nPairsPerBlock;
+					pairStop = std::min(pairStart+nPairsPerBlock, nPairs);
+				};
+				//Compute local block:
+				ColumnBundle rhoMine;
+				if(iProc < nProcsRound)
+				{	int pairStart, pairStop; pairRange(iProc, pairStart, pairStop);
+					rhoMine.init(pairStop-pairStart, basis.nbasis, &basis, 0);
+					pdc.compute(nV, nC, rhoMine, 0, pairStart, pairStop);
+				}
+				//Accumulate all blocks of this round into local columns:
+				for(int jProc=0; jProc<nProcsRound; jProc++)
+				{	ColumnBundle rhoOther;
+					if(jProc != iProc)
+					{	int pairStart, pairStop; pairRange(jProc, pairStart, pairStop);
+						rhoOther.init(pairStop-pairStart, basis.nbasis, &basis, 0);
+					}
+					ColumnBundle& rho = (jProc == iProc) ? rhoMine : rhoOther;
+					mpiWorld->bcastData(rho, jProc);
+					accumMinusXniPW(rho, minusXniSub, V.colDiv.start());
+				}
+			}
+		}
+		matrix minusXni = gatherColumns(minusXniSub, nColumns, V.colDiv, nColumns);
+		if(mpiWorld->isHead()) Xni = -minusXni;
 	}
 	else
 	{	logPrintf("\tComputing occupied x unoccupied (CV) pair-densities and NonInteracting polarizability\n"); logFlush();
+		//Each process computes the pair densities in its own block of columns (with index ik*nPairs + pair index):
+		int colStart = V.colDiv.start(), colStop = V.colDiv.stop();
+		StateCache states(e);
 		for(int ik=0; ik<nK; ik++)
-			PairDensityCalculator(e, dk, ik).compute(nV, nC, V, ik*nV*nC);
-		matrix invXni = -eye(nColumns); //inverse of non-interacting susceptibility
+		{	states.fetch(PairDensityCalculator::reducedStates(e, dk, ik));
+			int pairStart = std::max(colStart - ik*nPairs, 0);
+			int pairStop = std::min(colStop - ik*nPairs, nPairs);
+			if(pairStart < pairStop)
+				PairDensityCalculator(e, dk, ik, states).compute(nV, nC, V.Vsub, ik*nPairs + pairStart - colStart, pairStart, pairStop);
+		}
 		logPrintf("\tOrthonormalizing basis\n"); logFlush();
-		matrix Umhalf = invsqrt(e.gInfo.detR*(V^V));
-		V = V * Umhalf;
-		Xni = dagger_symmetrize(inv(Umhalf * invXni * Umhalf));
+		matrix Umhalf; //on head only
+		{	matrix S = gatherColumns(e.gInfo.detR * V.overlap(V.Vsub), nColumns, V.colDiv, nColumns); //overlap matrix
+			if(mpiWorld->isHead())
+			{	matrix invXni = -eye(nColumns); //inverse of non-interacting susceptibility
+				Umhalf = invsqrt(S);
+				Xni = dagger_symmetrize(inv(Umhalf * invXni * Umhalf));
+			}
+		}
+		V.Vsub = V.transform(scatterColumns(Umhalf, nColumns, V.colDiv));
 	}
 	
 	logPrintf("\tClearing orthogonal wavefunctions (C) to free memory.\n"); ((Everything&)e).eVars.C.clear();
@@ -340,77 +538,97 @@ void Polarizability::dump(const Everything& e)
 	logPrintf("\tApplying Exchange-Correlation kernel\n"); logFlush();
 	matrix KXC = exCorrMatrix(V, e, e.eVars.get_nTot(), dk);
 	
-	//Compute operator matrices in current (CV) basis
-	logPrintf("\tComputing External and Total polarizability matrices in %s basis\n", basisName); logFlush();
-	matrix Xtot = dagger_symmetrize(inv(eye(nColumns) - Xni*(  KXC  )) * Xni); //charge response to total electrostatic potential
-	matrix Xext = dagger_symmetrize(inv(eye(nColumns) - Xni*(K + KXC)) * Xni); //charge response to external electrostatic potential
-	
-	//Compute dielectric band structure:
-	{	string fname = e.dump.getFilename("epsInvEigs");
-		logPrintf("\tDumping '%s' ... ", fname.c_str()); logFlush();
-		matrix epsInvEvecs; diagMatrix epsInvEigs;
-		matrix Khalf = pow(dagger_symmetrize(K), 0.5);
-		matrix epsInv = eye(nColumns) + Khalf * Xext * Khalf;
-		epsInv.diagonalize(epsInvEvecs, epsInvEigs); //epsInv (symmetrized)
-		FILE* fp=fopen(fname.c_str(), "w");
-		epsInvEigs.print(fp, "%.15f\n");
-		fclose(fp);
-		logPrintf("Done.\n"); logFlush();
-		//Print head:
-		size_t iGzero = 0;
+	//Row of V at G=0 (for the head of the inverse dielectric matrix below):
+	matrix V0;
+	{	size_t iGzero = 0;
 		for(const vector3<int>& iG: basis.iGarr)
 		{	if(!iG.length_squared()) break;
 			iGzero++;
 		}
 		assert(iGzero < basis.nbasis);
-		matrix V0(1, nColumns);
-		for(int j=0; j<nColumns; j++)
-			V0.set(0,j, V.data()[V.index(j,iGzero)]);
-		V0 *= 1./sqrt(trace(V0*dagger(V0)).abs()); //normalize
-		double epsInvHead = trace(V0 * epsInv * dagger(V0)).abs();
-		logPrintf("\thead(epsInv): %lg   1/head(epsInv): %lg\n", epsInvHead, 1./epsInvHead);
+		matrix V0sub(1, V.Vsub.nCols());
+		for(int j=0; j<V.Vsub.nCols(); j++)
+			V0sub.set(0,j, V.Vsub.data()[V.Vsub.index(j,iGzero)]);
+		V0 = gatherColumns(V0sub, 1, V.colDiv, nColumns);
 	}
-
-	//Determine transformation to chosen eigen-basis
+	
 	extern EnumStringMap<EigenBasis> polarizabilityMap;
-	logPrintf("\tComputing transformation matrix from %s to %s polarizability eigen-basis\n", basisName, polarizabilityMap.getString(eigenBasis)); logFlush();
-	const matrix* Xbasis = 0;
-	switch(eigenBasis)
-	{	case NonInteracting: Xbasis = &Xni; break;
-		case External: Xbasis = &Xext; break;
-		case Total: Xbasis = &Xtot; break;
-		default: assert(!"Invalid eigenBasis");
-	}
 	if(nEigs<=0 || nEigs>nColumns) nEigs = nColumns;
-	matrix Q; //transformation matrix from CV to chosen basis
-	{	matrix evecs; diagMatrix eigs;
-		(*Xbasis).diagonalize(evecs, eigs);
-		Q = evecs(0,nColumns, 0,nEigs); //Largest negative eigenvalues of Xbasis appear in the beginning; select first nEigs of them
-	}
+	matrix Q; //transformation matrix from CV to chosen basis (on head only)
 	
-	//Transform all quantities to eigenbasis:
-	logPrintf("\tTransforming output quantities to %s polarizability eigen-basis\n", polarizabilityMap.getString(eigenBasis)); logFlush();
-	V = V * Q;
-	Xni = dagger(Q) * Xni * Q;
-	Xext = dagger(Q) * Xext * Q;
-	Xtot = dagger(Q) * Xtot * Q;
-	K = dagger(Q) * K * Q;
-	KXC = dagger(Q) * KXC * Q;
-
-	//Dump:
-	logPrintf("\tDumping '%s' ... ", e.dump.getFilename("pol_*").c_str()); logFlush();
-	V.write(e.dump.getFilename("pol_basis").c_str());
-	Xni.write(e.dump.getFilename("pol_Xni").c_str());
-	Xext.write(e.dump.getFilename("pol_Xext").c_str());
-	Xtot.write(e.dump.getFilename("pol_Xtot").c_str());
-	K.write(e.dump.getFilename("pol_K").c_str());
-	KXC.write(e.dump.getFilename("pol_KXC").c_str());
-	//G-vectors:
+	//Dense linear algebra on the head process:
 	if(mpiWorld->isHead())
-	{	FILE* fp = fopen(e.dump.getFilename("pol_Gvectors").c_str(), "w");
+	{	//Compute operator matrices in current (CV) basis
+		logPrintf("\tComputing External and Total polarizability matrices in %s basis\n", basisName); logFlush();
+		matrix Xtot = dagger_symmetrize(inv(eye(nColumns) - Xni*(  KXC  )) * Xni); //charge response to total electrostatic potential
+		matrix Xext = dagger_symmetrize(inv(eye(nColumns) - Xni*(K + KXC)) * Xni); //charge response to external electrostatic potential
+		
+		//Compute dielectric band structure:
+		{	string fname = e.dump.getFilename("epsInvEigs");
+			logPrintf("\tDumping '%s' ... ", fname.c_str()); logFlush();
+			matrix epsInvEvecs; diagMatrix epsInvEigs;
+			matrix Khalf = pow(dagger_symmetrize(K), 0.5);
+			matrix epsInv = eye(nColumns) + Khalf * Xext * Khalf;
+			epsInv.diagonalize(epsInvEvecs, epsInvEigs); //epsInv (symmetrized)
+			FILE* fp=fopen(fname.c_str(), "w");
+			epsInvEigs.print(fp, "%.15f\n");
+			fclose(fp);
+			logPrintf("Done.\n"); logFlush();
+			//Print head:
+			V0 *= 1./sqrt(trace(V0*dagger(V0)).abs()); //normalize
+			double epsInvHead = trace(V0 * epsInv * dagger(V0)).abs();
+			logPrintf("\thead(epsInv): %lg   1/head(epsInv): %lg\n", epsInvHead, 1./epsInvHead);
+		}
+		
+		//Determine transformation to chosen eigen-basis
+		logPrintf("\tComputing transformation matrix from %s to %s polarizability eigen-basis\n", basisName, polarizabilityMap.getString(eigenBasis)); logFlush();
+		const matrix* Xbasis = 0;
+		switch(eigenBasis)
+		{	case NonInteracting: Xbasis = &Xni; break;
+			case External: Xbasis = &Xext; break;
+			case Total: Xbasis = &Xtot; break;
+			default: assert(!"Invalid eigenBasis");
+		}
+		{	matrix evecs; diagMatrix eigs;
+			(*Xbasis).diagonalize(evecs, eigs);
+			Q = evecs(0,nColumns, 0,nEigs); //Largest negative eigenvalues of Xbasis appear in the beginning; select first nEigs of them
+		}
+		
+		//Transform all quantities to eigenbasis:
+		logPrintf("\tTransforming output quantities to %s polarizability eigen-basis\n", polarizabilityMap.getString(eigenBasis)); logFlush();
+		Xni = dagger(Q) * Xni * Q;
+		Xext = dagger(Q) * Xext * Q;
+		Xtot = dagger(Q) * Xtot * Q;
+		K = dagger(Q) * K * Q;
+		KXC = dagger(Q) * KXC * Q;
+		
+		//Dump matrices:
+		logPrintf("\tDumping '%s' ... ", e.dump.getFilename("pol_*").c_str()); logFlush();
+		Xni.write(e.dump.getFilename("pol_Xni").c_str());
+		Xext.write(e.dump.getFilename("pol_Xext").c_str());
+		Xtot.write(e.dump.getFilename("pol_Xtot").c_str());
+		K.write(e.dump.getFilename("pol_K").c_str());
+		KXC.write(e.dump.getFilename("pol_KXC").c_str());
+		//G-vectors:
+		FILE* fp = fopen(e.dump.getFilename("pol_Gvectors").c_str(), "w");
 		for(const vector3<int>& iG: basis.iGarr)
 			fprintf(fp, "%d %d %d\n", iG[0], iG[1], iG[2]);
 		fclose(fp);
+		//Layout information for partial reads:
+		fp = fopen(e.dump.getFilename("pol_info").c_str(), "w");
+		fprintf(fp, "nG %lu\nnEigs %d\n", basis.nbasis, nEigs);
+		fprintf(fp, "#pol_basis: nEigs contiguous columns of nG complex<double> (read eigenvector j at byte offset j*nG*16)\n");
+		fprintf(fp, "#pol_X*, pol_K*: nEigs x nEigs complex<double> matrices in column-major order (column j at byte offset j*nEigs*16)\n");
+		fclose(fp);
+	}
+	
+	//Dump basis: each process transforms and writes its own block of eigenvector columns
+	{	TaskDivision eigDiv(nEigs, mpiWorld);
+		ColumnBundle VQsub = V.transform(scatterColumns(Q, nColumns, eigDiv));
+		MPIUtil::File fp; mpiWorld->fopenWrite(fp, e.dump.getFilename("pol_basis").c_str());
+		mpiWorld->fseek(fp, eigDiv.start()*basis.nbasis*sizeof(complex), SEEK_SET);
+		if(VQsub.nCols()) mpiWorld->fwriteData(VQsub, fp);
+		mpiWorld->fclose(fp);
 	}
 	logPrintf("Done.\n");
 	logFlush();
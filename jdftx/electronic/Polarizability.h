@@ -44,6 +44,8 @@ struct Polarizability
 	
 	string dkFilenamePattern; //!< if non-null, read wavefunctions and eigenvalues for offset states form here
 	
+	static const int nPairsPerBlock = 64; //!< number of band pairs whose densities are held at once in the plane-wave basis construction
+	
 	Polarizability();
 	void dump(const class Everything& e); //!< compute and dump polarizability eigenvectors and matrix elements
 	
@@ -19,6 +19,7 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <electronic/SCF.h>
 #include <electronic/ElecMinimizer.h>
+#include <electronic/BandChFSI.h>
 #include <electronic/Everything.h>
 #include <electronic/ExactExchange.h>
 #include <core/ScalarFieldIO.h>
@@ -44,6 +45,14 @@ inline ScalarFieldArray operator*(const RealKernel& K, const ScalarFieldArray& x
 SCF::SCF(Everything& e): Pulay<SCFvariable>(e.scfParams), e(e), kerkerMix(e.gInfo), diisMetric(e.gInfo)
 {	SCFparams& sp = e.scfParams;
 	mixTau = e.exCorr.needsKEdensity();
+	nCycles = 0;
+	
+	//Check applicability of the selected inner eigensolver:
+	if(sp.eigenSolver == SCFparams::ES_ChFSI)
+	{	for(const auto& specie: e.iInfo.species)
+			if(specie->isUltrasoft())
+				die("SCF eigenSolver ChFSI is not supported with ultrasoft pseudopotentials; use eigenSolver Default.\n");
+	}
 	
 	//Determine minimum Gsq (used for preconditioning):
 	double GminSq = DBL_MAX;
@@ -94,6 +103,11 @@ void SCF::minimize()
 	int eMinIterations = e.elecMinParams.nIterations;
 	std::vector<string> extraNames(1, "deigs");
 	std::vector<double> extraThresh(1, sp.eigDiffThreshold);
+	
+	//Apply local potential in single precision in the early iterations, if requested:
+	eVars.singlePrecisionVscloc = (sp.mixedPrecisionThreshold > 0.);
+	if(eVars.singlePrecisionVscloc)
+		logPrintf("Applying local potential with single-precision FFTs until |Residual| < %lg.\n", sp.mixedPrecisionThreshold);
 
 	//Single or multi Pulay loop depending on exact exchange:
 	if(e.exCorr.exxFactor())
@@ -125,6 +139,7 @@ void SCF::minimize()
 	e.iInfo.augmentDensityGridGrad(e.eVars.Vscloc); //to make sure grid projections are compatible with final Vscloc
 	
 	//Restore electronic minimize params that were modified above:
+	eVars.singlePrecisionVscloc = false;
 	e.elecMinParams.energyDiffThreshold = eMinThreshold;
 	e.elecMinParams.nIterations = eMinIterations;
 	
@@ -147,7 +162,16 @@ double SCF::cycle(double dEprev, std::vector<double>& extraValues)
 	if(not sp.verbose) { logSuspend(); e.elecMinParams.fpLog = nullLog; } // Silence eigensolver output
 	e.elecMinParams.energyDiffThreshold = std::min(1e-6, 0.1*fabs(dEprev));
 	if(sp.nEigSteps) e.elecMinParams.nIterations = sp.nEigSteps;
-	bandMinimize(e, false, true);
+	if(sp.eigenSolver==SCFparams::ES_ChFSI and nCycles)
+	{	//Chebyshev-filtered subspace iteration from previous cycle's subspace:
+		int nPasses = sp.nEigSteps ? sp.nEigSteps : 1; //one pass by default (not elecMinParams.nIterations, which is meant for iterative solvers)
+		bool fixed_H = true; std::swap(fixed_H, e.cntrl.fixed_H); //remember fixed_H flag and temporarily set it to true
+		for(int q=e.eInfo.qStart; q<e.eInfo.qStop; q++)
+			BandChFSI(e, q).minimize(nPasses, sp.chfsiDegree);
+		std::swap(fixed_H, e.cntrl.fixed_H); //restore fixed_H flag
+	}
+	else bandMinimize(e, false, true);
+	nCycles++;
 	if(not sp.verbose) { logResume(); e.elecMinParams.fpLog = globalLog; }  // Resume output
 
 	//Compute new density and energy
@@ -160,8 +184,22 @@ double SCF::cycle(double dEprev, std::vector<double>& extraValues)
 	return E;
 }
 
+bool SCF::acceptConvergence()
+{	if(!e.eVars.singlePrecisionVscloc) return true;
+	//Converged with the single-precision local potential: refine in double precision before accepting
+	e.eVars.singlePrecisionVscloc = false;
+	restartHistory(); //convergence must be reached again with double-precision energies and residuals
+	logPrintf("%sConvergence reached with single-precision local potential: switching to double precision for further cycles.\n", e.scfParams.linePrefix);
+	return false;
+}
+
 void SCF::report(int iter)
 {
+	if(e.eVars.singlePrecisionVscloc && residualNorm < e.scfParams.mixedPrecisionThreshold)
+	{	e.eVars.singlePrecisionVscloc = false;
+		restartHistory();
+		logPrintf("%s|Residual| < %lg: switching to double-precision local potential.\n", e.scfParams.linePrefix, e.scfParams.mixedPrecisionThreshold);
+	}
 	if(e.cntrl.shouldPrintEigsFillings) print_Hsub_eigs(e);
 	if(e.cntrl.shouldPrintEcomponents) { logPrintf("\n"); e.ener.print(); logPrintf("\n"); }
 	logFlush();
@@ -49,8 +49,10 @@ public:
 protected:
 	//---- Interface to Pulay ----
 	double sync(double x) const;
+	const char* telemetryStage() const { return "electronic"; } //!< emit telemetry records for each cycle
 	double cycle(double dEprev, std::vector<double>& extraValues);
 	void report(int iter);
+	bool acceptConvergence();
 	void axpy(double alpha, const SCFvariable& X, SCFvariable& Y) const;
 	double dot(const SCFvariable& X, const SCFvariable& Y) const;
 	size_t variableSize() const;
@@ -64,6 +66,7 @@ protected:
 private:
 	Everything& e;
 	bool mixTau; //!< whether KE needs to be mixed
+	int nCycles; //!< number of completed SCF cycles (ChFSI starts from the subspace of the first cycle's regular eigensolver)
 	RealKernel kerkerMix, diisMetric; //!< convolution kernels for kerker preconditioning and the DIIS overlap metric
 	
 	double eigDiffRMS(const std::vector<diagMatrix>&, const std::vector<diagMatrix>&) const; //!< weighted RMS difference between two sets of eigenvalues
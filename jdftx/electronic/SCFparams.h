@@ -29,7 +29,7 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 //! Parameters controlling SCF iteration
 struct SCFparams : public PulayParams
 {
-	int nEigSteps; //!< number of steps of the eigenvalue solver per iteration (use elecMinParams.nIterations if 0)
+	int nEigSteps; //!< number of steps of the eigenvalue solver per iteration (if 0, use elecMinParams.nIterations, or a single filter pass for ChFSI)
 	double eigDiffThreshold; //!< convergence threshold on the RMS change of eigenvalues
 
 	string historyFilename; //!< Read SCF history in order to resume a previous run
@@ -45,6 +45,14 @@ struct SCFparams : public PulayParams
 	
 	bool verbose; //!< Whether the inner eigensolver will print progress
 	double mixFractionMag;  //!< Mixing fraction for magnetization density / potential
+	double mixedPrecisionThreshold; //!< apply Vscloc in single precision until the residual norm drops below this (disabled if 0)
+	
+	enum EigenSolver
+	{	ES_Default, //!< Use the band minimizer selected by elec-eigen-algo
+		ES_ChFSI //!< Chebyshev-filtered subspace iteration (after the first SCF cycle)
+	}
+	eigenSolver; //!< Inner eigensolver used in each SCF cycle
+	int chfsiDegree; //!< Degree of Chebyshev filter polynomial (for ES_ChFSI)
 	
 	SCFparams()
 	{	nEigSteps = 2; //for Davidson; the default for CG is 40 (and set by the command)
@@ -54,6 +62,9 @@ struct SCFparams : public PulayParams
 		qKappa = -1.;
 		verbose = false;
 		mixFractionMag = 1.5;
+		mixedPrecisionThreshold = 0.;
+		eigenSolver = ES_Default;
+		chfsiDegree = 8;
 	}
 };
 
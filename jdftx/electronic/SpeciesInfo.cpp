@@ -35,8 +35,7 @@ void SpeciesInfo::sync_atpos()
 {	if(!atpos.size()) return; //unused species
 	//Update managed version of atpos:
 	atposManaged = ManagedArray<vector3<>>(atpos); //it will get transferred to GPU if/when necessary
-	//Invalidate cached projectors:
-	cachedV.clear();
+	//Note: cached projectors are atom-independent and remain valid
 }
 
 inline bool isParallel(vector3<> x, vector3<> y)
@@ -406,7 +405,7 @@ void SpeciesInfo::updateLatticeDependent()
 		nCoreRadial.updateGmax(0, nGridLoc);
 		tauCoreRadial.updateGmax(0, nGridLoc);
 		for(auto& Qijl: Qradial) Qijl.second.updateGmax(Qijl.first.l, nGridLoc);
-		cachedV.clear(); //clear any cached projectors
+		cachedVfactor.clear(); //clear any cached projectors
 	}
 	
 	//Update Qradial indices, matrix and nagIndex if not previously init'd, or if R has changed:
@@ -422,6 +421,7 @@ void SpeciesInfo::updateLatticeDependent()
 			callPref(eblas_copy)(QradialMatData+index*nCoeff, Qijl.second.coeffPref(), Qijl.second.nCoeff);
 			index++;
 		}
+		setAugmentTables(); //flattened coefficient tables referencing above indices
 		//nagIndex:
 		nagIndex.init(gInfo.iGstop-gInfo.iGstart);
 		nagIndexPtr.init(nCoeff+1);
@@ -514,8 +514,9 @@ void SpeciesInfo::setPsi(std::vector<std::vector<RadialFunctionR> >& psiArr)
 			for(double& f: psi.f) f *= normFacPsi;
 			for(double& f: Opsi.f) f *= normFacOpsi;
 			//Transform to reciprocal space:
-			psi.transform(l, dG, nGridNL, psiRadial[l][n]);
-			Opsi.transform(l, dG, nGridNL, OpsiRadial[l][n]);
+			const string& cacheDir = e->iInfo.orbitalCacheDir.length() ? e->iInfo.orbitalCacheDir : e->iInfo.pspCacheDir;
+			psi.transform(l, dG, nGridNL, psiRadial[l][n], cacheDir.c_str());
+			Opsi.transform(l, dG, nGridNL, OpsiRadial[l][n], cacheDir.c_str());
 		}
 	}
 }
@@ -79,6 +79,19 @@ void Vnl_gpu(int nbasis, int atomStride, int nAtoms, int l, int m, vector3<> k,
 	SwitchTemplate_lm(l,m, Vnl_gpu, (nbasis, atomStride, nAtoms, k, iGarr, G, pos, VnlRadial, V, derivDir, stressDir) )
 }
 
+__global__
+void VnlStructureFactor_kernel(int nbasis, int nProj, int nAtoms, vector3<> k, const vector3<int>* iGarr,
+	const vector3<>* pos, const complex* P, complex* V)
+{	int n = kernelIndex1D();
+	if(n<nbasis) VnlStructureFactor_calc(n, nbasis, nProj, nAtoms, k, iGarr, pos, P, V);
+}
+void VnlStructureFactor_gpu(int nbasis, int nProj, int nAtoms, vector3<> k, const vector3<int>* iGarr,
+	const vector3<>* pos, const complex* P, complex* V)
+{	GpuLaunchConfig1D glc(VnlStructureFactor_kernel, nbasis);
+	VnlStructureFactor_kernel<<<glc.nBlocks,glc.nPerBlock>>>(nbasis, nProj, nAtoms, k, iGarr, pos, P, V);
+	gpuErrorCheck();
+}
+
 
 //Augment electron density by spherical functions
 template<int Nlm> __global__ void nAugment_kernel(int zBlock, const vector3<int> S, const matrix3<> G, int iGstart, int iGstop,
@@ -49,7 +49,7 @@ public:
 	std::vector<vector3<> > atpos; //!< array of atomic positions of this species
 	std::vector<vector3<> > velocities; //!< array of atomic velocities (NAN unless running MD) in lattice coordinates
 	ManagedArray<vector3<>> atposManaged; //!< managed copy of atpos accessed from operator code (for auto cpu/gpu transfers)
-	void sync_atpos(); //!< update changes in atpos; call whenever atpos is changed (this will update atposManaged and invalidate cached projectors, if any)
+	void sync_atpos(); //!< update changes in atpos; call whenever atpos is changed (this will update atposManaged)
 	
 	double dE_dnG; //!< Derivative of [total energy per atom] w.r.t [nPlanewaves per unit volume] (for Pulay corrections)
 	double mass; //!< ionic mass (currently unused)	
@@ -89,11 +89,15 @@ public:
 	//! Returns the pseudopotential format
 	PseudopotentialFormat getPSPFormat(){return pspFormat;}
 
-	//! Get projectors with qnum and basis matching Cq  (optionally cached).
-	//! If derivDir is non-null, return the derivative with respct to Cartesian k direction *derivDir instead (never cached).
+	//! Get projectors with qnum and basis matching Cq, from the (optionally cached) atom-independent projectors.
+	//! If derivDir is non-null, return the derivative with respct to Cartesian k direction *derivDir instead.
 	//! If stressDir is >=0, then calculate (i,j) component of dVnl/dR . RT where stressDir = 3*i+j
 	std::shared_ptr<ColumnBundle> getV(const ColumnBundle& Cq, const vector3<>* derivDir=0, const int stressDir=-1) const;
 	ColumnBundle getVatom(const ColumnBundle& Cq, int atom) const; //!< Single atom version
+	//! Write the projectors of atoms atomStart to atomStop-1 to V (nAtomProjectors() columns per atom of length nbasis),
+	//! for use in blocks of projectors concatenated over species (see IonInfo::project)
+	void getV(const ColumnBundle& Cq, int atomStart, int atomStop, complex* V) const;
+	int nAtomProjectors() const; //!< number of projectors per atom (columns per atom in result of getV)
 	int nProjectors() const { return MnlAll.nRows() * atpos.size(); } //!< total number of projectors for all atoms in this species (number of columns in result of getV)
 	
 	//! Return non-local energy for this species and quantum number q and optionally accumulate
@@ -118,9 +122,13 @@ public:
 	void augmentDensitySpherical(const QuantumNumber& qnum, const diagMatrix& Fq, const matrix& VdagCq, const matrix* VdagdCqL = 0, const matrix* VdagdCqR = 0, int atom = -1);
 	//! Accumulate the spherical augmentation functions nAug to the grid electron density (call only once, after augmentDensitySpherical on all k-points)
 	void augmentDensityGrid(ScalarFieldArray& n, int atom=-1, const vector3<>* atposDeriv = 0) const;
+	//! Same as augmentDensityGrid, but accumulate in reciprocal space (allows batching the inverse FFTs over species)
+	void augmentDensityGridTilde(ScalarFieldTildeArray& nTilde, int atom=-1, const vector3<>* atposDeriv = 0) const;
 	
 	//! Gradient propagation corresponding to augmentDensityGrid (stores intermediate spherical function results to E_nAug; call only once). Optionally collect forces and stress contributions
 	void augmentDensityGridGrad(const ScalarFieldArray& E_n, std::vector<vector3<> >* forces=0, matrix3<>* Eaug_RRT=0);
+	//! Same as augmentDensityGridGrad, but given ccE_n = Idag(E_n) (allows batching the forward FFTs over species)
+	void augmentDensityGridGradTilde(const ScalarFieldTildeArray& ccE_n, std::vector<vector3<> >* forces=0, matrix3<>* Eaug_RRT=0);
 	void augmentDensityGridGradDeriv(const ScalarFieldArray& E_n, int atom, const vector3<>* atposDeriv);
 	
 	//! Gradient propagation corresponding to augmentDensitySpherical (uses intermediate spherical function results from E_nAug; call once per k-point after augmentDensityGridGrad) 
@@ -187,7 +195,8 @@ private:
 	std::vector<matrix> Qint; //!< overlap augmentation matrix (indexed by l, empty if no augmentation)
 	matrix QintAll; //!< block matrix containing Qint for all l,m 
 	
-	std::map<std::pair<vector3<>,const Basis*>, std::shared_ptr<ColumnBundle> > cachedV; //cached projectors (identified by k-point and basis pointer)
+	std::map<std::pair<vector3<>,const Basis*>, std::shared_ptr<ColumnBundle> > cachedVfactor; //cached atom-independent projectors (identified by k-point and basis pointer)
+	std::shared_ptr<ColumnBundle> getVfactor(const ColumnBundle& Cq) const; //projectors of an atom at the origin, which getV multiplies by each atom's structure factor
 	
 	struct QijIndex
 	{	int l1, p1; //!< Angular momentum and projector index for channel i
@@ -202,6 +211,28 @@ private:
 	matrix QradialMat; //!< matrix with all the radial augmentation functions in columns (ordered by index)
 	matrix nAug; //!< intermediate electron density augmentation in the basis of Qradial functions (Flat array indexed by spin, atom number and then Qradial index)
 	ManagedArray<uint64_t> nagIndex; ManagedArray<size_t> nagIndexPtr; //!< grid indices arranged by |G|, used for coordinating scattered accumulate in nAugmentGrad(_gpu)
+	
+	//! Pair of projectors (i2 <= i1) on one atom with non-zero augmentation, used by augmentDensitySpherical(Grad)
+	struct AugmentPair
+	{	int i1, i2; //!< projector indices within an atom (excluding spinor components)
+		complex phase; //!< cis(0.5*pi*(l2-l1)) for the pair
+		int termStart, termStop; //!< range of corresponding entries in augmentTerms
+	};
+	//! Contribution of a projector pair to one spherical function of nAug
+	struct AugmentTerm
+	{	int iQ; //!< index of Qradial function (row of nAug)
+		int lm; //!< combined index l*(l+1)+m of net spherical harmonic
+		double coeff; //!< coefficient in expansion of Ylm product
+	};
+	std::vector<AugmentPair> augmentPairs; //!< flattened list of projector pairs (replaces Qradial lookups in inner loops)
+	std::vector<AugmentTerm> augmentTerms; //!< flattened Ylm product expansion terms referenced by augmentPairs
+	void setAugmentTables(); //!< initialize augmentPairs and augmentTerms (call after Qradial indices are set)
+	
+	//Thread functions for atom-parallel augmentation:
+	static void augmentDensitySpherical_sub(size_t atStart, size_t atStop, const SpeciesInfo* sp,
+		const std::vector<std::vector<matrix>>* Rho, double prefac, int nAtoms, int Nlm, complex* nAugData);
+	static void augmentDensitySphericalGrad_sub(size_t atStart, size_t atStop, const SpeciesInfo* sp,
+		std::vector<std::vector<matrix>>* E_Rho, double prefac, int atom, int Nlm, const complex* E_nAugData);
 
 	std::vector<std::vector<RadialFunctionG> > psiRadial; //!< radial part of the atomic orbitals (outer index l, inner index shell)
 	std::vector<std::vector<RadialFunctionG> > OpsiRadial; //!< O(psiRadial): includes Q contributions for ultrasoft pseudopotentials
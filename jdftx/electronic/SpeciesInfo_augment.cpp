@@ -133,7 +133,8 @@ void SpeciesInfo::augmentDensitySpherical(const QuantumNumber& qnum, const diagM
 	bool derivativeMode = (VdagdCqL or VdagdCqR);
 	if(derivativeMode) assert(VdagdCqL);
 	
-	//Loop over atoms:
+	//Compute density matrices on each atom:
+	std::vector<std::vector<matrix>> RhoAtoms(nAtoms);
 	for(unsigned at=0; at<nAtoms; at++)
 	{	//Get projections and calculate density matrix at this atom:
 		matrix RhoAll;
@@ -166,40 +167,43 @@ void SpeciesInfo::augmentDensitySpherical(const QuantumNumber& qnum, const diagM
 		}
 		else std::swap(Rho[qnum.index()], RhoAll); //in this case each qnum contributes to a specific spin component
 		
-		//Calculate spherical function contributions from density matrix:
+		std::swap(RhoAtoms[at], Rho);
+	}
+	
+	//Calculate spherical function contributions from density matrices (in parallel over atoms):
+	for(std::vector<matrix>& Rho: RhoAtoms)
+		for(matrix& Rho_s: Rho) if(Rho_s) Rho_s.data(); //make sure density matrices are available on the CPU before threading
+	threadLaunch(augmentDensitySpherical_sub, nAtoms, (const SpeciesInfo*)this, &RhoAtoms, qnum.weight/gInfo.detR, int(nAtoms), Nlm, nAugData);
+	watch.stop();
+}
+
+void SpeciesInfo::augmentDensitySpherical_sub(size_t atStart, size_t atStop, const SpeciesInfo* sp,
+	const std::vector<std::vector<matrix>>* RhoAtoms, double prefac, int nAtoms, int Nlm, complex* nAugData)
+{	for(size_t at=atStart; at<atStop; at++)
+	{	const std::vector<matrix>& Rho = RhoAtoms->at(at);
 		for(size_t s=0; s<Rho.size(); s++) if(Rho[s])
 		{	int atomOffs = Nlm * (at + s*nAtoms);
-			//Triple loop over first projector:
-			int i1 = 0;
-			for(int l1=0; l1<int(VnlRadial.size()); l1++)
-			for(int p1=0; p1<int(VnlRadial[l1].size()); p1++)
-			for(int m1=-l1; m1<=l1; m1++)
-			{	//Triple loop over second projector:
-				int i2 = 0;
-				for(int l2=0; l2<int(VnlRadial.size()); l2++)
-				for(int p2=0; p2<int(VnlRadial[l2].size()); p2++)
-				for(int m2=-l2; m2<=l2; m2++)
-				{	if(i2<=i1) //rest handled by i1<->i2 symmetry
-					{	std::vector<YlmProdTerm> terms = expandYlmProd(l1,m1, l2,m2);
-						double prefac = qnum.weight * ((i1==i2 ? 1 : 2)/gInfo.detR)
-									* (Rho[s].data()[Rho[s].index(i2,i1)] * cis(0.5*M_PI*(l2-l1))).real();
-						for(const YlmProdTerm& term: terms)
-						{	QijIndex qIndex = { l1, p1, l2, p2, term.l };
-							auto Qijl = Qradial.find(qIndex);
-							if(Qijl==Qradial.end()) continue; //no entry at this l
-							nAugData[nAug.index(Qijl->first.index, atomOffs + term.l*(term.l+1) + term.m)] += term.coeff * prefac;
-						}
-					}
-					i2++;
+			const complex* RhoData = Rho[s].data();
+			for(const AugmentPair& pair: sp->augmentPairs)
+			{	double pairPrefac = prefac * (pair.i1==pair.i2 ? 1 : 2) //rest handled by i1<->i2 symmetry
+					* (RhoData[Rho[s].index(pair.i2,pair.i1)] * pair.phase).real();
+				for(int iTerm=pair.termStart; iTerm<pair.termStop; iTerm++)
+				{	const AugmentTerm& term = sp->augmentTerms[iTerm];
+					nAugData[sp->nAug.index(term.iQ, atomOffs + term.lm)] += term.coeff * pairPrefac;
 				}
-				i1++;
 			}
 		}
 	}
-	watch.stop();
 }
 
 void SpeciesInfo::augmentDensityGrid(ScalarFieldArray& n, int atom, const vector3<>* atposDeriv) const
+{	ScalarFieldTildeArray nAugTilde(n.size());
+	augmentDensityGridTilde(nAugTilde, atom, atposDeriv);
+	for(unsigned s=0; s<n.size(); s++)
+		if(nAugTilde[s]) n[s] += I(nAugTilde[s]);
+}
+
+void SpeciesInfo::augmentDensityGridTilde(ScalarFieldTildeArray& nTilde, int atom, const vector3<>* atposDeriv) const
 {	static StopWatch watch("augmentDensityGrid"); watch.start(); 
 	augmentDensityGrid_COMMON_INIT
 	const GridInfo &gInfo = e->gInfo;
@@ -207,19 +211,26 @@ void SpeciesInfo::augmentDensityGrid(ScalarFieldArray& n, int atom, const vector
 	matrix nAugTot = nAug; mpiWorld->allReduceData(nAugTot, MPIUtil::ReduceSum); //collect radial functions from all processes, and split by G-vectors below
 	matrix nAugRadial = QradialMat * nAugTot; //transform from radial functions to spline coeffs
 	double* nAugRadialData = (double*)nAugRadial.dataPref();
-	for(unsigned s=0; s<n.size(); s++)
-	{	ScalarFieldTilde nAugTilde; nullToZero(nAugTilde, gInfo);
+	for(unsigned s=0; s<nTilde.size(); s++)
+	{	ScalarFieldTilde& nAugTilde = nTilde[s]; nullToZero(nAugTilde, gInfo);
 		unsigned atoms = (atom >= 0)? 1 : atpos.size();
 		for(unsigned atomindex=0; atomindex<atoms; atomindex++)
 		{	int atomOffs = (atom >= 0)? nCoeff * Nlm * s : nCoeff * Nlm * (atomindex + atpos.size()*s);
 			callPref(nAugment)(Nlm, gInfo.S, gInfo.G, gInfo.iGstart, gInfo.iGstop, nCoeff, dGinv, nAugRadialData+atomOffs, atpos[(atom >= 0)? atom : atomindex], nAugTilde->dataPref(), atposDeriv);
 		}
-		n[s] += I(nAugTilde);
 	}
 	watch.stop();
 }
 
 void SpeciesInfo::augmentDensityGridGrad(const ScalarFieldArray& E_n, std::vector<vector3<>>* forces, matrix3<>* Eaug_RRT)
+{	if(!atpos.size()) return; //unused species
+	if(!Qint.size()) return; //no overlap augmentation
+	ScalarFieldTildeArray ccE_n(E_n.size());
+	for(unsigned s=0; s<E_n.size(); s++) ccE_n[s] = Idag(E_n[s]);
+	augmentDensityGridGradTilde(ccE_n, forces, Eaug_RRT);
+}
+
+void SpeciesInfo::augmentDensityGridGradTilde(const ScalarFieldTildeArray& ccE_n, std::vector<vector3<>>* forces, matrix3<>* Eaug_RRT)
 {	static StopWatch watch("augmentDensityGridGrad"); watch.start();
 	augmentDensityGrid_COMMON_INIT
 	if(!nAug) augmentDensityInit();
@@ -235,14 +246,13 @@ void SpeciesInfo::augmentDensityGridGrad(const ScalarFieldArray& E_n, std::vecto
 	}
 	VectorFieldTilde E_atpos; if(forces) nullToZero(E_atpos, gInfo);
 	ScalarFieldTildeArray E_RRT(6); if(Eaug_RRT) nullToZero(E_RRT, gInfo);
-	for(unsigned s=0; s<E_n.size(); s++)
-	{	ScalarFieldTilde ccE_n = Idag(E_n[s]);
-		for(unsigned atom=0; atom<atpos.size(); atom++)
+	for(unsigned s=0; s<ccE_n.size(); s++)
+	{	for(unsigned atom=0; atom<atpos.size(); atom++)
 		{	int atomOffs = nCoeff * Nlm * (atom + atpos.size()*s);
 			if(forces) initZero(E_atpos);
 			callPref(nAugmentGrad)(Nlm, gInfo.S, gInfo.G, nCoeff, dGinv,
 				nAugRadialData ? (nAugRadialData+atomOffs) : 0,
-				atpos[atom], ccE_n->dataPref(), E_nAugRadialData+atomOffs,
+				atpos[atom], ccE_n[s]->dataPref(), E_nAugRadialData+atomOffs,
 				forces ? E_atpos.dataPref() : vector3<complex*>(),
 				Eaug_RRT ? array<complex*,6>(dataPref(E_RRT)) : array<complex*,6>(),
 				0, nagIndex.dataPref(), nagIndexPtr.dataPref());
@@ -292,53 +302,22 @@ void SpeciesInfo::augmentDensitySphericalGrad(const QuantumNumber& qnum, const m
 	const complex* E_nAugData = E_nAug.data();
 
 	matrix E_RhoVdagC(VdagCq.nRows(),VdagCq.nCols(),isGpuEnabled());
+	unsigned atoms = (atom >= 0) ? 1 : atpos.size();
 	
-	//Loop over atoms:
-	unsigned atoms = atpos.size();
-	if (atom >= 0) atoms = 1;
+	//Prepare gradient w.r.t density matrix in basis of each atom's projectors (split by spinor components, if any)
+	std::vector<std::vector<matrix>> E_RhoAtoms(atoms, std::vector<matrix>(e->eInfo.nDensities));
+	for(std::vector<matrix>& E_Rho: E_RhoAtoms)
+	{	if(e->eInfo.isNoncollinear())
+			for(matrix& E_Rho_s: E_Rho) E_Rho_s = zeroes(nProj/2, nProj/2);
+		else E_Rho[qnum.index()] = zeroes(nProj, nProj);
+		for(matrix& E_Rho_s: E_Rho) if(E_Rho_s) E_Rho_s.data(); //make sure these are available on the CPU before threading
+	}
+	
+	//Propagate gradients from spherical functions to density matrices (in parallel over atoms):
+	threadLaunch(augmentDensitySphericalGrad_sub, atoms, this, &E_RhoAtoms, 1./gInfo.detR, atom, Nlm, E_nAugData);
 	
 	for(unsigned Vatomindex=0; Vatomindex<atoms; Vatomindex++)
-	{
-		int atomindex = Vatomindex;
-		if (atom >= 0)
-			atomindex = atom;
-		
-		//Prepare gradient w.r.t density matrix in basis of current atom's projectors (split by spinor components, if any)
-		std::vector<matrix> E_Rho(e->eInfo.nDensities);
-		if(e->eInfo.isNoncollinear()) E_Rho.assign(E_Rho.size(), zeroes(nProj/2, nProj/2));
-		else E_Rho[qnum.index()] = zeroes(nProj, nProj);
-		
-		//Propagate gradients from spherical functions to density matrix:
-		for(size_t s=0; s<E_Rho.size(); s++) if(E_Rho[s])
-		{	int atomOffs = Nlm*(atomindex + s*atpos.size());
-			//Triple loop over first projector:
-			int i1 = 0;
-			for(int l1=0; l1<int(VnlRadial.size()); l1++)
-			for(int p1=0; p1<int(VnlRadial[l1].size()); p1++)
-			for(int m1=-l1; m1<=l1; m1++)
-			{	//Triple loop over second projector:
-				int i2 = 0;
-				for(int l2=0; l2<int(VnlRadial.size()); l2++)
-				for(int p2=0; p2<int(VnlRadial[l2].size()); p2++)
-				for(int m2=-l2; m2<=l2; m2++)
-				{	if(i2<=i1) //rest handled by i1<->i2 symmetry 
-					{	std::vector<YlmProdTerm> terms = expandYlmProd(l1,m1, l2,m2);
-						double E_Rho_i1i2sum = 0.;
-						for(const YlmProdTerm& term: terms)
-						{	QijIndex qIndex = { l1, p1, l2, p2, term.l };
-							auto Qijl = Qradial.find(qIndex);
-							if(Qijl==Qradial.end()) continue; //no entry at this l
-							E_Rho_i1i2sum += term.coeff * E_nAugData[E_nAug.index(Qijl->first.index, atomOffs + term.l*(term.l+1) + term.m)].real();
-						}
-						complex E_Rho_i1i2 = E_Rho_i1i2sum * (1./gInfo.detR) * cis(0.5*M_PI*(l2-l1));
-						E_Rho[s].data()[E_Rho[s].index(i2,i1)] += E_Rho_i1i2.conj();
-						if(i1!=i2) E_Rho[s].data()[E_Rho[s].index(i1,i2)] += E_Rho_i1i2;
-					}
-					i2++;
-				}
-				i1++;
-			}
-		}
+	{	std::vector<matrix>& E_Rho = E_RhoAtoms[Vatomindex];
 		
 		//Collate density matrix from spinor components (if necessary)
 		matrix E_RhoAll;
@@ -363,6 +342,67 @@ void SpeciesInfo::augmentDensitySphericalGrad(const QuantumNumber& qnum, const m
 	watch.stop();
 }
 
+void SpeciesInfo::augmentDensitySphericalGrad_sub(size_t atStart, size_t atStop, const SpeciesInfo* sp,
+	std::vector<std::vector<matrix>>* E_RhoAtoms, double prefac, int atom, int Nlm, const complex* E_nAugData)
+{	int nAtomsTot = sp->atpos.size();
+	for(size_t at=atStart; at<atStop; at++)
+	{	int atomIndex = (atom >= 0) ? atom : at;
+		std::vector<matrix>& E_Rho = E_RhoAtoms->at(at);
+		for(size_t s=0; s<E_Rho.size(); s++) if(E_Rho[s])
+		{	int atomOffs = Nlm*(atomIndex + s*nAtomsTot);
+			complex* E_RhoData = E_Rho[s].data();
+			for(const AugmentPair& pair: sp->augmentPairs)
+			{	double E_Rho_i1i2sum = 0.;
+				for(int iTerm=pair.termStart; iTerm<pair.termStop; iTerm++)
+				{	const AugmentTerm& term = sp->augmentTerms[iTerm];
+					E_Rho_i1i2sum += term.coeff * E_nAugData[sp->E_nAug.index(term.iQ, atomOffs + term.lm)].real();
+				}
+				complex E_Rho_i1i2 = (E_Rho_i1i2sum * prefac) * pair.phase;
+				E_RhoData[E_Rho[s].index(pair.i2,pair.i1)] += E_Rho_i1i2.conj();
+				if(pair.i1!=pair.i2) E_RhoData[E_Rho[s].index(pair.i1,pair.i2)] += E_Rho_i1i2; //rest handled by i1<->i2 symmetry
+			}
+		}
+	}
+}
+
+void SpeciesInfo::setAugmentTables()
+{	augmentPairs.clear();
+	augmentTerms.clear();
+	//Triple loop over first projector:
+	int i1 = 0;
+	for(int l1=0; l1<int(VnlRadial.size()); l1++)
+	for(int p1=0; p1<int(VnlRadial[l1].size()); p1++)
+	for(int m1=-l1; m1<=l1; m1++)
+	{	//Triple loop over second projector:
+		int i2 = 0;
+		for(int l2=0; l2<int(VnlRadial.size()); l2++)
+		for(int p2=0; p2<int(VnlRadial[l2].size()); p2++)
+		for(int m2=-l2; m2<=l2; m2++)
+		{	if(i2<=i1) //rest handled by i1<->i2 symmetry
+			{	AugmentPair pair;
+				pair.i1 = i1;
+				pair.i2 = i2;
+				pair.phase = cis(0.5*M_PI*(l2-l1));
+				pair.termStart = augmentTerms.size();
+				for(const YlmProdTerm& term: expandYlmProd(l1,m1, l2,m2))
+				{	QijIndex qIndex = { l1, p1, l2, p2, term.l };
+					auto Qijl = Qradial.find(qIndex);
+					if(Qijl==Qradial.end()) continue; //no entry at this l
+					AugmentTerm augTerm;
+					augTerm.iQ = Qijl->first.index;
+					augTerm.lm = term.l*(term.l+1) + term.m;
+					augTerm.coeff = term.coeff;
+					augmentTerms.push_back(augTerm);
+				}
+				pair.termStop = augmentTerms.size();
+				if(pair.termStop > pair.termStart) augmentPairs.push_back(pair);
+			}
+			i2++;
+		}
+		i1++;
+	}
+}
+
 
 bool SpeciesInfo::QijIndex::operator<(const SpeciesInfo::QijIndex& other) const
 {	//Bring both indices to the upper triangular part:
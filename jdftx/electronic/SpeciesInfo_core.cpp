@@ -81,7 +81,7 @@ void SpeciesInfo::setCore(RadialFunctionR& nCore)
 	{	RadialFunctionR tauCore = getTau(nCore, tauCore_rCut);
 		logPrintf("  Transforming core KE density to a uniform radial grid of dG=%lg with %d points.\n",
 			dG, nGridLoc);
-		tauCore.transform(0, dG, nGridLoc, tauCoreRadial);
+		tauCore.transform(0, dG, nGridLoc, tauCoreRadial, e->iInfo.pspCacheDir.c_str());
 		
 		if(tauCorePlot)
 		{	FILE* fp = fopen((name+".tauCoreRadial").c_str(), "w");
@@ -94,5 +94,5 @@ void SpeciesInfo::setCore(RadialFunctionR& nCore)
 	
 	logPrintf("  Transforming core density to a uniform radial grid of dG=%lg with %d points.\n",
 		dG, nGridLoc);
-	nCore.transform(0, dG, nGridLoc, nCoreRadial);
+	nCore.transform(0, dG, nGridLoc, nCoreRadial, e->iInfo.pspCacheDir.c_str());
 }
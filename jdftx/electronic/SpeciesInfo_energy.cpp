@@ -322,20 +322,64 @@ void SpeciesInfo::accumNonlocalForces(const ColumnBundle& Cq, const matrix& Vdag
 	}
 }
 
-std::shared_ptr<ColumnBundle> SpeciesInfo::getV(const ColumnBundle& Cq, const vector3<>* derivDir, const int stressDir) const
+int SpeciesInfo::nAtomProjectors() const
+{	return MnlAll.nRows() / e->eInfo.spinorLength();
+}
+
+std::shared_ptr<ColumnBundle> SpeciesInfo::getVfactor(const ColumnBundle& Cq) const
 {	const QuantumNumber& qnum = *(Cq.qnum);
 	const Basis& basis = *(Cq.basis);
 	std::pair<vector3<>,const Basis*> cacheKey = std::make_pair(qnum.k, &basis);
-	int nProj = MnlAll.nRows() / e->eInfo.spinorLength();
-	if(!nProj) return 0; //purely local psp
 	//First check cache
-	if(e->cntrl.cacheProjectors && (!derivDir) && (!stressDir))
-	{	auto iter = cachedV.find(cacheKey);
-		if(iter != cachedV.end()) //found
+	static std::mutex cacheLock; //cache may be accessed from threads running over states (eg. in LCAO)
+	if(e->cntrl.cacheProjectors)
+	{	std::lock_guard<std::mutex> lock(cacheLock);
+		auto iter = cachedVfactor.find(cacheKey);
+		if(iter != cachedVfactor.end()) //found
 			return iter->second; //return cached value
 	}
-	//No cache / not found in cache; compute:
+	//No cache / not found in cache; compute for a single atom at the origin:
+	std::shared_ptr<ColumnBundle> P = std::make_shared<ColumnBundle>(nAtomProjectors(), basis.nbasis, &basis, &qnum, isGpuEnabled());
+	#ifdef GPU_ENABLED
+	ManagedArray<vector3<>> origin(std::vector<vector3<>>(1));
+	int iProj = 0;
+	for(int l=0; l<int(VnlRadial.size()); l++)
+		for(unsigned p=0; p<VnlRadial[l].size(); p++)
+			for(int m=-l; m<=l; m++)
+			{	callPref(Vnl)(basis.nbasis, basis.nbasis, 1, l, m, qnum.k, basis.iGarr.dataPref(),
+					basis.gInfo->G, origin.dataPref(), VnlRadial[l][p], P->dataPref()+iProj*basis.nbasis);
+				iProj++;
+			}
+	#else
+	VnlBatch(basis.nbasis, qnum.k, basis.iGarr.data(), basis.gInfo->G, VnlRadial, P->data()); //all projectors in one pass
+	#endif
+	//Add to cache if necessary:
+	if(e->cntrl.cacheProjectors)
+	{	std::lock_guard<std::mutex> lock(cacheLock);
+		((SpeciesInfo*)this)->cachedVfactor[cacheKey] = P;
+	}
+	return P;
+}
+
+void SpeciesInfo::getV(const ColumnBundle& Cq, int atomStart, int atomStop, complex* V) const
+{	const Basis& basis = *(Cq.basis);
+	std::shared_ptr<ColumnBundle> P = getVfactor(Cq);
+	callPref(VnlStructureFactor)(basis.nbasis, P->nCols(), atomStop-atomStart, Cq.qnum->k, basis.iGarr.dataPref(),
+		atposManaged.dataPref()+atomStart, P->dataPref(), V);
+}
+
+std::shared_ptr<ColumnBundle> SpeciesInfo::getV(const ColumnBundle& Cq, const vector3<>* derivDir, const int stressDir) const
+{	const QuantumNumber& qnum = *(Cq.qnum);
+	const Basis& basis = *(Cq.basis);
+	int nProj = nAtomProjectors();
+	if(!nProj) return 0; //purely local psp
 	std::shared_ptr<ColumnBundle> V = std::make_shared<ColumnBundle>(nProj*atpos.size(), basis.nbasis, &basis, &qnum, isGpuEnabled()); //not a spinor regardless of spin type
+	if((!derivDir) && (stressDir < 0))
+	{	//Apply structure factors to the atom-independent projectors:
+		getV(Cq, 0, atpos.size(), V->dataPref());
+		return V;
+	}
+	//Derivatives computed directly:
 	int iProj = 0;
 	for(int l=0; l<int(VnlRadial.size()); l++)
 		for(unsigned p=0; p<VnlRadial[l].size(); p++)
@@ -346,9 +390,6 @@ std::shared_ptr<ColumnBundle> SpeciesInfo::getV(const ColumnBundle& Cq, const ve
 					basis.gInfo->G, atposManaged.dataPref(), VnlRadial[l][p], V->dataPref()+offs, derivDir, stressDir);
 				iProj++;
 			}
-	//Add to cache if necessary:
-	if(e->cntrl.cacheProjectors && (!derivDir) && (!stressDir))
-		((SpeciesInfo*)this)->cachedV[cacheKey] = V;
 	return V;
 }
 
@@ -49,6 +49,55 @@ void Vnl(int nbasis, int atomStride, int nAtoms, int l, int m, const vector3<> k
 {	SwitchTemplate_lm(l,m, Vnl, (nbasis, atomStride, nAtoms, k, iGarr, G, pos, VnlRadial, V, derivDir, stressDir) )
 }
 
+template<int l, int m> void YlmBatch(int n, const vector3<>* qhat, double* Y)
+{	for(int i=0; i<n; i++) Y[i] = Ylm<l,m>(qhat[i]);
+}
+void VnlBatch_sub(size_t iStart, size_t iStop, int nbasis, const vector3<> k, const vector3<int>* iGarr, const matrix3<> G,
+	const std::vector<std::vector<RadialFunctionG>>* fRadial, complex* P)
+{	const int blockSize = 256; //basis functions per block (so that temporaries stay in cache)
+	const int lMax = 6; //maximum l supported by Ylm
+	double q[blockSize], R[blockSize], Y[(2*lMax+1)*blockSize];
+	vector3<> qhat[blockSize];
+	for(size_t nStart=iStart; nStart<iStop; nStart+=blockSize)
+	{	int nBlock = std::min(size_t(blockSize), iStop-nStart);
+		//|k+G| and its direction, shared by all projectors:
+		for(int i=0; i<nBlock; i++)
+		{	vector3<> qvec = (k + iGarr[nStart+i]) * G; //k+G in cartesian coordinates
+			q[i] = qvec.length();
+			qhat[i] = qvec * (q[i] ? 1./q[i] : 0.); //set qhat to 0 for q=0 (doesn't matter)
+		}
+		int iProj = 0;
+		for(int l=0; l<int(fRadial->size()); l++)
+		{	const std::vector<RadialFunctionG>& fRadial_l = fRadial->at(l);
+			if(!fRadial_l.size()) continue;
+			assert(l <= lMax);
+			//Spherical harmonics, shared by all radial functions of this l:
+			for(int m=-l; m<=l; m++)
+				SwitchTemplate_lm(l,m, YlmBatch, (nBlock, qhat, Y+(l+m)*blockSize))
+			//Radial functions:
+			for(const RadialFunctionG& f: fRadial_l)
+			{	f.evaluate(nBlock, q, R);
+				for(int m=-l; m<=l; m++)
+				{	const double* Ym = Y+(l+m)*blockSize;
+					complex* Pcol = P + iProj*size_t(nbasis) + nStart;
+					for(int i=0; i<nBlock; i++)
+						Pcol[i] = Ym[i] * R[i];
+					iProj++;
+				}
+			}
+		}
+	}
+}
+void VnlBatch(int nbasis, const vector3<> k, const vector3<int>* iGarr, const matrix3<> G,
+	const std::vector<std::vector<RadialFunctionG>>& fRadial, complex* P)
+{	threadLaunch(VnlBatch_sub, nbasis, nbasis, k, iGarr, G, &fRadial, P);
+}
+
+void VnlStructureFactor(int nbasis, int nProj, int nAtoms, const vector3<> k, const vector3<int>* iGarr,
+	const vector3<>* pos, const complex* P, complex* V)
+{	threadedLoop(VnlStructureFactor_calc, nbasis, nbasis, nProj, nAtoms, k, iGarr, pos, P, V);
+}
+
 //Augment electron density by spherical functions
 template<int Nlm> void nAugment_sub(size_t diStart, size_t diStop, const vector3<int> S, const matrix3<>& G, int iGstart,
 	int nCoeff, double dGinv, const double* nRadial, const vector3<>& atpos, complex* n, const vector3<>* atposDeriv)
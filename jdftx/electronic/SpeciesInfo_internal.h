@@ -103,6 +103,32 @@ void Vnl_gpu(int nbasis, int atomStride, int nAtoms, int l, int m, const vector3
 	const vector3<>* derivDir=0, const int stressDir=-1);
 #endif
 
+//! Apply the structure factor of each atom to the atom-independent projectors P (nProj columns of length nbasis),
+//! resulting in nAtoms*nProj columns of V ordered by atom and then projector
+__hostanddev__ void VnlStructureFactor_calc(int n, int nbasis, int nProj, int nAtoms, const vector3<>& k, const vector3<int>* iGarr,
+	const vector3<>* pos, const complex* P, complex* V)
+{	vector3<> kpG = k + iGarr[n]; //k+G in reciprocal lattice coordinates
+	for(int atom=0; atom<nAtoms; atom++)
+	{	complex S = cis((-2*M_PI)*dot(pos[atom],kpG));
+		complex* Vatom = V + atom*nProj*nbasis;
+		for(int p=0; p<nProj; p++)
+			Vatom[p*nbasis+n] = S * P[p*nbasis+n];
+	}
+}
+//! Compute atom-independent projectors (single atom at origin) for all radial functions fRadial[l][p] and all m
+//! in one pass over the basis (cpu only): |k+G| and its direction are computed once per basis function,
+//! each radial function is evaluated in batches using RadialFunctionG::evaluate, and each Ylm once per (l,m).
+//! Columns of P (each of length nbasis) are ordered by l, then p, then m (as in SpeciesInfo::getVfactor)
+void VnlBatch(int nbasis, const vector3<> k, const vector3<int>* iGarr, const matrix3<> G,
+	const std::vector<std::vector<RadialFunctionG>>& fRadial, complex* P);
+
+void VnlStructureFactor(int nbasis, int nProj, int nAtoms, const vector3<> k, const vector3<int>* iGarr,
+	const vector3<>* pos, const complex* P, complex* V);
+#ifdef GPU_ENABLED
+void VnlStructureFactor_gpu(int nbasis, int nProj, int nAtoms, const vector3<> k, const vector3<int>* iGarr,
+	const vector3<>* pos, const complex* P, complex* V);
+#endif
+
 
 //! Perform the loop:
 //!   for(lm=0; lm < Nlm; lm++) (*f)(tag< lm >);
@@ -153,7 +153,7 @@ void SpeciesInfo::readFhi(istream& in)
 	int lLoc = lLocCpi>=0 ? lLocCpi : (lCount-1); //specified channel, or last channel if unspecified
 	if(lLoc>=lCount) die("  Local channel l=%d is invalid (max l=%d in file).\n", lLoc, lCount);
 	logPrintf("  Transforming local potential (l=%d) to a uniform radial grid of dG=%lg with %d points.\n", lLoc, dG, nGridLoc);
-	channels[lLoc].VplusZbyr(Z).transform(0, dG, nGridLoc, VlocRadial);
+	channels[lLoc].VplusZbyr(Z).transform(0, dG, nGridLoc, VlocRadial, e->iInfo.pspCacheDir.c_str());
 	
 	//Non-local potentials
 	if(lLoc==lCount-1) lCount--; //projector array shortens if last channel is local
@@ -168,7 +168,7 @@ void SpeciesInfo::readFhi(istream& in)
 				double Minv = channels[l].projectorM(channels[lLoc]);
 				if(Minv) //to handle the special case when custom local channel happens to equal one of the l's!
 				{	VnlRadial[l].resize(1); //single projector per angular momentum
-					channels[l].getProjector(channels[lLoc]).transform(l, dG, nGridNL, VnlRadial[l][0]);
+					channels[l].getProjector(channels[lLoc]).transform(l, dG, nGridNL, VnlRadial[l][0], e->iInfo.pspCacheDir.c_str());
 					Mnl[l] = eye(1) * (1./Minv);
 				}
 			}
@@ -239,7 +239,7 @@ void SpeciesInfo::readUPF(istream& is)
 			for(int i=0; i<nGrid; i++)
 				Vloc.f[i] = 0.5*Vloc.f[i] + Z*(rGrid[i] ? 1./rGrid[i] : 0); //Convert from Ry to Eh and remove Z/r part
 			logPrintf("  Transforming local potential to a uniform radial grid of dG=%lg with %d points.\n", dG, nGridLoc);
-			Vloc.transform(0, dG, nGridLoc, VlocRadial);
+			Vloc.transform(0, dG, nGridLoc, VlocRadial, e->iInfo.pspCacheDir.c_str());
 		}
 		else if(tag.name == "PP_NONLOCAL")
 		{	lNL.assign(nBeta, -1); //angular momentum per projector
@@ -341,7 +341,7 @@ void SpeciesInfo::readUPF(istream& is)
 					Vnl[iBeta].set(rGrid, drGrid);
 					for(int i=0; i<nGrid; i++)
 						Vnl[iBeta].f[i] *= (rGrid[i] ? 1./rGrid[i] : 0);
-					Vnl[iBeta].transform(l, dG, nGridNL, VnlRadial[l].back());
+					Vnl[iBeta].transform(l, dG, nGridNL, VnlRadial[l].back(), e->iInfo.pspCacheDir.c_str());
 					//Determine core radius:
 					for(int i=nGrid-1; i>=0; i--)
 						if(4*M_PI*rGrid[i]*rGrid[i]*drGrid[i] * fabs(D[iBeta][iBeta]) * Vnl[iBeta].f[i]*Vnl[iBeta].f[i] > 1e-3)
@@ -402,7 +402,7 @@ void SpeciesInfo::readUPF(istream& is)
 									}
 									//Store in Qradial:
 									QijIndex qIndex = { l1, p1, l2, p2, l };
-									Qijl.transform(l, dG, nGridLoc, Qradial[qIndex]);
+									Qijl.transform(l, dG, nGridLoc, Qradial[qIndex], e->iInfo.pspCacheDir.c_str());
 									//Store Qint = integral(Qradial) when relevant:
 									if(l1==l2 && !l)
 									{	double Qint_ij = Qijl.transform(0,0)/(4*M_PI);
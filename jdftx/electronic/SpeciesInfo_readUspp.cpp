@@ -247,7 +247,7 @@ void SpeciesInfo::readUspp(istream& is)
 	logPrintf("  Transforming local potential to a uniform radial grid of dG=%lg with %d points.\n", dG, nGridLoc);
 	for(int i=0; i<nGrid; i++)
 		Vloc0.f[i] = (Vloc0.f[i]*0.5 + Z) * (rGrid[i] ? 1./rGrid[i] : 0); //Convert to Eh and remove the -Z/r part
-	Vloc0.transform(0, dG, nGridLoc, VlocRadial);
+	Vloc0.transform(0, dG, nGridLoc, VlocRadial, e->iInfo.pspCacheDir.c_str());
 	
 	//Projectors:
 	if(nBeta)
@@ -259,7 +259,7 @@ void SpeciesInfo::readUspp(istream& is)
 			Vnl[iBeta].set(rGrid, drGrid);
 			for(int i=0; i<nGridBeta; i++)
 				Vnl[iBeta].f[i] *= (rGrid[i] ? 1./rGrid[i] : 0);
-			Vnl[iBeta].transform(l, dG, nGridNL, VnlRadial[l].back());
+			Vnl[iBeta].transform(l, dG, nGridNL, VnlRadial[l].back(), e->iInfo.pspCacheDir.c_str());
 		}
 		//Set Mnl:
 		Mnl.resize(lMax+1);
@@ -313,7 +313,7 @@ void SpeciesInfo::readUspp(istream& is)
 						}
 						//Store in Qradial:
 						QijIndex qIndex = { l1, p1, l2, p2, l };
-						Qijl.transform(l, dG, nGridLoc, Qradial[qIndex]);
+						Qijl.transform(l, dG, nGridLoc, Qradial[qIndex], e->iInfo.pspCacheDir.c_str());
 						//Store Qint = integral(Qradial) when relevant:
 						if(l1==l2 && !l)
 						{	double Qint_ij = Qijl.transform(0,0)/(4*M_PI);
@@ -31,7 +31,7 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 
 static const int lMaxSpherical = 3;
 
-Symmetries::Symmetries() : symSpherical(lMaxSpherical+1), symSpinAngle(lMaxSpherical+1), kReduceUseInversion(true), sup(vector3<int>(1,1,1)), isPertSup(false)
+Symmetries::Symmetries() : symSpherical(lMaxSpherical+1), symSpinAngle(lMaxSpherical+1), kReduceUseInversion(true), nSymmOrbits(0), sup(vector3<int>(1,1,1)), isPertSup(false)
 {	shouldPrintMatrices = false;
 }
 
@@ -173,51 +173,61 @@ void Symmetries::symmetrize(ScalarFieldTilde& x) const
 }
 void Symmetries::symmetrize(complexScalarFieldTilde& x) const
 {	if(sym.size()==1) return; // No symmetries, nothing to do
-	int nSymmClasses = symmIndex.nData() / sym.size(); //number of equivalence classes
-	callPref(eblas_symmetrize)(nSymmClasses, sym.size(), symmIndex.dataPref(), symmMult.dataPref(), symmIndexPhase.dataPref(), x->dataPref());
+	symmetrizeOrbits(std::vector<complex*>(1, x->dataPref()));
 }
 void Symmetries::symmetrize(ScalarFieldArray& x) const
 {	if(sym.size()==1) return; // No symmetries, nothing to do
-	if(x.size()<=2) { for(ScalarField& x_s: x) symmetrize(x_s); } //everything but vector-spin mode
-	else
-	{	assert(x.size() == 4); //must be vector-spin
-		std::vector<complexScalarFieldTilde> xTilde(x.size());
-		for(unsigned s=0; s<x.size(); s++) xTilde[s] = J(Complex(x[s]));
-		symmetrize(xTilde);
-		for(unsigned s=0; s<x.size(); s++) x[s] = Real(I(xTilde[s]));
-	}
+	symmetrize(std::vector<ScalarFieldArray*>(1, &x));
 }
 void Symmetries::symmetrize(complexScalarFieldArray& x) const
 {	if(sym.size()==1) return; // No symmetries, nothing to do
-	if(x.size()<=2) { for(complexScalarField& x_s: x) symmetrize(x_s); } //everything but vector-spin mode
-	else
-	{	assert(x.size() == 4); //must be vector-spin
-		std::vector<complexScalarFieldTilde> xTilde(x.size());
-		for(unsigned s=0; s<x.size(); s++) xTilde[s] = J(x[s]);
-		symmetrize(xTilde);
-		for(unsigned s=0; s<x.size(); s++) x[s] = I(xTilde[s]);
-	}
+	std::vector<complexScalarFieldTilde> xTilde(x.size());
+	for(unsigned s=0; s<x.size(); s++) xTilde[s] = J(x[s]);
+	symmetrize(xTilde);
+	for(unsigned s=0; s<x.size(); s++) x[s] = I(xTilde[s]);
 }
 void Symmetries::symmetrize(ScalarFieldTildeArray& x) const
 {	if(sym.size()==1) return; // No symmetries, nothing to do
-	if(x.size()<=2) { for(ScalarFieldTilde& x_s: x) symmetrize(x_s); } //everything but vector-spin mode
-	else
-	{	assert(x.size() == 4); //must be vector-spin
-		std::vector<complexScalarFieldTilde> xComplex(x.size());
-		for(unsigned s=0; s<x.size(); s++) xComplex[s] = Complex(x[s]);
-		symmetrize(xComplex);
-		for(unsigned s=0; s<x.size(); s++) x[s] = Real(xComplex[s]);
-	}
+	std::vector<complexScalarFieldTilde> xComplex(x.size());
+	for(unsigned s=0; s<x.size(); s++) xComplex[s] = Complex(x[s]);
+	symmetrize(xComplex);
+	for(unsigned s=0; s<x.size(); s++) x[s] = Real(xComplex[s]);
 }
 void Symmetries::symmetrize(std::vector<complexScalarFieldTilde>& x) const
 {	if(sym.size()==1) return; // No symmetries, nothing to do
-	if(x.size()<=2) { for(complexScalarFieldTilde& x_s: x) symmetrize(x_s); } //everything but vector-spin mode
+	if(x.size()<=2) symmetrizeOrbits(dataPref(x)); //everything but vector-spin mode (all components in one pass)
 	else
 	{	assert(x.size() == 4); //must be vector-spin
+		assert(symmIndex.nData()); //full index map only initialized in vector-spin mode
 		int nSymmClasses = symmIndex.nData() / sym.size(); //number of equivalence classes
 		callPref(eblas_symmetrize)(nSymmClasses, sym.size(), symmIndex.dataPref(), symmMult.dataPref(), symmIndexPhase.dataPref(), symmRotSpin.dataPref(), dataPref(x));
 	}
 }
+void Symmetries::symmetrize(const std::vector<ScalarFieldArray*>& x) const
+{	if(sym.size()==1) return; // No symmetries, nothing to do
+	//Transform all components to reciprocal space, collecting those that can share a pass:
+	std::vector<std::vector<complexScalarFieldTilde>> xTilde(x.size());
+	std::vector<complex*> xData; //scalar (non-vector-spin) components to be processed together
+	for(unsigned i=0; i<x.size(); i++)
+	{	xTilde[i].resize(x[i]->size());
+		for(unsigned s=0; s<x[i]->size(); s++)
+			if(x[i]->at(s)) xTilde[i][s] = J(Complex(x[i]->at(s)));
+		if(xTilde[i].size() <= 2)
+			for(complexScalarFieldTilde& xTilde_s: xTilde[i])
+				if(xTilde_s) xData.push_back(xTilde_s->dataPref());
+	}
+	if(xData.size()) symmetrizeOrbits(xData);
+	//Handle vector-spin components and transform back:
+	for(unsigned i=0; i<x.size(); i++)
+	{	if(xTilde[i].size() > 2) symmetrize(xTilde[i]);
+		for(unsigned s=0; s<x[i]->size(); s++)
+			if(xTilde[i][s]) x[i]->at(s) = Real(I(xTilde[i][s]));
+	}
+}
+void Symmetries::symmetrizeOrbits(const std::vector<complex*>& x) const
+{	if(!nSymmOrbits) return;
+	callPref(eblas_symmetrize)(nSymmOrbits, symmOrbitStart.dataPref(), symmOrbitIndex.dataPref(), symmOrbitWeight.dataPref(), x);
+}
 
 
 //Symmetrize forces:
@@ -523,50 +533,86 @@ std::vector<SpaceGroupOp> Symmetries::findSpaceGroup(const std::vector< matrix3<
 
 void Symmetries::initSymmIndex()
 {	const GridInfo& gInfo = e->gInfo;
+	nSymmOrbits = 0;
 	if(sym.size()==1) return;
+	bool needFullIndex = (e->eInfo.spinType == SpinVector); //full per-operation map only needed for spin-density rotations
 
 	std::vector<int> symmIndexVec, symmMultVec;
 	std::vector<complex> symmIndexPhaseVec;
-	symmIndexVec.reserve(gInfo.nr);
-	symmMultVec.reserve(gInfo.nr / sym.size());
-	symmIndexPhaseVec.reserve(gInfo.nr);
+	std::vector<int> orbitStartVec(1, 0), orbitIndexVec;
+	std::vector<complex> orbitWeightVec;
+	if(needFullIndex)
+	{	symmIndexVec.reserve(gInfo.nr);
+		symmMultVec.reserve(gInfo.nr / sym.size());
+		symmIndexPhaseVec.reserve(gInfo.nr);
+	}
+	orbitStartVec.reserve(gInfo.nr / sym.size());
+	orbitIndexVec.reserve(gInfo.nr);
+	orbitWeightVec.reserve(gInfo.nr);
 	std::vector<bool> done(gInfo.nr, false); //use full G-space for symmetrization
-	//Loop over all points not already handled as an image of a previous one:
-	{	const vector3<int>& S = gInfo.S;
-		size_t iStart = 0, iStop = gInfo.nr;
-		THREAD_fullGspaceLoop
-		(	if(!done[i])
-			{	std::set<int> orbit;
-				//Loop over symmetry matrices:
-				for(const SpaceGroupOp& op: sym)
-				{	vector3<int> iG2 = iG * op.rot;
-					complex phase = cis((-2*M_PI)*dot(iG,op.a));
-					//project back into range:
-					for(int k=0; k<3; k++)
-						iG2[k] = positiveRemainder(iG2[k], S[k]);
-					int i2 = gInfo.fullRindex(iG2);
-					symmIndexPhaseVec.push_back(phase);
-					symmIndexVec.push_back(i2);
-					done[i2] = true;
-					orbit.insert(i2);
-				}
-				int multiplicity = sym.size()/orbit.size(); //number of times each point in orbit is covered
-				if(multiplicity * orbit.size() != sym.size())
-				{	die("\nSymmetry operations do not seem to form a group.\n"
-						"This is most likely because the geometry has some border-line symmetries.\n"
-						"Try either tightening or loosening the symmetry-threshold parameter.\n\n");
-				}
-				symmMultVec.push_back(multiplicity);
+	const vector3<int>& S = gInfo.S;
+	std::vector<std::pair<int,complex>> orbit(sym.size()); //index and phase for each symmetry operation
+	auto processOrbit = [&](const vector3<int>& iG)
+	{	//Loop over symmetry matrices:
+		for(unsigned iSym=0; iSym<sym.size(); iSym++)
+		{	const SpaceGroupOp& op = sym[iSym];
+			vector3<int> iG2 = iG * op.rot;
+			complex phase = cis((-2*M_PI)*dot(iG,op.a));
+			//project back into range:
+			for(int k=0; k<3; k++)
+				iG2[k] = positiveRemainder(iG2[k], S[k]);
+			int i2 = gInfo.fullRindex(iG2);
+			orbit[iSym] = std::make_pair(i2, phase);
+			done[i2] = true;
+		}
+		if(needFullIndex)
+			for(const std::pair<int,complex>& entry: orbit)
+			{	symmIndexVec.push_back(entry.first);
+				symmIndexPhaseVec.push_back(entry.second);
 			}
-		)
+		//Collect distinct members, summing phases over repetitions:
+		std::map<int,complex> orbitUnique;
+		for(const std::pair<int,complex>& entry: orbit)
+			orbitUnique[entry.first] += entry.second;
+		int multiplicity = sym.size()/orbitUnique.size(); //number of times each point in orbit is covered
+		if(multiplicity * orbitUnique.size() != sym.size())
+		{	die("\nSymmetry operations do not seem to form a group.\n"
+				"This is most likely because the geometry has some border-line symmetries.\n"
+				"Try either tightening or loosening the symmetry-threshold parameter.\n\n");
+		}
+		if(needFullIndex) symmMultVec.push_back(multiplicity);
+		//Skip orbits left invariant by symmetrization (single point with all phases unity, eg. G=0):
+		if(orbitUnique.size()==1 && (orbitUnique.begin()->second - double(sym.size())).norm() < 1e-12)
+			return;
+		//Add to compact orbit tables:
+		double normFac = 1./sqrt(sym.size()*multiplicity);
+		for(const auto& entry: orbitUnique)
+		{	orbitIndexVec.push_back(entry.first);
+			orbitWeightVec.push_back(normFac * entry.second);
+		}
+		orbitStartVec.push_back(orbitIndexVec.size());
+	};
+	//Loop over all points not already handled as an image of a previous one:
+	{	size_t iStart = 0, iStop = gInfo.nr;
+		THREAD_fullGspaceLoop( if(!done[i]) processOrbit(iG); )
 	}
+	//Set the compact orbit tables (in managed cpu/gpu memory):
+	nSymmOrbits = orbitStartVec.size()-1;
+	symmOrbitStart.init(orbitStartVec.size());
+	symmOrbitIndex.init(orbitIndexVec.size());
+	symmOrbitWeight.init(orbitWeightVec.size());
+	memcpy(symmOrbitStart.data(), orbitStartVec.data(), orbitStartVec.size()*sizeof(int));
+	memcpy(symmOrbitIndex.data(), orbitIndexVec.data(), orbitIndexVec.size()*sizeof(int));
+	memcpy(symmOrbitWeight.data(), orbitWeightVec.data(), orbitWeightVec.size()*sizeof(complex));
+	if(!needFullIndex) return;
+	
 	//Initialize Cartesian rotation matrices:
 	std::vector<matrix3<>> symmRotSpinVec(sym.size());
 	for(unsigned iRot=0; iRot<sym.size(); iRot++)
 	{	matrix3<> rotCart = e->gInfo.R * sym[iRot].rot * inv(e->gInfo.R);
 		symmRotSpinVec[iRot] = rotCart * (1./det(rotCart)); //spin is a pseudo-vector invariant under inversion
 	}
-	//Set the final pointers (in managed cpu/gpu memory):
+	//Set the full index map for spin-density symmetrization (in managed cpu/gpu memory):
 	int nSymmIndex = symmIndexVec.size();
 	symmIndex.init(nSymmIndex);
 	symmMult.init(symmMultVec.size());
@@ -53,6 +53,7 @@ public:
 	void symmetrize(complexScalarFieldArray&) const; //!< symmetrize an array of complex scalar fields in real space representing spin density / potentials
 	void symmetrize(ScalarFieldTildeArray&) const; //!< symmetrize an array of scalar fields in reciprocal space representing spin density / potentials
 	void symmetrize(std::vector<complexScalarFieldTilde>&) const; //!< symmetrize an array of complex scalar fields in reciprocal space representing spin density / potentials
+	void symmetrize(const std::vector<ScalarFieldArray*>&) const; //!< symmetrize several arrays in real space together (eg. density and KE density) in a single pass over the orbit tables
 	void symmetrize(struct IonicGradient&) const; //!< symmetrize forces
 	void symmetrize(matrix3<>&) const; //!< symmetrize a tensor in Cartesian coordinates
 	void symmetrizeSpherical(matrix&, const class SpeciesInfo* specie) const; //!< symmetrize matrices in Ylm basis per atom of species sp (accounting for atom maps)
@@ -89,7 +90,13 @@ private:
 	void checkFFTbox(); //!< verify that the sampled mesh is commensurate with symmetries
 	void checkSymmetries(); //!< check validity of manually specified symmetry matrices
 	
-	//Index map for scalar field (electron density, potential) symmetrization in reciprocal space
+	//Compact orbit tables for scalar field (electron density, potential) symmetrization in reciprocal space
+	int nSymmOrbits; //number of orbits that need symmetrization (excludes orbits invariant under all operations, such as G=0)
+	IndexArray symmOrbitStart; //offset of each orbit in symmOrbitIndex / symmOrbitWeight (length nSymmOrbits+1)
+	IndexArray symmOrbitIndex; //distinct G-space indices in each orbit, stored consecutively (sorted by index within each orbit)
+	ManagedArray<complex> symmOrbitWeight; //phase factor of each orbit entry, summed over repetitions and normalized by sqrt(nSym*multiplicity)
+	void symmetrizeOrbits(const std::vector<complex*>& x) const; //symmetrize reciprocal-space arrays x in one pass over the orbit tables
+	//Full index map for spin-density symmetrization in reciprocal space (vector-spin mode only):
 	IndexArray symmIndex; //sets of nSym consecutive G-space indices that should be averaged during symmetrization
 	IndexArray symmMult; //multiplicity (how many times each element is repeated) in each equivalence class
 	ManagedArray<complex> symmIndexPhase; //phase factor for entry at each index
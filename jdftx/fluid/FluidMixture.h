@@ -113,6 +113,7 @@ public:
 	double compute(ScalarFieldArray* grad, ScalarFieldArray* Kgrad);
 	
 	double sync(double x) const; //!< All processes minimize together; make sure scalars are in sync to round-off error
+	const char* telemetryStage() const { return "fluid"; } //!< emit telemetry records for each iteration
 	
 private:
 	unsigned nIndepIdgas; //!< number of scalar fields used as independent variables for the component ideal gases
@@ -44,12 +44,15 @@ class FluidMixtureJDFT : public FluidMixture
 {
 public:
 	FluidMixtureJDFT(const Everything& e, const GridInfo& gInfo, double T)
-	: FluidMixture(gInfo, T), e(e)
+	: FluidMixture(gInfo, T), iterLast(0), e(e)
 	{
 	}
 	
+	int iterLast; //!< latest iteration number in fluid minimize (for iteration statistics)
+	
 	bool report(int iter)
-	{	//Call base class report:
+	{	iterLast = iter;
+		//Call base class report:
 		bool stateModified = FluidMixture::report(iter);
 		//Dump, if required:
 		((Dump&)e.dump)(DumpFreq_Fluid, iter);
@@ -163,6 +166,15 @@ public:
 	{	fluidMixture->saveState(filename);
 	}
 
+	void getState(ScalarFieldArray& state) const
+	{	state = clone(fluidMixture->state);
+	}
+
+	void setState(const ScalarFieldArray& state)
+	{	fluidMixture->state = clone(state);
+		updateCached();
+	}
+
 	void dumpDensities(const char* filenamePattern) const
 	{	
 		ScalarFieldArray N; char filename[256];
@@ -176,7 +188,7 @@ public:
 				if(c->molecule.sites.size()>1) oss << "_" << s.name;
 				sprintf(filename, filenamePattern, oss.str().c_str());
 				logPrintf("Dumping %s... ", filename); logFlush();
-				if(mpiWorld->isHead()) saveRawBinary(N[c->offsetDensity+j], filename);
+				e.dump.saveField(N[c->offsetDensity+j], filename, oss.str());
 				logPrintf("Done.\n"); logFlush();
 			}
 	}
@@ -238,6 +250,7 @@ public:
 	void minimizeFluid()
 	{	TIME("Fluid minimize", globalLog,
 			fluidMixture->minimize(e.fluidMinParams);
+			nIterTotal += fluidMixture->iterLast;
 			updateCached();
 		)
 	}
@@ -267,7 +280,8 @@ public:
 //---------------------------------------------------------------------
 
 FluidSolver::FluidSolver(const Everything& e, const FluidSolverParams& fsp)
-: e(e), gInfo(e.coulomb->gInfo), fsp(fsp), atpos(e.iInfo.species.size())
+: e(e), gInfo(e.coulomb->gInfo), fsp(fsp), atpos(e.iInfo.species.size()), nIterTotal(0),
+extrapolatePending(false), nIterStart(0), nStepsExtrap(0), nIterExtrap(0), nStepsBaseline(0), nIterSaved(0)
 {	//Initialize radial kernels in molecule sites:
 	for(const auto& c: fsp.components)
 		if(!c->molecule)
@@ -333,6 +347,106 @@ void FluidSolver::set(const ScalarFieldTilde& rhoExplicitTilde, const ScalarFiel
 	{	if(!k2factor) ((ScalarFieldTilde&)rhoExplicitTilde)->setGzero(0.); //No screening => apply neutralizing background charge
 		set_internal(rhoExplicitTilde, nCavityTilde);
 	}
+	nCavityTildeLast = nCavityTilde;
+	if(extrapolatePending)
+	{	extrapolatePending = false;
+		if(fsp.extrapolationBaseline) compareExtrapolation(nCavityTilde);
+		else extrapolateState(nCavityTilde);
+	}
+}
+
+void FluidSolver::beginIonicStep()
+{	extrapolatePending = (history.size() > 1); //single entry is the current state already
+	nIterStart = nIterTotal;
+}
+
+void FluidSolver::endIonicStep()
+{	if(!nCavityTildeLast) return; //fluid not yet set (eg. lj-override)
+	//Statistics and report (plain warm starts occur only in the first steps, so they are no baseline for comparison):
+	int nIter = nIterTotal - nIterStart;
+	if(history.size() > 1) { nStepsExtrap++; nIterExtrap += nIter; }
+	if(nStepsExtrap)
+	{	logPrintf("Fluid extrapolation: %d fluid iterations in this ionic step, %.1lf on average over %d extrapolated steps.\n",
+			nIter, nIterExtrap*1./nStepsExtrap, nStepsExtrap);
+		logFlush();
+	}
+	//Update history:
+	if(fsp.nExtrapolationHistory <= 0) return;
+	HistoryEntry entry;
+	entry.nCavityTilde = clone(nCavityTildeLast);
+	getState(entry.state);
+	history.push_front(entry);
+	while(int(history.size()) > fsp.nExtrapolationHistory) history.pop_back();
+}
+
+//Extrapolate state as x = x0 + sum_j c_j (x0 - xj), with the coefficients c_j chosen
+//to best reproduce the cavity change (least-squares fit of n - n0 to sum_j c_j (n0 - nj))
+void FluidSolver::extrapolateState(const ScalarFieldTilde& nCavityTilde)
+{	static StopWatch watch("FluidSolver::extrapolateState"); watch.start();
+	const ScalarFieldTilde& n0 = history[0].nCavityTilde;
+	int nFit = history.size() - 1;
+	std::vector<ScalarFieldTilde> dn(nFit);
+	for(int j=0; j<nFit; j++)
+		dn[j] = n0 - history[j+1].nCavityTilde;
+	ScalarFieldTilde nDiff = nCavityTilde - n0;
+	//Normal equations:
+	matrix M(nFit, nFit), b(nFit, 1);
+	for(int i=0; i<nFit; i++)
+	{	for(int j=0; j<=i; j++)
+		{	double Mij = dot(dn[i], dn[j]);
+			M.set(i,j, Mij);
+			M.set(j,i, Mij);
+		}
+		b.set(i,0, dot(dn[i], nDiff));
+	}
+	double Mscale = trace(M).real()/nFit;
+	if(!(Mscale > 0.)) { watch.stop(); return; } //cavity unchanged in history: keep current state
+	matrix c = invApply(M + (1e-8*Mscale)*eye(nFit), b); //regularized against nearly collinear history
+	std::vector<double> coeff(nFit);
+	for(int j=0; j<nFit; j++) coeff[j] = c(j,0).real();
+	mpiWorld->bcastData(coeff); //ensure all processes extrapolate identically
+	//Fraction of cavity change captured by fit:
+	double nDiffSq = dot(nDiff, nDiff), residualSq = nDiffSq;
+	for(int j=0; j<nFit; j++) residualSq -= coeff[j] * b(j,0).real();
+	//Extrapolate, unless the fit requires stepping far outside the history (unreliable):
+	const double coeffMax = 3.;
+	bool reliable = true;
+	for(double cj: coeff) if(fabs(cj) > coeffMax) reliable = false;
+	if(reliable)
+	{	ScalarFieldArray state = clone(history[0].state);
+		for(int j=0; j<nFit; j++)
+		{	axpy(+coeff[j], history[0].state, state);
+			axpy(-coeff[j], history[j+1].state, state);
+		}
+		setState(state);
+	}
+	else setState(history[0].state);
+	logPrintf("Fluid state %s from %d previous ionic steps (fit captures %.1lf%% of cavity change).\n",
+		reliable ? "extrapolated" : "reset to converged state", nFit+1,
+		nDiffSq ? 100.*(1. - std::max(0., residualSq)/nDiffSq) : 100.);
+	logFlush();
+	watch.stop();
+}
+
+//Solve the fluid for the first configuration of this ionic step starting from both the previous converged state
+//(the plain warm start) and the extrapolated state, and report the fluid iterations saved by extrapolation
+void FluidSolver::compareExtrapolation(const ScalarFieldTilde& nCavityTilde)
+{	int nIterPrev = nIterTotal;
+	//Baseline from previous converged state:
+	setState(history[0].state);
+	minimizeFluid();
+	int nIterWarm = nIterTotal - nIterPrev;
+	nIterTotal = nIterPrev; //exclude baseline solve from the iteration statistics
+	//Solve from extrapolated state (this result is retained):
+	extrapolateState(nCavityTilde);
+	minimizeFluid();
+	int nIterFirst = nIterTotal - nIterPrev;
+	//Report:
+	nStepsBaseline++;
+	nIterSaved += nIterWarm - nIterFirst;
+	logPrintf("Fluid extrapolation: first fluid solve took %d iterations (%d from previous converged state), %d saved (%.1lf on average over %d steps).\n",
+		nIterFirst, nIterWarm, nIterWarm - nIterFirst, nIterSaved*1./nStepsBaseline, nStepsBaseline);
+	logFlush();
 }
 
 double FluidSolver::get_Adiel_and_grad(ScalarFieldTilde* Adiel_rhoExplicitTilde, ScalarFieldTilde* Adiel_nCavityTilde, IonicGradient* extraForces, matrix3<>* Adiel_RRT) const
@@ -27,6 +27,7 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #include <core/ScalarField.h>
 #include <fluid/FluidSolverParams.h>
 #include <electronic/IonicMinimizer.h>
+#include <deque>
 
 //! Abstract base class for the fluid solvers
 struct FluidSolver
@@ -38,6 +39,7 @@ struct FluidSolver
 	double k2factor; //!< prefactor to screening term (0 => no ionic screening)
 	std::vector<std::vector< vector3<> > > atpos; //!atomic positions per species in the relevant coordinate system (depending on embedding option)
 	ScalarFieldTilde A_rhoNonES; //!Any non-electrostatic contributions to A_rhoExplicitTilde (removed from dumped d_fluid / d_tot)
+	int nIterTotal; //!< total number of fluid iterations so far (accumulated by minimizeFluid() of derived classes)
 	
 	//! Abstract base class constructor - do not use directly - see FluidSolver::createSolver
 	FluidSolver(const Everything &e, const FluidSolverParams& fsp);
@@ -88,6 +90,15 @@ struct FluidSolver
 	//! Fluid solver implementations may override to dump fluid debug stuff, no dumping by default
 	virtual void dumpDebug(const char* filenamePattern) const {};
 
+	//! Prepare for a new ionic configuration: the fluid state will be extrapolated from
+	//! the history of previous ionic steps during the next set(), matched to the change in cavity.
+	//! Call once per ionic step, before the electronic minimization.
+	void beginIonicStep();
+	
+	//! Record the converged fluid state and cavity of current ionic step for subsequent extrapolation,
+	//! and report the fluid iterations taken. Call after electronic minimization.
+	void endIonicStep();
+
 	//------------Fluid solver implementations must provide these pure virtual functions
 
 	//! Specify whether fluid prefers a gummel loop (true) or is minimized each time (false)
@@ -99,6 +110,12 @@ struct FluidSolver
 	//! Save fluid state to a file
 	virtual void saveState(const char* filename) const=0;
 
+	//! Get a copy of the fluid state in memory (in the real-space representation used by saveState)
+	virtual void getState(ScalarFieldArray& state) const=0;
+
+	//! Set the fluid state from memory (in the real-space representation used by loadState)
+	virtual void setState(const ScalarFieldArray& state)=0;
+
 	//! Minimize fluid side (holding explicit electronic system fixed)
 	virtual void minimizeFluid()=0;
 	
@@ -111,6 +128,22 @@ protected:
 	
 	//! Fluid-dependent implementation of getSusceptibility()
 	virtual void getSusceptibility_internal(const std::vector<complex>& omega, std::vector<SusceptibilityTerm>& susceptibility, ScalarFieldArray& sArr, bool elecOnly) const;
+
+private:
+	//! Converged fluid state and corresponding cavity-determining density at a previous ionic step
+	struct HistoryEntry
+	{	ScalarFieldTilde nCavityTilde;
+		ScalarFieldArray state;
+	};
+	std::deque<HistoryEntry> history; //!< most recent ionic step first
+	ScalarFieldTilde nCavityTildeLast; //!< nCavityTilde from most recent set()
+	bool extrapolatePending; //!< whether the next set() should extrapolate the state
+	int nIterStart; //!< nIterTotal at the beginning of current ionic step
+	int nStepsExtrap, nIterExtrap; //!< number of ionic steps and total fluid iterations with extrapolated state
+	int nStepsBaseline, nIterSaved; //!< number of ionic steps compared against the previous converged state, and total fluid iterations saved
+	
+	void extrapolateState(const ScalarFieldTilde& nCavityTilde); //!< extrapolate state from history to the given cavity
+	void compareExtrapolation(const ScalarFieldTilde& nCavityTilde); //!< extrapolate after a baseline solve from the previous converged state (FluidSolverParams::extrapolationBaseline)
 };
 
 //! Create and return a JDFTx solver (the solver can be freed using delete)
@@ -22,7 +22,7 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #include <core/Units.h>
 
 FluidSolverParams::FluidSolverParams()
-: T(298*Kelvin), P(1.01325*Bar), epsBulkOverride(0.), epsInfOverride(0.), verboseLog(false), solveFrequency(FluidFreqDefault),
+: T(298*Kelvin), P(1.01325*Bar), epsBulkOverride(0.), epsInfOverride(0.), verboseLog(false), solveFrequency(FluidFreqDefault), nExtrapolationHistory(0), extrapolationBaseline(false),
 components(components_), solvents(solvents_), cations(cations_), anions(anions_),
 vdwScale(0.75), pCavity(0.), lMax(3), cavityScale(1.), ionSpacing(0.),
 zMask0(0.), zMaskH(0.), zMaskIonH(0.), zMaskSigma(0.5),
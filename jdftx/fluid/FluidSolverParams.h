@@ -105,6 +105,8 @@ struct FluidSolverParams
 	vector3<> epsBulkTensor; //!< Override default dielectric constants with a tensor if non-zero (assuming Cartesian coords are principal axes, LinearPCM only)
 	bool verboseLog; //!< whether iteration progress is printed for Linear PCM's, and whether sub-iteration progress is printed for others
 	FluidSolveFrequency solveFrequency;
+	int nExtrapolationHistory; //!< number of previous ionic steps used to extrapolate the fluid state (0 to disable, the default)
+	bool extrapolationBaseline; //!< whether to also solve the fluid from the previous converged state in each extrapolated step, to report iterations saved
 	
 	const std::vector< std::shared_ptr<FluidComponent> >& components; //!< list of all fluid components
 	const std::vector< std::shared_ptr<FluidComponent> >& solvents; //!< list of solvent components
@@ -43,7 +43,7 @@ void IdealGasMonoatomic::getDensities(const ScalarField* psi, ScalarField* N, ve
 }
 
 double IdealGasMonoatomic::compute(const ScalarField* psi, const ScalarField* N, ScalarField* Phi_N, const double Nscale, double& Phi_Nscale) const
-{	ScalarField PhiNI_N = T*psi[0] + V[0] - (mu + T);
+{	ScalarField PhiNI_N = T*lazy(psi[0]) + V[0] - (mu + T);
 	Phi_N[0] += PhiNI_N;
 	Phi_N[0] += T;
 	return gInfo.dV*dot(N[0], PhiNI_N);
@@ -104,6 +104,7 @@ void LinearPCM::minimizeFluid()
 	//Minimize:
 	fprintf(e.fluidMinParams.fpLog, "\n\tWill stop at %d iterations, or sqrt(|r.z|)<%le\n", e.fluidMinParams.nIterations, e.fluidMinParams.knormThreshold);
 	int nIter = solve(rhoExplicitTilde, e.fluidMinParams);
+	nIterTotal += nIter;
 	logPrintf("\tCompleted after %d iterations at t[s]: %9.2lf\n", nIter, clock_sec());
 }
 
@@ -180,6 +181,14 @@ void LinearPCM::saveState(const char* filename) const
 {	if(mpiWorld->isHead()) saveRawBinary(I(state), filename); //saved data is in real space
 }
 
+void LinearPCM::getState(ScalarFieldArray& state) const
+{	state.assign(1, I(this->state)); //same representation as saved data
+}
+
+void LinearPCM::setState(const ScalarFieldArray& state)
+{	this->state = J(state[0]);
+}
+
 void LinearPCM::dumpDensities(const char* filenamePattern) const
 {	PCM::dumpDensities(filenamePattern);
 	//Output dielectric bound charge
@@ -36,10 +36,13 @@ public:
 
 	ScalarFieldTilde hessian(const ScalarFieldTilde&) const; //!< Implements #LinearSolvable::hessian for the dielectric poisson equation
 	ScalarFieldTilde precondition(const ScalarFieldTilde&) const; //!< Implements a modified inverse kinetic preconditioner
+	const char* telemetryStage() const { return "fluid"; } //!< emit telemetry records for each iteration
 
 	void minimizeFluid(); //!< Converge using linear conjugate gradients
 	void loadState(const char* filename); //!< Load state from file
 	void saveState(const char* filename) const; //!< Save state to file
+	void getState(ScalarFieldArray& state) const; //!< Get state in memory
+	void setState(const ScalarFieldArray& state); //!< Set state from memory
 	void dumpDensities(const char* filenamePattern) const; //!< Dump fluid densities to file
 
 protected:
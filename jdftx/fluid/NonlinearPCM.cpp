@@ -154,6 +154,14 @@ void NonlinearPCM::saveState(const char* filename) const
 {	if(mpiWorld->isHead()) saveRawBinary(I(phiTot), filename); //saved data is in real space
 }
 
+void NonlinearPCM::getState(ScalarFieldArray& state) const
+{	state.assign(1, I(this->phiTot)); //same representation as saved data
+}
+
+void NonlinearPCM::setState(const ScalarFieldArray& state)
+{	this->phiTot = J(state[0]);
+}
+
 void NonlinearPCM::minimizeFluid()
 {	//Info:
 	logPrintf("\tNonlinear fluid (bulk dielectric constant: %g) occupying %lf of unit cell\n",
@@ -165,6 +173,7 @@ void NonlinearPCM::minimizeFluid()
 
 	//Minimize:
 	minimize(e.fluidMinParams);
+	nIterTotal += iterLast;
 	logPrintf("\tNonlinear solve completed after %d iterations at t[s]: %9.2lf\n", iterLast, clock_sec());
 }
 
@@ -215,6 +224,11 @@ bool NonlinearPCM::report(int iter)
 }
 
 
+double NonlinearPCM::sync(double x) const
+{	mpiWorld->bcast(x);
+	return x;
+}
+
 void NonlinearPCM::set_internal(const ScalarFieldTilde& rhoExplicitTilde, const ScalarFieldTilde& nCavityTilde)
 {	//Store the explicit system charge:
 	this->rhoExplicitTilde = rhoExplicitTilde; zeroNyquist(this->rhoExplicitTilde);
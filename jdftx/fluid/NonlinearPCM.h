@@ -44,6 +44,8 @@ public:
 
 	void loadState(const char* filename); //!< Load state from file
 	void saveState(const char* filename) const; //!< Save state to file
+	void getState(ScalarFieldArray& state) const; //!< Get state in memory
+	void setState(const ScalarFieldArray& state); //!< Set state from memory
 	void dumpDensities(const char* filenamePattern) const;
 	void minimizeFluid(); //!< Converge using nonlinear conjugate gradients
 
@@ -51,6 +53,8 @@ public:
 	void step(const ScalarFieldTilde& dir, double alpha);
 	double compute(ScalarFieldTilde* grad, ScalarFieldTilde* Kgrad);
 	bool report(int iter);
+	double sync(double x) const; //!< All processes minimize together; make sure scalars are in sync to round-off error
+	const char* telemetryStage() const { return "fluid"; } //!< emit telemetry records for each iteration
 
 protected:
 	void set_internal(const ScalarFieldTilde& rhoExplicitTilde, const ScalarFieldTilde& nCavityTilde);
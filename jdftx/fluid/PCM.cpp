@@ -525,7 +525,7 @@ void PCM::propagateCavityGradients(const ScalarFieldArray& A_shape, ScalarField&
 		ScalarField DnLength = sqrt(lengthSquared(Dn));
 		ScalarField A_shapeMinus = (fsp.cavityTension/fsp.rhoDelta) * DnLength;
 		ScalarField A_DnLength = (fsp.cavityTension/fsp.rhoDelta) * (shapeMinus - shapePlus);
-		A_nCavity -= divergence(Dn * (inv(DnLength) * A_DnLength));
+		A_nCavity -= divergence(Dn * evaluate(lazy(A_DnLength) / DnLength));
 		ShapeFunctionSCCS::propagateGradient(nCavity+(0.5*fsp.rhoDelta), -A_shapeMinus, A_nCavity, fsp.rhoMin, fsp.rhoMax, epsBulk);
 		ShapeFunctionSCCS::propagateGradient(nCavity-(0.5*fsp.rhoDelta),  A_shapeMinus, A_nCavity, fsp.rhoMin, fsp.rhoMax, epsBulk);
 	}
@@ -405,7 +405,7 @@ namespace NonlinearPCMeval
 		filename = filenamePattern; \
 		filename.replace(filename.find("%s"), 2, suffix); \
 		logPrintf("Dumping '%s'... ", filename.c_str());  logFlush(); \
-		if(mpiWorld->isHead()) saveRawBinary(object, filename.c_str()); \
+		e.dump.saveField(object, filename, suffix); \
 		logPrintf("done.\n"); logFlush();
 
 
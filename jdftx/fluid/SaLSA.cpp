@@ -226,7 +226,7 @@ void SaLSA::set_internal(const ScalarFieldTilde& rhoExplicitTilde, const ScalarF
 		siteShape[iSite] = I(Sf[iSite] * J(shape[0]));
 	
 	//Update the inhomogeneity factor of the preconditioner
-	epsInv = inv(1. + (epsBulk-1.)*shape[0]);
+	epsInv = inv(1. + (epsBulk-1.)*lazy(shape[0]));
 	
 	//Initialize the state if it hasn't been loaded:
 	if(!state) nullToZero(state, gInfo);
@@ -239,6 +239,7 @@ void SaLSA::minimizeFluid()
 	fprintf(e.fluidMinParams.fpLog, "\n\tWill stop at %d iterations, or sqrt(|r.z|)<%le\n",
 		e.fluidMinParams.nIterations, e.fluidMinParams.knormThreshold);
 	int nIter = solve(rhoExplicitTilde, e.fluidMinParams);
+	nIterTotal += nIter;
 	logPrintf("\tCompleted after %d iterations at t[s]: %9.2lf\n", nIter, clock_sec());
 }
 
@@ -337,6 +338,14 @@ void SaLSA::saveState(const char* filename) const
 {	if(mpiWorld->isHead()) saveRawBinary(I(state), filename); //saved data is in real space
 }
 
+void SaLSA::getState(ScalarFieldArray& state) const
+{	state.assign(1, I(this->state)); //same representation as saved data
+}
+
+void SaLSA::setState(const ScalarFieldArray& state)
+{	this->state = J(state[0]);
+}
+
 void SaLSA::dumpDensities(const char* filenamePattern) const
 {	PCM::dumpDensities(filenamePattern);
 	
@@ -393,7 +402,7 @@ void SaLSA::dumpDensities(const char* filenamePattern) const
 			if(c->molecule.sites.size()>1) oss << "_" << s.name;
 			sprintf(filename, filenamePattern, oss.str().c_str());
 			logPrintf("Dumping '%s' ... ", filename); logFlush();
-			if(mpiWorld->isHead()) saveRawBinary(N, filename);
+			e.dump.saveField(N, filename, oss.str());
 			
 			{	//debug sphericalized site densities
 				ostringstream oss; oss << "Nspherical_" << c->molecule.name;
@@ -38,10 +38,13 @@ public:
 	ScalarFieldTilde hessian(const ScalarFieldTilde&) const; //!< Implements #LinearSolvable::hessian for the non-local poisson-like equation
 	ScalarFieldTilde precondition(const ScalarFieldTilde&) const; //!< Implements a modified inverse kinetic preconditioner
 	double sync(double x) const; //!< All processes minimize together; make sure scalars are in sync to round-off error
+	const char* telemetryStage() const { return "fluid"; } //!< emit telemetry records for each iteration
 
 	void minimizeFluid(); //!< Converge using linear conjugate gradients
 	void loadState(const char* filename); //!< Load state from file
 	void saveState(const char* filename) const; //!< Save state to file
+	void getState(ScalarFieldArray& state) const; //!< Get state in memory
+	void setState(const ScalarFieldArray& state); //!< Set state from memory
 	void dumpDensities(const char* filenamePattern) const; //!< dump cavity shape functions
 
 protected:
@@ -24,30 +24,36 @@ along with JDFTx.  If not, see <http://www.gnu.org/licenses/>.
 #include <electronic/ElecMinimizer.h>
 #include <electronic/LatticeMinimizer.h>
 #include <electronic/Vibrations.h>
+#include <electronic/CalculatorServer.h>
+#include <electronic/NEB.h>
 #include <electronic/IonicDynamics.h>
 #include <perturb/PerturbationSolver.h>
 #include <fluid/FluidSolver.h>
 #include <core/Util.h>
+#include <core/Telemetry.h>
 #include <commands/parser.h>
+#include <sys/stat.h>
+#include <dirent.h>
 
-//Program entry point
-int main(int argc, char** argv)
-{	//Parse command line, initialize system and logs:
-	Everything e; //the parent data structure for, well, everything
-	InitParams ip("Performs Joint Density Functional Theory calculations.", &e);
-	initSystemCmdline(argc, argv, ip);
-	
-	//Parse input file and setup
-	ElecVars& eVars = e.eVars;
-	parse(readInputFile(ip.inputFilename), e, ip.printDefaults);
+void runBatch(const InitParams& ip);
+
+//Set up and run the calculation specified by input (already parsed into e)
+void run(Everything& e, const std::vector< std::pair<string,string> >& input, const InitParams& ip)
+{	ElecVars& eVars = e.eVars;
+	if(e.dump.telemetryTarget.length() and (not ip.dryRun))
+		Telemetry::open(e.dump.telemetryTarget);
+	if(e.neb) //Reaction path: each image sets up its own Everything (re-parsed from input) within an image process group
+	{	e.neb->run(e, input, ip.dryRun);
+		Telemetry::close();
+		return;
+	}
 	if(ip.dryRun) eVars.skipWfnsInit = true;
 	e.setup();
 	e.dump(DumpFreq_Init, 0);
 	Citations::print();
 	if(ip.dryRun)
 	{	logPrintf("Dry run successful: commands are valid and initialization succeeded.\n");
-		finalizeSystem();
-		return 0;
+		return;
 	}
 	else logPrintf("Initialization completed successfully at t[s]: %9.2lf\n\n", clock_sec());
 	logFlush();
@@ -90,6 +96,9 @@ int main(int argc, char** argv)
 			e.eInfo.smearReport();
 		}
 	}
+	else if(e.server) //Serve energy/force/stress requests from an external driver at geometries it supplies
+	{	e.server->run();
+	}
 	else if(e.vibrations) //Bypasses ionic/lattice minimization, calls electron/fluid minimization loops at various ionic configurations
 	{	e.vibrations->calculate();
 	}
@@ -115,8 +124,133 @@ int main(int argc, char** argv)
 	}
 
 	//Final dump:
+	e.eInfo.printLoadBalance(eVars.tStatesMine);
 	e.dump(DumpFreq_End, 0);
+	Telemetry::close();
+}
+
+//Program entry point
+int main(int argc, char** argv)
+{	//Parse command line, initialize system and logs:
+	Everything e; //the parent data structure for, well, everything
+	InitParams ip("Performs Joint Density Functional Theory calculations.", &e);
+	initSystemCmdline(argc, argv, ip);
+	
+	if(ip.batchInput.length())
+		runBatch(ip); //many input files, each with its own Everything
+	else
+	{	//Parse input file, setup and run:
+		std::vector< std::pair<string,string> > input = readInputFile(ip.inputFilename);
+		parse(input, e, ip.printDefaults);
+		run(e, input, ip);
+	}
 	
 	finalizeSystem();
 	return 0;
 }
+
+//Get list of input files for batch mode (on all processes):
+std::vector<string> getBatchInputs(string batchInput)
+{	std::vector<string> inputs;
+	if(mpiWorld->isHead())
+	{	struct stat st;
+		if(stat(batchInput.c_str(), &st)==0 && S_ISDIR(st.st_mode))
+		{	//Directory: all files ending in .in
+			DIR* dir = opendir(batchInput.c_str());
+			while(dir)
+			{	dirent* entry = readdir(dir);
+				if(!entry) break;
+				string name(entry->d_name);
+				if(name.length()>3 && name.substr(name.length()-3)==".in")
+					inputs.push_back(batchInput + "/" + name);
+			}
+			if(dir) closedir(dir);
+			std::sort(inputs.begin(), inputs.end());
+		}
+		else
+		{	//File listing inputs, one per line:
+			ifstream ifs(batchInput.c_str());
+			if(!ifs.is_open()) die_alone("Could not open batch input list '%s' for reading.\n", batchInput.c_str());
+			while(!ifs.eof())
+			{	string line; getline(ifs, line); trim(line);
+				if(line.length() && line[0]!='#') inputs.push_back(line);
+			}
+		}
+	}
+	int nInputs = inputs.size();
+	mpiWorld->bcast(nInputs);
+	inputs.resize(nInputs);
+	for(string& input: inputs) mpiWorld->bcast(input);
+	return inputs;
+}
+
+//Run each input file in turn within each process group, with a separate log and failure isolation
+void runBatch(const InitParams& ip)
+{	std::vector<string> inputs = getBatchInputs(ip.batchInput);
+	int nGroups = mpiGroup->procDivision.nGroups;
+	int iGroup = mpiGroup->procDivision.iGroup;
+	logPrintf("\nRunning %d calculations in batch mode, distributed over %d process groups.\n", int(inputs.size()), nGroups);
+	logPrintf("Species transforms and Coulomb kernels are reused between calculations in each group.\n\n");
+	logFlush();
+	
+	batchMode = true;
+	MPIUtil* mpiWorldFull = mpiWorld;
+	mpiWorld = mpiGroup; //each calculation runs within its process group
+	std::vector<int> status(inputs.size(), 0); //1 for success and -1 for failure (from group heads)
+	string inputBasenameOrig = inputBasename;
+	for(size_t iJob=iGroup; iJob<inputs.size() and (not killFlag); iJob+=nGroups)
+	{	const string& inputFilename = inputs[iJob];
+		//Output to <input>.out, with <input> (without extension or path) as the default dump name:
+		string jobName = inputFilename.substr(0, inputFilename.find_last_of("."));
+		size_t lastSlash = jobName.find_last_of("\\/");
+		inputBasename = (lastSlash==string::npos) ? jobName : jobName.substr(lastSlash+1);
+		FILE* fpJob = nullLog;
+		if(mpiWorld->isHead())
+		{	fpJob = fopen((jobName + ".out").c_str(), "w");
+			if(!fpJob) fpJob = nullLog;
+		}
+		FILE* fpLogPrev = logRedirect(fpJob);
+		printVersionBanner(&ip);
+		logPrintf("Batch calculation %d of %d with input file '%s'\n", int(iJob+1), int(inputs.size()), inputFilename.c_str());
+		//Run calculation, isolating failures:
+		bool success = false;
+		if(fileSize(inputFilename.c_str()) <= 0)
+			logPrintf("Input file '%s' is missing or empty.\n", inputFilename.c_str());
+		else
+		{	try
+			{	Everything e;
+				std::vector< std::pair<string,string> > input = readInputFile(inputFilename);
+				parse(input, e, ip.printDefaults);
+				run(e, input, ip);
+				success = true;
+			}
+			catch(BatchJobFailure)
+			{	mpiWorld = mpiGroup; //in case failure occurred within a nested process division (eg. neb)
+				logResume(); //in case failure occurred while log was suspended
+				Telemetry::close(false);
+			}
+		}
+		logPrintf("%s\n", success ? "Done!" : "Failed.");
+		logRedirect(fpLogPrev);
+		if(fpJob != nullLog) fclose(fpJob);
+		if(mpiWorld->isHead()) status[iJob] = success ? 1 : -1;
+		logPrintf("Batch calculation %d (%s): %s at t[s]: %9.2lf\n", int(iJob+1), inputFilename.c_str(), success ? "done" : "FAILED", clock_sec());
+		logFlush();
+	}
+	mpiWorld = mpiWorldFull;
+	batchMode = false;
+	inputBasename = inputBasenameOrig;
+	
+	//Summarize:
+	mpiWorld->allReduceData(status, MPIUtil::ReduceSum);
+	int nDone = std::count(status.begin(), status.end(), 1);
+	int nFailed = std::count(status.begin(), status.end(), -1);
+	logPrintf("\nBatch mode completed %d of %d calculations successfully.\n", nDone, int(inputs.size()));
+	if(nFailed)
+	{	logPrintf("Failed calculations:\n");
+		for(size_t iJob=0; iJob<inputs.size(); iJob++)
+			if(status[iJob] == -1)
+				logPrintf("\t%s\n", inputs[iJob].c_str());
+	}
+	logPrintf("\n");
+}
@@ -6,7 +6,7 @@
 
 from __future__ import print_function #For Python2 compatibility
 
-import os, scipy, subprocess, tempfile, re
+import os, scipy, subprocess, tempfile, re, socket, time
 from ase.calculators.calculator import Calculator
 from ase.units import Bohr, Hartree
 
@@ -23,7 +23,7 @@ def replaceVariable(var, varName):
 
 class JDFTx(Calculator):
 
-	def __init__(self, executable=None, pseudoDir=None, pseudoSet='GBRV', commands=None, ignoreStress=False):
+	def __init__(self, executable=None, pseudoDir=None, pseudoSet='GBRV', commands=None, ignoreStress=False, server=False):
 		#Valid pseudopotential sets (mapping to path and suffix):
 		pseudoSetMap = {
 			'SG15' : 'SG15/$ID_ONCV_PBE.upf',
@@ -37,6 +37,7 @@ class JDFTx(Calculator):
 		self.executable = replaceVariable(executable, 'JDFTx')      #Path to the jdftx executable (cpu or gpu)
 		self.pseudoDir = replaceVariable(pseudoDir, 'JDFTx_pseudo') #Path to the pseudopotentials folder
 		self.ignoreStress = ignoreStress
+		self.server = server #Whether to keep one jdftx process running as a calculator server across geometries
 		
 		if (self.executable is None):
 			raise Exception('Specify path to jdftx in argument \'executable\' or in environment variable \'JDFTx\'.')
@@ -73,6 +74,12 @@ class JDFTx(Calculator):
 		# Current results
 		self.E = None
 		self.Forces = None
+		self.Stress = None
+
+		# Calculator server state
+		self.serverProcess = None
+		self.serverSocket = None
+		self.serverInput = None
 
 		# History
 		self.lastAtoms = None
@@ -108,6 +115,7 @@ class JDFTx(Calculator):
 		self.kpoints.append((b1, b2, b3, w))
 	
 	def clean(self):
+		self.stopServer()
 		shell('rm -rf ' + self.runDir)
 
 	def calculation_required(self, atoms, quantities):
@@ -130,8 +138,12 @@ class JDFTx(Calculator):
 	def get_stress(self, atoms):
 		if self.ignoreStress:
 			return scipy.zeros((3,3))
+		elif self.server:
+			if(self.calculation_required(atoms, None)):
+				self.update(atoms)
+			return self.Stress
 		else:
-			raise NotImplementedError('Stress calculation not implemented in JDFTx interface: set ignoreStress=True to ignore.')
+			raise NotImplementedError('Stress calculation only implemented in server mode in JDFTx interface: set server=True, or ignoreStress=True to ignore.')
 
 	################### I/O ###################
 
@@ -166,7 +178,85 @@ class JDFTx(Calculator):
 	############## Running JDFTx ##############
 
 	def update(self, atoms):
-		self.runJDFTx(self.constructInput(atoms))
+		if self.server:
+			self.runServer(atoms)
+		else:
+			self.runJDFTx(self.constructInput(atoms))
+
+	def runServer(self, atoms):
+		""" Computes energy, forces and stress using a persistent jdftx calculator server """
+		#Restart server if anything other than positions and lattice changed:
+		serverKey = (atoms.get_chemical_symbols(), list(atoms.get_pbc()), list(self.input), list(self.dumps), self.kpoints)
+		if (self.serverProcess is not None) and (serverKey != self.serverInput):
+			self.stopServer()
+		if self.serverProcess is None:
+			socketPath = self.runDir + '/socket'
+			inputfile = self.constructInput(atoms)
+			inputfile += 'symmetries none\n'
+			inputfile += 'calculator-server %s %s\n' % (socketPath, 'no' if self.ignoreStress else 'yes')
+			fp = open(self.runDir+'/in', 'w')
+			fp.write(inputfile)
+			fp.close()
+			self.serverProcess = subprocess.Popen('cd %s && exec %s -i in -o out' % (self.runDir, self.executable), shell=True)
+			self.serverInput = serverKey
+			#Connect once server is listening:
+			self.serverSocket = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+			while True:
+				if self.serverProcess.poll() is not None:
+					raise IOError('JDFTx calculator server exited during initialization: see %s/out' % self.runDir)
+				try:
+					self.serverSocket.connect(socketPath)
+					break
+				except socket.error:
+					time.sleep(0.1)
+			self.serverStream = self.serverSocket.makefile('rw')
+			#Map ASE atom order to server order (grouped by species):
+			tokens = self.serverStream.readline().split()
+			assert tokens[0] == 'species'
+			symbols = atoms.get_chemical_symbols()
+			self.serverOrder = []
+			for name, nAtoms in zip(tokens[1::2], tokens[2::2]):
+				indices = [i for i, symbol in enumerate(symbols) if symbol == name]
+				assert len(indices) == int(nAtoms)
+				self.serverOrder += indices
+		#Send geometry and compute:
+		R = atoms.get_cell() / Bohr
+		pos = atoms.get_positions()[self.serverOrder] / Bohr
+		self.serverStream.write('lattice ' + ' '.join('%.15g' % R[j,i] for i in range(3) for j in range(3)) + '\n')
+		self.serverStream.write('ion-positions ' + ' '.join('%.15g' % x for x in pos.flatten()) + '\n')
+		self.serverStream.write('compute\n')
+		self.serverStream.flush()
+		result = {}
+		while True:
+			tokens = self.serverStream.readline().split()
+			if len(tokens) == 0:
+				raise IOError('JDFTx calculator server disconnected: see %s/out' % self.runDir)
+			if tokens[0] == 'error':
+				message = ' '.join(tokens[1:])
+				while len(tokens) and tokens[0] != 'end': #drain reply so that the stream stays in sync
+					tokens = self.serverStream.readline().split()
+				raise IOError('JDFTx calculator server: ' + message)
+			if tokens[0] == 'end':
+				break
+			result[tokens[0]] = scipy.array([float(x) for x in tokens[1:]])
+		self.E = result['energy'][0] * Hartree
+		forces = scipy.zeros((len(atoms), 3))
+		forces[self.serverOrder] = result['forces'].reshape(-1, 3)
+		self.Forces = (Hartree / Bohr) * forces
+		if 'stress' in result:
+			sigma = result['stress'].reshape(3, 3) * (Hartree / Bohr**3)
+			self.Stress = scipy.array([sigma[0,0], sigma[1,1], sigma[2,2], sigma[1,2], sigma[0,2], sigma[0,1]])
+		self.lastAtoms = atoms.copy()
+		self.lastInput = list(self.input)
+
+	def stopServer(self):
+		""" Stops the jdftx calculator server, if running (allowing it to complete final dumps) """
+		if self.serverProcess is not None:
+			self.serverStream.write('quit\n')
+			self.serverStream.flush()
+			self.serverSocket.close()
+			self.serverProcess.wait()
+			self.serverProcess = None
 
 	def runJDFTx(self, inputfile):
 		""" Runs a JDFTx calculation """
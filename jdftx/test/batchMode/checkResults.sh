@@ -0,0 +1,10 @@
+#!/bin/bash
+
+echo "4"  #number of checks
+
+#A failing calculation should not prevent subsequent ones:
+awk 'END { print ($0=="Failed."), "1 0 Invalid input failed" }' jobs/1-invalid.out
+awk 'END { print ($0=="Done!"), "1 0 Next calculation completed" }' jobs/2-H2.out
+
+#Summary should report both calculations:
+awk '/Batch mode completed/ { print $4, "1 0 Successful calculations"; print $6, "2 0 Total calculations" }' batch.out
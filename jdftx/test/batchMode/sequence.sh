@@ -0,0 +1,7 @@
+#!/bin/bash
+#Batch mode over a directory of inputs, copied here so that each job's output is written to the run directory:
+mkdir -p jobs
+cp $SRCDIR/jobs/*.in jobs/
+export runs="batch"
+export batchInput="jobs"
+export nProcs="1"
@@ -0,0 +1,26 @@
+#!/bin/bash
+
+echo "6"  #number of checks
+
+if [ ! -f client.log ]; then
+	for i in 1 2 3 4 5 6; do echo "0 0 1 python3 not found (check skipped)"; done
+	exit 0
+fi
+
+awk '/nAtoms/ { print $2, "2 0 Atoms in species list" }' client.log
+
+#Energy and forces at initial geometry should match the single-point reference:
+awk '/IonicMinimize: Iter:/ { E = $5 } END { print E }' reference.out > reference.energy
+awk '/^energy0/ { E0 = $2 } END { getline Eref < "reference.energy"; print E0-Eref, "0 1e-5 Server - reference energy [Eh]" }' client.log
+awk '/# Forces in Cartesian/ { nF = 0; inForces = 1; next }
+	inForces && /^force/ { F[nF++] = $3; F[nF++] = $4; F[nF++] = $5; next }
+	{ inForces = 0 }
+	END { for(i=0; i<nF; i++) print F[i] }' reference.out > reference.forces
+awk 'BEGIN { while((getline f < "reference.forces") > 0) Fref[n++] = f }
+	/^forces0/ { dFmax = 0.; for(i=0; i<n; i++) { dF = $(i+2) - Fref[i]; if(dF<0) dF=-dF; if(dF>dFmax) dFmax=dF } }
+	END { print dFmax, "0 1e-4 Server - reference max force error [Eh/a0]" }' client.log
+
+#Subsequent requests:
+awk '/^energy0/ { E0 = $2 } /^energy1/ { print ($2>E0), "1 0 Stretched bond energy higher" }' client.log
+awk '/^error/ { print $2, "1 0 Invalid request rejected" }' client.log
+awk '/^energy0/ { E0 = $2 } /^energy2/ { print $2-E0, "0 1e-5 Energy change on returning to initial geometry [Eh]" }' client.log
@@ -0,0 +1,50 @@
+#!/usr/bin/env python3
+#Scripted client for the calculator server: waits for the server to start listening,
+#sends a sequence of requests and prints the replies as "key values..." lines.
+import socket, sys, time
+
+sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+for i in range(3600):
+	try:
+		sock.connect(sys.argv[1])
+		break
+	except OSError:
+		time.sleep(1) #server not listening yet (reference run in progress)
+else:
+	sys.exit("Timed out waiting for calculator server.")
+f = sock.makefile("rw")
+
+species = f.readline().split()
+print("nAtoms", sum(int(n) for n in species[2::2]))
+
+def request(lines):
+	for line in lines:
+		f.write(line + "\n")
+	f.write("compute\n")
+	f.flush()
+	reply = {}
+	while True:
+		tokens = f.readline().split()
+		if tokens[0] == "end":
+			return reply
+		reply[tokens[0]] = tokens[1:]
+
+def positions(d):
+	return "ion-positions 0 0 %g 0 0 %g" % (-0.5*d, 0.5*d)
+
+#Initial geometry (compared to reference):
+reply = request(["lattice 10 0 0 0 10 0 0 0 10", positions(1.4)])
+print("energy0", *reply["energy"])
+print("forces0", *reply["forces"])
+#Stretched bond:
+reply = request([positions(1.6)])
+print("energy1", *reply["energy"])
+#Invalid request should be rejected without affecting subsequent ones:
+reply = request(["bogus", positions(1.5)])
+print("error", int("error" in reply and "energy" not in reply))
+#Back to initial geometry:
+reply = request([positions(1.4)])
+print("energy2", *reply["energy"])
+
+f.write("quit\n")
+f.flush()
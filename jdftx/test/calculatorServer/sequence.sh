@@ -0,0 +1,11 @@
+#!/bin/bash
+#Single-point reference, followed by the same geometry (and others) requested from a calculator server.
+#The scripted client is started in the background, and connects once the server starts listening:
+export runs="reference server"
+export nProcs="1"
+if ! command -v python3 > /dev/null; then
+	export runs="reference" #client requires python3 (server checks are skipped)
+elif [[ ! ( ( -f server.out ) && ( "$(tail -n 1 server.out)" == "Done!" ) ) ]]; then
+	rm -f server.sock client.log
+	python3 $SRCDIR/client.py server.sock > client.log &
+fi
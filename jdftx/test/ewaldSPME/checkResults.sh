@@ -0,0 +1,18 @@
+#!/bin/bash
+
+echo "4"  #number of checks
+
+awk '/Setting up smooth particle-mesh ewald/ { n[FILENAME]++ }
+	END { print (n["spme.out"]>0 && n["direct.out"]==0), "1 0 SPME used only when requested" }' direct.out spme.out
+
+#SPME energy and forces should match the direct Ewald sum:
+awk '/Eewald =/ { E[FILENAME] = $3 } END { print E["spme.out"]-E["direct.out"], "0 1e-6 SPME - direct Ewald energy [Eh]" }' direct.out spme.out
+awk '/^forcePairPot/ { if(FILENAME=="direct.out") { F[nD++]=$3; F[nD++]=$4; F[nD++]=$5 } else { G[nS++]=$3; G[nS++]=$4; G[nS++]=$5 } }
+	END { dFmax = 0.; Fmax = 0.;
+		for(i=0; i<nD; i++)
+		{	dF = G[i]-F[i]; if(dF<0) dF=-dF; if(dF>dFmax) dFmax=dF;
+			f = F[i]; if(f<0) f=-f; if(f>Fmax) Fmax=f;
+		}
+		print dFmax, "0 1e-5 SPME - direct max Ewald force error [Eh/a0]";
+		print (nS==nD && Fmax>1e-3), "1 0 Non-trivial Ewald forces compared";
+	}' direct.out spme.out
@@ -0,0 +1,3 @@
+#!/bin/bash
+export runs="direct spme"
+export nProcs="1"
@@ -0,0 +1,39 @@
+#!/bin/bash
+
+echo "6"  #number of checks
+
+if ! command -v python3 > /dev/null; then
+	for i in 1 2 3 4 5 6; do echo "0 0 1 python3 not found (check skipped)"; done
+	exit 0
+fi
+
+#Compare densities written in each format (decoded by fieldToBinary, or by JDFTx and written back
+#in legacy format for the Reload runs) to the legacy output, with lossy error bound of 1e-6:
+python3 - "${SRCDIR}/../../scripts/fieldToBinary" <<'PYEOF'
+import sys
+try:
+	import importlib.util, importlib.machinery
+	import numpy as np
+	loader = importlib.machinery.SourceFileLoader("fieldToBinary", sys.argv[1])
+	module = importlib.util.module_from_spec(importlib.util.spec_from_loader("fieldToBinary", loader))
+	loader.exec_module(module)
+	readField = module.readField
+except ImportError:
+	for i in range(6):
+		print("0 0 1 python3 with numpy not found")
+	exit(0)
+import os
+nRef = readField("fieldLegacy.n")[0].flatten()
+def check(fname, expected, tol, name):
+	if not os.path.exists(fname):
+		print("0 0 1 " + name + " (skipped: no " + fname + ", eg. without zlib)")
+		return
+	n, info = readField(fname)
+	print(abs(n.flatten() - nRef).max(), expected, tol, name)
+check("fieldRaw.n", 0., 1e-12, "Raw codec max error")
+check("fieldLossless.n", 0., 1e-12, "Lossless codec max error")
+check("fieldLosslessReload.n", 0., 1e-12, "Lossless reload max error")
+check("fieldLossy.n", 0.5e-6, 0.5e-6, "Lossy codec max error")
+check("fieldLossyReload.n", 0.5e-6, 0.5e-6, "Lossy reload max error")
+print(readField("fieldLossy.n")[1]["errorBound"], 1e-6, 1e-12, "Lossy header error bound")
+PYEOF
@@ -0,0 +1,7 @@
+#!/bin/bash
+export runs="fieldLegacy fieldRaw fieldLossy fieldLossyReload"
+#Lossless codec is only available in builds with zlib:
+if grep -qiE '^EnableZlib:BOOL=(ON|YES|TRUE|1)$' "$jdftxBuildDir/CMakeCache.txt" 2>/dev/null; then
+	export runs="$runs fieldLossless fieldLosslessReload"
+fi
+export nProcs="4"
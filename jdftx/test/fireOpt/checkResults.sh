@@ -0,0 +1,13 @@
+#!/bin/bash
+
+echo "5"  #number of checks
+
+#FIRE with exponential preconditioner should reach the same minimum as the default minimizer:
+awk '/IonicMinimize: Iter/ { if(FILENAME=="ionicCG.out") Ecg = $5; else Efire = $5 }
+	END { print Efire-Ecg, "0 0.0001 FIRE - CG ionic energy [Eh]" }' ionicCG.out ionicFIRE.out
+awk 'NR==2 {x0=$3} NR==3 { print $3-x0, "0.25 0.001 Si fractional coordinate (ionic)" }' ionicFIRE.ionpos
+
+#Lattice optimization with FIRE (expected values as in latticeOpt):
+awk '/LatticeMinimize: Iter/ { E = $5 } END { print E, "-7.93641 0.0001 Si energy [Eh]" }' latticeFIRE.out
+awk 'NR==2 {x0=$3} NR==3 { print $3-x0, "0.25 0.001 Si fractional coordinate (lattice)" }' latticeFIRE.ionpos
+awk 'NR==2 { print sqrt($1*$1+$2*$2+$3*$3), "7.32 0.01 Si latvec length [a0]" }' latticeFIRE.lattice
@@ -0,0 +1,3 @@
+#!/bin/bash
+export runs="ionicCG ionicFIRE latticeFIRE"
+export nProcs="4"
@@ -0,0 +1,12 @@
+#!/bin/bash
+
+echo "3"  #number of checks
+
+#Extrapolating the fluid state should only change the starting point of each fluid solve:
+awk '/IonicMinimize: Iter/ { if(FILENAME=="warmStart.out") Ewarm = $5; else Eextrap = $5 }
+	END { print Eextrap-Ewarm, "0 0.0001 Extrapolated - warm start energy [Eh]" }' warmStart.out extrapolated.out
+awk '/Fluid state extrapolated from/ { n++ } END { print (n>0), "1 0.1 Fluid state extrapolated" }' extrapolated.out
+
+#Extrapolated starts should need fewer fluid iterations than the previous converged state (same electronic state):
+awk '/Fluid extrapolation: first fluid solve took/ { nExtrap += $7; nWarm += substr($9,2) }
+	END { print (nExtrap < nWarm), "1 0.1 Fewer fluid iterations from extrapolated state" }' extrapolated.out
@@ -0,0 +1,3 @@
+#!/bin/bash
+export runs="warmStart extrapolated"
+export nProcs="1"
@@ -1,8 +1,14 @@
 #!/bin/bash
 
-echo "4"  #number of checks
+echo "6"  #number of checks
 
 awk '/IonicMinimize: Iter/ { E = $5 } END { print E, "-124.4289 0.0001 TotalE Fe energy [Eh]" }' totalE.out
 awk '/FillingsUpdate/ { M = $(NF-1) } END { print M, "+2.159 0.001 TotalE Fe moment [muB]" }' totalE.out
 awk '/IonicMinimize: Iter/ { E = $5 } END { print E, "-124.4289 0.0001 SCF Fe energy [Eh]" }' SCF.out
 awk '/FillingsUpdate/ { M = $(NF-1) } END { print M, "+2.159 0.001 SCF Fe moment [muB]" }' SCF.out
+
+#ChFSI and Davidson inner eigensolvers should converge to the same SCF solution:
+awk '/IonicMinimize: Iter/ { if(FILENAME=="SCFchfsi.out") Echfsi = $5; else Edavidson = $5 }
+	END { print Echfsi-Edavidson, "0 0.0001 ChFSI - Davidson energy [Eh]" }' SCFdavidson.out SCFchfsi.out
+awk '/FillingsUpdate/ { if(FILENAME=="SCFchfsi.out") Mchfsi = $(NF-1); else Mdavidson = $(NF-1) }
+	END { print Mchfsi-Mdavidson, "0 0.001 ChFSI - Davidson moment [muB]" }' SCFdavidson.out SCFchfsi.out
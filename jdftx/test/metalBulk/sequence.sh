@@ -1,3 +1,3 @@
 #!/bin/bash
-export runs="totalE SCF"
+export runs="totalE SCF SCFdavidson SCFchfsi"
 export nProcs="4"
@@ -0,0 +1,8 @@
+#!/bin/bash
+
+echo "3"  #number of checks
+
+#Band should move away from the linear interpolation (iteration 0) and lower the barrier:
+awk '/NEB: Iter:/ { if(!n++) E0 = $5; E = $5 } END { print (n>1), "1 0 NEB iterations performed" }' H3.out
+awk '/NEB: Iter:/ { if(!n++) E0 = $5; E = $5 } END { print (E < E0-1e-4), "1 0 Barrier lowered from linear path" }' H3.out
+awk '/NEB: Iter:/ { E = $5 } END { print (E > 0), "1 0 Positive barrier" }' H3.out
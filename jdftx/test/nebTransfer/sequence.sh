@@ -0,0 +1,3 @@
+#!/bin/bash
+export runs="H3"
+export nProcs="3"
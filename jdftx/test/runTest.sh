@@ -22,7 +22,12 @@ fi
 echo "launch=\"$LAUNCH\""
 for run in $runs; do
 	if [[ ! ( ( -f $run.out ) && ( "$(awk '/End date and time:/ {endLine=NR+1} NR==endLine {print}' $run.out)" == "Done!" ) ) ]]; then
-		$LAUNCH $jdftxBuildDir/jdftx$JDFTX_SUFFIX -i $testSrcDir/$run.in -d -o $run.out
+		if [ -n "$batchInput" ]; then
+			inputArgs="-b $batchInput" #batch mode (sequence.sh then has a single run)
+		else
+			inputArgs="-i $testSrcDir/$run.in"
+		fi
+		$LAUNCH $jdftxBuildDir/jdftx$JDFTX_SUFFIX $inputArgs -d -o $run.out
 		if [ "$?" -ne "0" ]; then
 			echo "" > results
 			echo "FAILED: error running $run" > summary
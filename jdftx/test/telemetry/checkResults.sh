@@ -0,0 +1,33 @@
+#!/bin/bash
+
+echo "6"  #number of checks
+
+if ! command -v python3 > /dev/null; then
+	for i in 1 2 3 4 5 6; do echo "0 0 1 python3 not found (check skipped)"; done
+	exit 0
+fi
+
+#Parse JSON-lines telemetry stream, and compare iteration records to the log:
+python3 - <<'PYEOF'
+import json
+records = []
+nInvalid = 0
+for line in open("water.telemetry"):
+	try:
+		records.append(json.loads(line))
+	except ValueError:
+		nInvalid += 1
+def countLog(pattern):
+	return sum(1 for line in open("water.out") if pattern in line)
+def countStage(stage):
+	return sum(1 for r in records if r.get("event")=="iteration" and r.get("stage")==stage)
+print(nInvalid, "0 0 Invalid JSON lines")
+print(int(records[0].get("event")=="start"), "1 0 Start record first")
+print(int(records[-1].get("event")=="end" and records[-1].get("status")=="done"), "1 0 End record with status done last")
+print(countStage("ionic") - countLog("IonicMinimize: Iter"), "0 0 Ionic records - log iterations")
+print(countStage("electronic") - countLog("SCF: Cycle:"), "0 0 Electronic records - log cycles")
+print(int(countStage("fluid") > 0), "1 0 Fluid records present")
+PYEOF
+if [ $? -ne 0 ]; then
+	for i in 1 2 3 4 5 6; do echo "1 0 0 failed to parse telemetry"; done
+fi
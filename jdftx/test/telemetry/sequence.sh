@@ -0,0 +1,3 @@
+#!/bin/bash
+export runs="water"
+export nProcs="4"
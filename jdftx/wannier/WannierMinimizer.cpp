@@ -209,9 +209,15 @@ bool WannierMinimizer::Kpoint::operator==(const WannierMinimizer::Kpoint& other)
 }
 
 ColumnBundle WannierMinimizer::getWfns(const WannierMinimizer::Kpoint& kpoint, int iSpin, std::vector<matrix>* VdagResult) const
-{	ColumnBundle ret(nBands, basis.nbasis*nSpinor, &basis, &kpoint, isGpuEnabled());
-	ret.zero();
-	axpyWfns(1., matrix(), kpoint, iSpin, ret, VdagResult);
+{	//Unfold to common basis (reusing cached result if available, since C is fixed during Wannier):
+	const ColumnBundleTransform& transform = *(transformMap.find(kpoint)->second);
+	int q = kpoint.iReduced + iSpin*qCount;
+	const ColumnBundle& C = e.eInfo.isMine(q) ? e.eVars.C[q] : Cother[q];
+	ColumnBundleTransformCache::Key key = { q, int(kpoint.iSym), kpoint.invert, kpoint.offset };
+	ColumnBundle ret = wfnsCache.get(key, transform, C, basis, kpoint);
+	//Corresponding transformation in projections:
+	if(VdagResult)
+		*VdagResult = transform.transformVdagC(e.eInfo.isMine(q) ? e.eVars.VdagC[q] : VdagCother[q], kpoint.iSym);
 	return ret;
 }
 
@@ -131,6 +131,7 @@ protected:
 	std::set<Kpoint> kpoints; //!< list of all k-points that will be in use (including those in FD formulae)
 	std::shared_ptr<ColumnBundleTransform::BasisWrapper> basisWrapper, basisSuperWrapper; //!< look-up tables for initializing transforms
 	std::map<Kpoint, std::shared_ptr<ColumnBundleTransform> > transformMap, transformMapSuper; //!< wave-function transforms for each k-point to the common bases
+	mutable ColumnBundleTransformCache wfnsCache; //!< wavefunctions unfolded to the common basis, reused across getWfns calls
 	Basis basis; //!< common basis (with indexing into full G-space)
 	
 	//k-mesh MPI division:
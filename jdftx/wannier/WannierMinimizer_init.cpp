@@ -29,7 +29,8 @@ WannierMinimizer::WannierMinimizer(const Everything& e, const Wannier& wannier,
 	nSpinor(e.eInfo.spinorLength()),
 	rSqExpect(nCenters), rExpect(nCenters), pinned(nCenters, false), rPinned(nCenters),
 	needSuper(needSuperOverride || wannier.saveWfns || wannier.saveWfnsRealSpace || wannier.numericalOrbitalsFilename.length()),
-	nPhononModes(0)
+	nPhononModes(0),
+	wfnsCache(size_t(e.cntrl.unfoldCacheMB*1e6), e.cntrl.unfoldCacheSpill)
 {
 	//Create supercell grid:
 	logPrintf("\n---------- Initializing supercell grid for Wannier functions ----------\n");
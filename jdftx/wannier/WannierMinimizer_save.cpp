@@ -195,6 +195,7 @@ void WannierMinimizer::saveMLWF(int iSpin)
 	for(const DefectSupercell& ds: wannier.defects)
 		saveMLWF_defect(iSpin, (DefectSupercell&)ds);
 	suspendOperatorThreading();
+	wfnsCache.printStats("\nUnfolded wavefunction");
 }
 
 